@@ -0,0 +1,650 @@
+//
+// Created by baraloni, cpp 2018-19 winter semester.
+// contains an opt-in heap allocation tracker, shared by libalg (ex1) and Matrix<T> (ex3).
+//
+
+#ifndef COMMON_ALLOCTRACKER_HPP
+#define COMMON_ALLOCTRACKER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <ostream>
+#include <typeinfo>
+
+// the tracker is compiled in by -DALLOC_TRACKING (make TRACK=1), and then records only while
+// enabled: from the start if the environment variable ALLOC_TRACK is set (to anything but "0"),
+// or from AllocTracker::setEnabled(true). without ALLOC_TRACKING nothing is hooked: the queries
+// below report zeros, TrackedAllocator<T> is std::allocator<T>, and ALLOC_SCOPE is empty.
+// the operation is per thread: a worker continues its caller's through ALLOC_SCOPE_OF.
+
+/** largest number of distinct types, and of distinct operations, the tracker tells apart.*/
+#define ALLOC_TRACK_SLOTS 64
+/** the operation of allocations made outside every AllocScope.*/
+#define ALLOC_TRACK_NO_OPERATION "(none)"
+/** the type of allocations made through the global operator new.*/
+#define ALLOC_TRACK_GLOBAL_TYPE "(operator new)"
+
+/**
+ * represents what the allocations of a type, or of an operation, cost.
+ */
+struct AllocStats
+{
+    /** number of allocations.*/
+    unsigned long count = 0;
+    /** number of bytes allocated.*/
+    size_t bytes = 0;
+    /** number of bytes allocated and not freed yet.*/
+    size_t live = 0;
+    /** largest number of bytes that were live at once.*/
+    size_t peak = 0;
+};
+
+/**
+ * counts heap allocations, by type (the allocator's element type, or ALLOC_TRACK_GLOBAL_TYPE) and
+ * by operation (the innermost AllocScope of the allocating thread). every tracked block carries a
+ * small header that names the slots it was counted in, so frees are charged back to them.
+ * the counters are atomic: any thread may allocate, free and query concurrently.
+ */
+class AllocTracker
+{
+private:
+    /**
+     * represents the counters of a type or an operation.
+     */
+    struct Slot
+    {
+        std::atomic<const char*> key;
+        std::atomic<unsigned long> count;
+        std::atomic<size_t> bytes, live, peak;
+    };
+
+    /**
+     * represents the slots of the types, or of the operations. a slot is claimed (under the
+     * lock) the first time its key is seen, and never released.
+     */
+    struct Table
+    {
+        Slot slots[ALLOC_TRACK_SLOTS];
+        std::atomic<unsigned int> used;
+        std::mutex claim;
+    };
+
+    /**
+     * represents the tracker's state (zero-initialized, as it has static storage).
+     */
+    struct State
+    {
+        Table types, operations;
+        Slot totals;
+        std::atomic<bool> enabled;
+    };
+
+    /**
+     * precedes every tracked block: its size, and the slots it was counted in.
+     */
+    struct alignas(std::max_align_t) Header
+    {
+        size_t bytes;
+        unsigned int type, operation;
+    };
+
+    /** marks a block allocated while the tracker was disabled.*/
+    static const unsigned int UNTRACKED = ALLOC_TRACK_SLOTS;
+    /** the slot of a key that came after the table filled up (counted in the totals only).*/
+    static const unsigned int NO_SLOT = ALLOC_TRACK_SLOTS + 1;
+
+    /**
+     * @return the tracker's state (enabled from the environment on first use).
+     */
+    static State& state()
+    {
+        static State s;
+        static const bool fromEnvironment = [] {
+            const char *value = std::getenv("ALLOC_TRACK");
+            s.enabled.store(value != nullptr && std::strcmp(value, "0") != 0);
+            return true;
+        }();
+        (void) fromEnvironment;
+        return s;
+    }
+
+    /**
+     * @return the calling thread's current operation slot.
+     */
+    static unsigned int& currentOperation()
+    {
+        thread_local unsigned int operation = operationSlot(ALLOC_TRACK_NO_OPERATION);
+        return operation;
+    }
+
+    /**
+     * @return the calling thread's allocation count and bytes (see AllocProbe).
+     */
+    static AllocStats& threadTotals()
+    {
+        thread_local AllocStats totals;
+        return totals;
+    }
+
+    /**
+     * @param table: the types or the operations.
+     * @param key: the slot's name.
+     * @param claim: true to claim a slot for <key> if it has none.
+     * @return the slot of <key> (NO_SLOT if it has none).
+     */
+    static unsigned int find(Table &table, const char *key, const bool claim)
+    {
+        unsigned int used = table.used.load(std::memory_order_acquire);
+        for (unsigned int i = 0; i < used; ++i)
+        {
+            const char *other = table.slots[i].key.load(std::memory_order_relaxed);
+            if (other == key || std::strcmp(other, key) == 0)
+            {
+                return i;
+            }
+        }
+        if (!claim)
+        {
+            return NO_SLOT;
+        }
+        std::lock_guard<std::mutex> lock(table.claim);
+        for (unsigned int i = used; i < table.used.load(std::memory_order_relaxed); ++i)
+        {
+            if (std::strcmp(table.slots[i].key.load(std::memory_order_relaxed), key) == 0)
+            {
+                return i;
+            }
+        }
+        used = table.used.load(std::memory_order_relaxed);
+        if (used == ALLOC_TRACK_SLOTS)
+        {
+            return NO_SLOT;
+        }
+        table.slots[used].key.store(key, std::memory_order_relaxed);
+        table.used.store(used + 1, std::memory_order_release);
+        return used;
+    }
+
+    /**
+     * counts an allocation of <bytes> in <slot>.
+     */
+    static void add(Slot &slot, const size_t bytes)
+    {
+        slot.count.fetch_add(1, std::memory_order_relaxed);
+        slot.bytes.fetch_add(bytes, std::memory_order_relaxed);
+        const size_t live = slot.live.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        size_t peak = slot.peak.load(std::memory_order_relaxed);
+        while (live > peak && !slot.peak.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    /**
+     * @return the counters of <slot>.
+     */
+    static AllocStats read(Slot const& slot)
+    {
+        AllocStats stats;
+        stats.count = slot.count.load(std::memory_order_relaxed);
+        stats.bytes = slot.bytes.load(std::memory_order_relaxed);
+        stats.live = slot.live.load(std::memory_order_relaxed);
+        stats.peak = slot.peak.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    /**
+     * zeroes the counts of <slot>, and brings its peak down to what is live.
+     */
+    static void clear(Slot &slot)
+    {
+        slot.count.store(0, std::memory_order_relaxed);
+        slot.bytes.store(0, std::memory_order_relaxed);
+        slot.peak.store(slot.live.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    /**
+     * prints the counters of every slot of <table>.
+     */
+    static void print(std::ostream &os, const char *kind, Table &table)
+    {
+        const unsigned int used = table.used.load(std::memory_order_acquire);
+        for (unsigned int i = 0; i < used; ++i)
+        {
+            const AllocStats stats = read(table.slots[i]);
+            if (stats.count > 0 || stats.live > 0)
+            {
+                os << std::left << std::setw(10) << kind << std::setw(28)
+                   << table.slots[i].key.load(std::memory_order_relaxed) << std::right
+                   << std::setw(12) << stats.count << std::setw(14) << stats.bytes
+                   << std::setw(14) << stats.live << std::setw(14) << stats.peak << std::endl;
+            }
+        }
+    }
+
+public:
+    /**
+     * @return true if the tracker is compiled in and records.
+     */
+    static bool enabled()
+    {
+#ifdef ALLOC_TRACKING
+        return state().enabled.load(std::memory_order_relaxed);
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * starts (or stops) recording. blocks allocated meanwhile are never counted.
+     * @param on: true to record.
+     */
+    static void setEnabled(const bool on)
+    {
+        state().enabled.store(on, std::memory_order_relaxed);
+    }
+
+    /**
+     * @param name: a type's name (must outlive the program, e.g. a literal).
+     * @return the type's slot, for allocate().
+     */
+    static unsigned int typeSlot(const char *name)
+    {
+        return find(state().types, name, true);
+    }
+
+    /**
+     * @param name: an operation's name (must outlive the program, e.g. a literal).
+     * @return the operation's slot, for AllocScope.
+     */
+    static unsigned int operationSlot(const char *name)
+    {
+        return find(state().operations, name, true);
+    }
+
+    /**
+     * @return the calling thread's current operation's slot (for an AllocScope on a worker).
+     */
+    static unsigned int currentOperationSlot()
+    {
+        return currentOperation();
+    }
+
+    /**
+     * allocates <bytes> bytes (aligned as malloc aligns), and counts them in <type> and in the
+     * calling thread's current operation.
+     * @param bytes: number of bytes.
+     * @param type: a slot returned by typeSlot().
+     * @return the allocated bytes.
+     */
+    static void *allocate(const size_t bytes, const unsigned int type)
+    {
+        void *block = std::malloc(sizeof(Header) + bytes);
+        if (block == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        Header *header = static_cast<Header*>(block);
+        header->bytes = bytes;
+        header->type = UNTRACKED;
+        header->operation = UNTRACKED;
+        if (enabled())
+        {
+            State &s = state();
+            header->type = type;
+            header->operation = currentOperation();
+            add(s.totals, bytes);
+            if (type < ALLOC_TRACK_SLOTS)
+            {
+                add(s.types.slots[type], bytes);
+            }
+            if (header->operation < ALLOC_TRACK_SLOTS)
+            {
+                add(s.operations.slots[header->operation], bytes);
+            }
+            ++threadTotals().count;
+            threadTotals().bytes += bytes;
+        }
+        return header + 1;
+    }
+
+    /**
+     * frees bytes returned by allocate(), and charges them back to the slots they were counted in.
+     * @param p: the bytes (or nullptr).
+     */
+    static void deallocate(void *p) noexcept
+    {
+        if (p == nullptr)
+        {
+            return;
+        }
+        Header *header = static_cast<Header*>(p) - 1;
+        if (header->type != UNTRACKED)
+        {
+            State &s = state();
+            s.totals.live.fetch_sub(header->bytes, std::memory_order_relaxed);
+            if (header->type < ALLOC_TRACK_SLOTS)
+            {
+                s.types.slots[header->type].live.fetch_sub(header->bytes, std::memory_order_relaxed);
+            }
+            if (header->operation < ALLOC_TRACK_SLOTS)
+            {
+                s.operations.slots[header->operation].live.fetch_sub(header->bytes,
+                                                                     std::memory_order_relaxed);
+            }
+        }
+        std::free(header);
+    }
+
+    /**
+     * @return the counters of all the tracked allocations.
+     */
+    static AllocStats totals()
+    {
+        return read(state().totals);
+    }
+
+    /**
+     * @param name: a type's name.
+     * @return the counters of the type (zeros if it allocated nothing).
+     */
+    static AllocStats ofType(const char *name)
+    {
+        const unsigned int slot = find(state().types, name, false);
+        return (slot == NO_SLOT) ? AllocStats() : read(state().types.slots[slot]);
+    }
+
+    /**
+     * @param name: an operation's name.
+     * @return the counters of the operation (zeros if it allocated nothing).
+     */
+    static AllocStats ofOperation(const char *name)
+    {
+        const unsigned int slot = find(state().operations, name, false);
+        return (slot == NO_SLOT) ? AllocStats() : read(state().operations.slots[slot]);
+    }
+
+    /**
+     * @return the number of allocations, and of bytes, the calling thread made so far.
+     */
+    static AllocStats ofThisThread()
+    {
+        return threadTotals();
+    }
+
+    /**
+     * zeroes every count, and brings every peak down to what is live.
+     */
+    static void reset()
+    {
+        State &s = state();
+        clear(s.totals);
+        for (Table *table : {&s.types, &s.operations})
+        {
+            const unsigned int used = table->used.load(std::memory_order_acquire);
+            for (unsigned int i = 0; i < used; ++i)
+            {
+                clear(table->slots[i]);
+            }
+        }
+    }
+
+    /**
+     * prints the counters of the totals, every type and every operation, one per line.
+     * @param os: the stream.
+     */
+    static void print(std::ostream &os)
+    {
+        State &s = state();
+        const AllocStats total = read(s.totals);
+        os << std::left << std::setw(38) << "allocations" << std::right << std::setw(12) << "count"
+           << std::setw(14) << "bytes" << std::setw(14) << "live" << std::setw(14) << "peak"
+           << std::endl;
+        os << std::left << std::setw(38) << "total" << std::right << std::setw(12) << total.count
+           << std::setw(14) << total.bytes << std::setw(14) << total.live << std::setw(14)
+           << total.peak << std::endl;
+        print(os, "type", s.types);
+        print(os, "operation", s.operations);
+    }
+
+    friend class AllocScope;
+};
+
+/**
+ * attributes the allocations of the calling thread to an operation while it lives (scopes nest:
+ * the innermost one wins). use through ALLOC_SCOPE, which is empty without ALLOC_TRACKING.
+ */
+class AllocScope
+{
+private:
+    /**
+     * holds the enclosing operation's slot.
+     */
+    unsigned int _outer;
+
+public:
+    /**
+     * starts the operation.
+     * @param name: the operation's name (must outlive the program, e.g. a literal).
+     */
+    explicit AllocScope(const char *name): _outer(AllocTracker::currentOperation())
+    {
+        AllocTracker::currentOperation() = AllocTracker::operationSlot(name);
+    }
+
+    /**
+     * continues an operation on another thread (e.g. a worker of the thread that started it).
+     * @param operation: a slot returned by AllocTracker::currentOperationSlot().
+     */
+    explicit AllocScope(const unsigned int operation): _outer(AllocTracker::currentOperation())
+    {
+        AllocTracker::currentOperation() = operation;
+    }
+
+    AllocScope(AllocScope const&) = delete;
+    AllocScope& operator=(AllocScope const&) = delete;
+
+    /**
+     * ends the operation.
+     */
+    ~AllocScope()
+    {
+        AllocTracker::currentOperation() = _outer;
+    }
+};
+
+/**
+ * counts the allocations the calling thread makes while the probe lives, e.g. to assert that a
+ * path doesn't allocate: AllocProbe probe; path(); assert(probe.allocations() == 0);
+ * (allocations made on other threads, and untracked ones, aren't counted.)
+ */
+class AllocProbe
+{
+private:
+    /**
+     * represent the thread's counters when the probe started.
+     */
+    unsigned long _count;
+    size_t _bytes;
+
+public:
+    /**
+     * starts counting.
+     */
+    AllocProbe(): _count(AllocTracker::ofThisThread().count), _bytes(AllocTracker::ofThisThread().bytes)
+    {
+    }
+
+    /**
+     * @return the number of allocations since the probe started.
+     */
+    unsigned long allocations() const
+    {
+        return AllocTracker::ofThisThread().count - _count;
+    }
+
+    /**
+     * @return the number of bytes allocated since the probe started.
+     */
+    size_t bytes() const
+    {
+        return AllocTracker::ofThisThread().bytes - _bytes;
+    }
+};
+
+/**
+ * names the type of the elements a TrackingAllocator allocates (specialize for readable names).
+ */
+template <typename T>
+struct AllocTypeName
+{
+    static const char *name()
+    {
+        return typeid(T).name();
+    }
+};
+
+/** names the type <T> as <NAME> in the tracker's counters.*/
+#define ALLOC_TYPE_NAME(T, NAME) \
+    template <> struct AllocTypeName<T> { static const char *name() { return NAME; } };
+
+ALLOC_TYPE_NAME(char, "char")
+ALLOC_TYPE_NAME(int, "int")
+ALLOC_TYPE_NAME(long, "long")
+ALLOC_TYPE_NAME(unsigned long, "unsigned long")
+ALLOC_TYPE_NAME(float, "float")
+ALLOC_TYPE_NAME(double, "double")
+
+/**
+ * a standard allocator that allocates through the tracker, counting under AllocTypeName<T>.
+ * @tparam T: the elements' type (at most as aligned as malloc aligns).
+ */
+template <typename T>
+struct TrackingAllocator
+{
+    typedef T value_type;
+
+    TrackingAllocator() = default;
+
+    /**
+     * converting constructor (the allocator has no state).
+     */
+    template <typename U>
+    TrackingAllocator(TrackingAllocator<U> const&) noexcept
+    {
+    }
+
+    /**
+     * @param n: number of elements.
+     * @return uninitialized room for <n> elements.
+     */
+    T *allocate(const size_t n)
+    {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "over-aligned types aren't tracked");
+        static const unsigned int type = AllocTracker::typeSlot(AllocTypeName<T>::name());
+        if (n > (size_t) -1 / sizeof(T))
+        {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<T*>(AllocTracker::allocate(n * sizeof(T), type));
+    }
+
+    /**
+     * frees room returned by allocate().
+     * @param p: the room.
+     */
+    void deallocate(T *p, size_t) noexcept
+    {
+        AllocTracker::deallocate(p);
+    }
+};
+
+/**
+ * @return true (the allocators have no state).
+ */
+template <typename T, typename U>
+bool operator==(TrackingAllocator<T> const&, TrackingAllocator<U> const&)
+{
+    return true;
+}
+
+/**
+ * @return false (the allocators have no state).
+ */
+template <typename T, typename U>
+bool operator!=(TrackingAllocator<T> const&, TrackingAllocator<U> const&)
+{
+    return false;
+}
+
+#ifdef ALLOC_TRACKING
+
+/** the allocator of the tracked containers.*/
+template <typename T>
+using TrackedAllocator = TrackingAllocator<T>;
+
+#define ALLOC_SCOPE_JOIN(a, b) a##b
+#define ALLOC_SCOPE_NAME(line) ALLOC_SCOPE_JOIN(allocScope, line)
+/** attributes the allocations until the end of the enclosing block to the operation <name>.*/
+#define ALLOC_SCOPE(name) AllocScope ALLOC_SCOPE_NAME(__LINE__)(name)
+/** the calling thread's current operation, for ALLOC_SCOPE_OF on a worker it starts.*/
+#define ALLOC_OPERATION() AllocTracker::currentOperationSlot()
+/** attributes a worker's allocations until the end of the enclosing block to <operation>.*/
+#define ALLOC_SCOPE_OF(operation) AllocScope ALLOC_SCOPE_NAME(__LINE__)(operation)
+
+// a program that also wants every other heap allocation counted (under ALLOC_TRACK_GLOBAL_TYPE)
+// defines ALLOC_TRACK_GLOBAL_NEW before including this header, in exactly one of its files.
+#ifdef ALLOC_TRACK_GLOBAL_NEW
+
+/**
+ * allocates <size> bytes through the tracker.
+ * @param size: number of bytes.
+ * @return the allocated bytes.
+ */
+void *operator new(size_t size)
+{
+    static const unsigned int type = AllocTracker::typeSlot(ALLOC_TRACK_GLOBAL_TYPE);
+    return AllocTracker::allocate(size, type);
+}
+
+/**
+ * frees bytes allocated by operator new.
+ * @param p: the bytes.
+ */
+void operator delete(void *p) noexcept
+{
+    AllocTracker::deallocate(p);
+}
+
+/**
+ * frees bytes allocated by operator new.
+ * @param p: the bytes.
+ */
+void operator delete(void *p, size_t) noexcept
+{
+    AllocTracker::deallocate(p);
+}
+
+#endif //ALLOC_TRACK_GLOBAL_NEW
+
+#else
+
+/** the allocator of the tracked containers.*/
+template <typename T>
+using TrackedAllocator = std::allocator<T>;
+
+/** attributes the allocations until the end of the enclosing block to the operation <name>.*/
+#define ALLOC_SCOPE(name)
+/** the calling thread's current operation, for ALLOC_SCOPE_OF on a worker it starts.*/
+#define ALLOC_OPERATION() 0u
+/** attributes a worker's allocations until the end of the enclosing block to <operation>.*/
+#define ALLOC_SCOPE_OF(operation) (void) (operation)
+
+#endif //ALLOC_TRACKING
+
+#endif //COMMON_ALLOCTRACKER_HPP
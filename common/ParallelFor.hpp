@@ -0,0 +1,84 @@
+//
+// Created by baraloni, cpp 2018-19 winter semester.
+// contains the fork-join loop shared by the batch kernels (ex1) and the matrix kernels (ex3).
+//
+
+#ifndef COMMON_PARALLELFOR_HPP
+#define COMMON_PARALLELFOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "AllocTracker.hpp"
+
+/** least amount of work (points, cells) given to a thread: less runs on the caller's thread.*/
+#define PARALLEL_MIN_PER_THREAD 65536
+
+/**
+ * @param work: the amount of work (in PARALLEL_MIN_PER_THREAD units).
+ * @param threads: the number of threads the work may be split between.
+ * @return the number of ranges to split the work into (1 to run it on the caller's thread).
+ */
+inline size_t parallelChunks(const size_t work, const unsigned int threads)
+{
+    return std::min((size_t) threads, std::max((size_t) 1, work / PARALLEL_MIN_PER_THREAD));
+}
+
+/**
+ * runs <kernel> over [0, n), split into at most <chunks> contiguous ranges, one per thread (the
+ * caller's thread runs the first one). every range but the last starts on a multiple of <grain>
+ * items. the workers' allocations count in the caller's operation (see AllocScope), and an
+ * exception thrown by the kernel is rethrown on the caller's thread, once every range is done.
+ * @param n: the number of items.
+ * @param chunks: the number of ranges (see parallelChunks).
+ * @param grain: the ranges' alignment (1 for none).
+ * @param kernel: callable as kernel(begin, end).
+ */
+template <typename Kernel>
+void parallelFor(const size_t n, const size_t chunks, const size_t grain, Kernel kernel)
+{
+    if (chunks <= 1 || n <= grain)
+    {
+        kernel((size_t) 0, n);
+        return;
+    }
+    const size_t step = ((n + chunks - 1) / chunks + grain - 1) / grain * grain;
+    const unsigned int operation = ALLOC_OPERATION();
+    std::exception_ptr error;
+    std::mutex errorLock;
+    auto guarded = [&](const size_t begin, const size_t end)
+    {
+        ALLOC_SCOPE_OF(operation);
+        try
+        {
+            kernel(begin, end);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(errorLock);
+            if (!error)
+            {
+                error = std::current_exception();
+            }
+        }
+    };
+    std::vector<std::thread> workers;
+    for (size_t begin = step; begin < n; begin += step)
+    {
+        workers.emplace_back(guarded, begin, std::min(n, begin + step));
+    }
+    guarded((size_t) 0, std::min(n, step));
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+#endif //COMMON_PARALLELFOR_HPP
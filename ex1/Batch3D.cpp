@@ -0,0 +1,588 @@
+#include "Batch3D.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#ifdef __AVX__
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+/** number of threads set by setBatchThreads (0 for the number of cores).*/
+static atomic<unsigned int> requestedThreads(0);
+
+//---------------------Helpers:
+
+/**
+ * throws std::invalid_argument if the sizes differ.
+ * @param first: a batch size.
+ * @param second: a batch size.
+ */
+static void checkSizes(const size_t first, const size_t second)
+{
+    if (first != second)
+    {
+        throw invalid_argument(BATCH_SIZE_ERR);
+    }
+}
+
+#ifdef __AVX__
+/**
+ * @return a * b + c, fused when the target has FMA.
+ */
+static inline __m256d madd(const __m256d a, const __m256d b, const __m256d c)
+{
+#ifdef __FMA__
+    return _mm256_fmadd_pd(a, b, c);
+#else
+    return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+#endif
+}
+
+/**
+ * represents four doubles, one per matrix, that the matrix kernels operate on together.
+ */
+struct Lanes4
+{
+    __m256d v;
+
+    Lanes4() = default;
+
+    Lanes4(const __m256d lanes): v(lanes){}
+
+    explicit Lanes4(const double val): v(_mm256_set1_pd(val)){}
+};
+
+// lane-wise arithmetic:
+
+static inline Lanes4 operator+(const Lanes4 a, const Lanes4 b)
+{
+    return _mm256_add_pd(a.v, b.v);
+}
+
+static inline Lanes4 operator-(const Lanes4 a, const Lanes4 b)
+{
+    return _mm256_sub_pd(a.v, b.v);
+}
+
+static inline Lanes4 operator*(const Lanes4 a, const Lanes4 b)
+{
+    return _mm256_mul_pd(a.v, b.v);
+}
+
+static inline Lanes4 operator/(const Lanes4 a, const Lanes4 b)
+{
+    return _mm256_div_pd(a.v, b.v);
+}
+
+static inline Lanes4 absOf(const Lanes4 a)
+{
+    return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a.v);
+}
+
+static inline Lanes4 maxOf(const Lanes4 a, const Lanes4 b)
+{
+    return _mm256_max_pd(a.v, b.v);
+}
+
+/**
+ * transposes the entries of up to 4 consecutive matrices into lanes (the last matrix fills the
+ * unused lanes).
+ * @param matrices: array of <count> Matrix3D objects.
+ * @param count: 1 <= count <= 4.
+ * @param out: array of 9 lanes, receives the entries (row-major).
+ */
+static inline void loadLanes(const Matrix3D *matrices, const size_t count, Lanes4 *out)
+{
+    const double *m0 = matrices[0].data(), *m1 = matrices[min(count, (size_t) 2) - 1].data(),
+                 *m2 = matrices[min(count, (size_t) 3) - 1].data(), *m3 = matrices[count - 1].data();
+    for (unsigned int e = 0; e < 9; ++e)
+    {
+        out[e] = _mm256_set_pd(m3[e], m2[e], m1[e], m0[e]);
+    }
+}
+
+/**
+ * @param values: array of <count> doubles.
+ * @param count: 1 <= count <= 4.
+ * @return the values in lanes (the unused lanes hold 0).
+ */
+static inline Lanes4 loadPartial(const double *values, const size_t count)
+{
+    if (count == 4)
+    {
+        return _mm256_loadu_pd(values);
+    }
+    double lanes[4] = {0, 0, 0, 0};
+    copy(values, values + count, lanes);
+    return _mm256_loadu_pd(lanes);
+}
+#endif
+
+//---------------------Matrix helpers (T is a double, or lanes of doubles):
+
+static inline double absOf(const double a)
+{
+    return fabs(a);
+}
+
+static inline double maxOf(const double a, const double b)
+{
+    return a > b ? a : b;
+}
+
+/**
+ * @param m: the 9 entries of a matrix (row-major).
+ * @return the matrix's determinant.
+ */
+template <typename T>
+static inline T determinantOf(const T *m)
+{
+    return m[0] * (m[4] * m[8] - m[5] * m[7]) - m[1] * (m[3] * m[8] - m[5] * m[6]) +
+           m[2] * (m[3] * m[7] - m[4] * m[6]);
+}
+
+/**
+ * divides every row of a matrix by its largest absolute entry. the singularity test doesn't
+ * change under row scaling, and on the scaled rows (whose norms are between 1 and 3) it neither
+ * overflows nor underflows, whatever the matrix's scale. a zero row scales to NaNs (singular).
+ * @param m: the 9 entries of a matrix (row-major).
+ * @param scaled: receives the scaled matrix's 9 entries (row-major).
+ */
+template <typename T>
+static inline void scaleRows(const T *m, T *scaled)
+{
+    for (unsigned int r = 0; r < 9; r += 3)
+    {
+        const T scale = T(1.0) / maxOf(absOf(m[r]), maxOf(absOf(m[r + 1]), absOf(m[r + 2])));
+        scaled[r] = m[r] * scale;
+        scaled[r + 1] = m[r + 1] * scale;
+        scaled[r + 2] = m[r + 2] * scale;
+    }
+}
+
+/**
+ * @param m: the 9 entries of a matrix (row-major), scaled by scaleRows.
+ * @return the singularity bound: the matrix is singular when det(m)^2 <= bound.
+ */
+template <typename T>
+static inline T singularBound(const T *m)
+{
+    const T tolerance(BATCH_SINGULAR_TOLERANCE * BATCH_SINGULAR_TOLERANCE);
+    return tolerance * (m[0] * m[0] + m[1] * m[1] + m[2] * m[2]) *
+           (m[3] * m[3] + m[4] * m[4] + m[5] * m[5]) * (m[6] * m[6] + m[7] * m[7] + m[8] * m[8]);
+}
+
+/**
+ * computes a matrix's adjugate (the transposed cofactors).
+ * @param m: the 9 entries of a matrix (row-major).
+ * @param adj: receives the adjugate's 9 entries (row-major).
+ * @return the matrix's determinant.
+ */
+template <typename T>
+static inline T adjugateOf(const T *m, T *adj)
+{
+    adj[0] = m[4] * m[8] - m[5] * m[7];
+    adj[1] = m[2] * m[7] - m[1] * m[8];
+    adj[2] = m[1] * m[5] - m[2] * m[4];
+    adj[3] = m[5] * m[6] - m[3] * m[8];
+    adj[4] = m[0] * m[8] - m[2] * m[6];
+    adj[5] = m[2] * m[3] - m[0] * m[5];
+    adj[6] = m[3] * m[7] - m[4] * m[6];
+    adj[7] = m[1] * m[6] - m[0] * m[7];
+    adj[8] = m[0] * m[4] - m[1] * m[3];
+    return m[0] * adj[0] + m[1] * adj[3] + m[2] * adj[6];
+}
+
+/**
+ * @param det: the determinant of a matrix's scaled rows (see scaleRows).
+ * @param bound: the matrix's singularity bound.
+ * @param singular: array of flags (may be null).
+ * @param index: the matrix's index.
+ * @return true if the matrix is singular (and records it).
+ */
+static inline bool checkSingular(const double det, const double bound, bool *singular,
+                                 const size_t index)
+{
+    const bool isSingular = !(det * det > bound);
+    if (singular != nullptr)
+    {
+        singular[index] = isSingular;
+    }
+    return isSingular;
+}
+
+//---------------------Threads:
+
+/**
+ * sets the number of threads the batch kernels split a batch between.
+ * @param threads: number of threads (0 for the number of cores).
+ */
+void setBatchThreads(const unsigned int threads)
+{
+    requestedThreads.store(threads);
+}
+
+/**
+ * @return the number of threads the batch kernels split a batch between.
+ */
+unsigned int batchThreads()
+{
+    const unsigned int threads = requestedThreads.load();
+    if (threads != 0)
+    {
+        return threads;
+    }
+    return max(1u, thread::hardware_concurrency());
+}
+
+//---------------------Kernels:
+
+/**
+ * multiplies every point of <in> by <matrix>.
+ * @param matrix: a Matrix3D object.
+ * @param in: the points.
+ * @param out: receives the products.
+ */
+void batchTransform(Matrix3D const& matrix, Batch3D const& in, Batch3D const& out)
+{
+    batchTransform(matrix, Vector3D(), in, out);
+}
+
+/**
+ * multiplies every point of <in> by <matrix>, and adds <translation> (an affine transform).
+ * @param matrix: a Matrix3D object.
+ * @param translation: a Vector3D object.
+ * @param in: the points.
+ * @param out: receives the transformed points.
+ */
+void batchTransform(Matrix3D const& matrix, Vector3D const& translation, Batch3D const& in,
+                    Batch3D const& out)
+{
+    checkSizes(in.size, out.size);
+    const double *r0 = matrix[0], *r1 = matrix[1], *r2 = matrix[2];
+    batchParallelFor(in.size, [&](const size_t begin, const size_t end)
+    {
+        size_t i = begin;
+#ifdef __AVX__
+        const __m256d m00 = _mm256_set1_pd(r0[0]), m01 = _mm256_set1_pd(r0[1]),
+                      m02 = _mm256_set1_pd(r0[2]), m10 = _mm256_set1_pd(r1[0]),
+                      m11 = _mm256_set1_pd(r1[1]), m12 = _mm256_set1_pd(r1[2]),
+                      m20 = _mm256_set1_pd(r2[0]), m21 = _mm256_set1_pd(r2[1]),
+                      m22 = _mm256_set1_pd(r2[2]);
+        const __m256d t0 = _mm256_set1_pd(translation[0]), t1 = _mm256_set1_pd(translation[1]),
+                      t2 = _mm256_set1_pd(translation[2]);
+        for (; i + 4 <= end; i += 4)
+        {
+            const __m256d x = _mm256_loadu_pd(in.x + i);
+            const __m256d y = _mm256_loadu_pd(in.y + i);
+            const __m256d z = _mm256_loadu_pd(in.z + i);
+            _mm256_storeu_pd(out.x + i, madd(m02, z, madd(m01, y, madd(m00, x, t0))));
+            _mm256_storeu_pd(out.y + i, madd(m12, z, madd(m11, y, madd(m10, x, t1))));
+            _mm256_storeu_pd(out.z + i, madd(m22, z, madd(m21, y, madd(m20, x, t2))));
+        }
+#endif
+        for (; i < end; ++i)
+        {
+            out.set(i, matrix * Vector3D(in.x[i], in.y[i], in.z[i]) + translation);
+        }
+    });
+}
+
+/**
+ * @param in: the points.
+ * @param out: array of in.size doubles, receives the norm of every point.
+ */
+void batchNorm(Batch3D const& in, double *out)
+{
+    batchParallelFor(in.size, [&](const size_t begin, const size_t end)
+    {
+        size_t i = begin;
+#ifdef __AVX__
+        for (; i + 4 <= end; i += 4)
+        {
+            const __m256d x = _mm256_loadu_pd(in.x + i);
+            const __m256d y = _mm256_loadu_pd(in.y + i);
+            const __m256d z = _mm256_loadu_pd(in.z + i);
+            _mm256_storeu_pd(out + i, _mm256_sqrt_pd(madd(z, z, madd(y, y, _mm256_mul_pd(x, x)))));
+        }
+#endif
+        for (; i < end; ++i)
+        {
+            out[i] = in.at(i).norm();
+        }
+    });
+}
+
+/**
+ * @param first: the points.
+ * @param second: the points.
+ * @param out: array of first.size doubles, receives the distance between every pair of points.
+ */
+void batchDist(Batch3D const& first, Batch3D const& second, double *out)
+{
+    checkSizes(first.size, second.size);
+    batchParallelFor(first.size, [&](const size_t begin, const size_t end)
+    {
+        size_t i = begin;
+#ifdef __AVX__
+        for (; i + 4 <= end; i += 4)
+        {
+            const __m256d x = _mm256_sub_pd(_mm256_loadu_pd(second.x + i), _mm256_loadu_pd(first.x + i));
+            const __m256d y = _mm256_sub_pd(_mm256_loadu_pd(second.y + i), _mm256_loadu_pd(first.y + i));
+            const __m256d z = _mm256_sub_pd(_mm256_loadu_pd(second.z + i), _mm256_loadu_pd(first.z + i));
+            _mm256_storeu_pd(out + i, _mm256_sqrt_pd(madd(z, z, madd(y, y, _mm256_mul_pd(x, x)))));
+        }
+#endif
+        for (; i < end; ++i)
+        {
+            out[i] = first.at(i).dist(second.at(i));
+        }
+    });
+}
+
+/**
+ * @param first: the points.
+ * @param second: the points.
+ * @param out: array of first.size doubles, receives the scalar product of every pair of points.
+ */
+void batchDot(Batch3D const& first, Batch3D const& second, double *out)
+{
+    checkSizes(first.size, second.size);
+    batchParallelFor(first.size, [&](const size_t begin, const size_t end)
+    {
+        size_t i = begin;
+#ifdef __AVX__
+        for (; i + 4 <= end; i += 4)
+        {
+            const __m256d xx = _mm256_mul_pd(_mm256_loadu_pd(first.x + i), _mm256_loadu_pd(second.x + i));
+            const __m256d y = _mm256_loadu_pd(second.y + i);
+            const __m256d z = _mm256_loadu_pd(second.z + i);
+            _mm256_storeu_pd(out + i, madd(_mm256_loadu_pd(first.z + i), z,
+                                           madd(_mm256_loadu_pd(first.y + i), y, xx)));
+        }
+#endif
+        for (; i < end; ++i)
+        {
+            out[i] = first.at(i) * second.at(i);
+        }
+    });
+}
+
+/**
+ * @param first: the points.
+ * @param second: the points.
+ * @param out: array of first.size doubles, receives the angle between every pair of points in
+ *             radians (as operator^).
+ */
+void batchAngle(Batch3D const& first, Batch3D const& second, double *out)
+{
+    checkSizes(first.size, second.size);
+    batchParallelFor(first.size, [&](const size_t begin, const size_t end)
+    {
+        size_t i = begin;
+#ifdef __AVX__
+        const __m256d one = _mm256_set1_pd(1), minusOne = _mm256_set1_pd(-1);
+        for (; i + 4 <= end; i += 4)
+        {
+            const __m256d x1 = _mm256_loadu_pd(first.x + i), x2 = _mm256_loadu_pd(second.x + i);
+            const __m256d y1 = _mm256_loadu_pd(first.y + i), y2 = _mm256_loadu_pd(second.y + i);
+            const __m256d z1 = _mm256_loadu_pd(first.z + i), z2 = _mm256_loadu_pd(second.z + i);
+            const __m256d dot = madd(z1, z2, madd(y1, y2, _mm256_mul_pd(x1, x2)));
+            const __m256d norm1 = _mm256_sqrt_pd(madd(z1, z1, madd(y1, y1, _mm256_mul_pd(x1, x1))));
+            const __m256d norm2 = _mm256_sqrt_pd(madd(z2, z2, madd(y2, y2, _mm256_mul_pd(x2, x2))));
+            // min/max return their second operand on NaN, so zero vectors stay NaN.
+            const __m256d cosine = _mm256_div_pd(dot, _mm256_mul_pd(norm1, norm2));
+            _mm256_storeu_pd(out + i, _mm256_max_pd(minusOne, _mm256_min_pd(one, cosine)));
+        }
+        for (size_t j = begin; j < i; ++j)
+        {
+            out[j] = acos(out[j]);
+        }
+#endif
+        for (; i < end; ++i)
+        {
+            out[i] = first.at(i) ^ second.at(i);
+        }
+    });
+}
+
+//---------------------Matrix kernels:
+
+/**
+ * @param matrices: array of <n> Matrix3D objects.
+ * @param n: the number of matrices.
+ * @param out: array of <n> doubles, receives the determinant of every matrix.
+ */
+void batchDeterminant(const Matrix3D *matrices, const size_t n, double *out)
+{
+    batchParallelFor(n, [&](const size_t begin, const size_t end)
+    {
+        size_t i = begin;
+#ifdef __AVX__
+        // the last group is padded, so every matrix goes through the same lanes.
+        for (; i < end; i += 4)
+        {
+            const size_t lanes = min((size_t) 4, end - i);
+            Lanes4 m[9];
+            loadLanes(matrices + i, lanes, m);
+            const Lanes4 det = determinantOf(m);
+            if (lanes == 4)
+            {
+                _mm256_storeu_pd(out + i, det.v);
+                continue;
+            }
+            double dets[4];
+            _mm256_storeu_pd(dets, det.v);
+            copy(dets, dets + lanes, out + i);
+        }
+#endif
+        for (; i < end; ++i)
+        {
+            out[i] = determinantOf(matrices[i].data());
+        }
+    });
+}
+
+/**
+ * inverts every matrix. a singular matrix (see BATCH_SINGULAR_TOLERANCE) gets a zero inverse.
+ * @param matrices: array of <n> Matrix3D objects.
+ * @param n: the number of matrices.
+ * @param out: array of <n> Matrix3D objects, receives the inverses.
+ * @param singular: array of <n> bools, receives true for every singular matrix (may be null).
+ * @return the number of singular matrices.
+ */
+size_t batchInverse(const Matrix3D *matrices, const size_t n, Matrix3D *out, bool *singular)
+{
+    atomic<size_t> singulars(0);
+    batchParallelFor(n, [&](const size_t begin, const size_t end)
+    {
+        size_t count = 0;
+        size_t i = begin;
+#ifdef __AVX__
+        // the last group is padded, so every matrix goes through the same lanes (the results
+        // don't depend on the matrices' positions).
+        for (; i < end; i += 4)
+        {
+            const size_t lanes = min((size_t) 4, end - i);
+            Lanes4 m[9], adj[9];
+            loadLanes(matrices + i, lanes, m);
+            const Lanes4 det = adjugateOf(m, adj);
+            const Lanes4 scale = Lanes4(1.0) / det;
+            double entries[9][4], dets[4], bounds[4];
+            for (unsigned int e = 0; e < 9; ++e)
+            {
+                _mm256_storeu_pd(entries[e], (adj[e] * scale).v);
+            }
+            Lanes4 scaled[9];
+            scaleRows(m, scaled);
+            _mm256_storeu_pd(dets, determinantOf(scaled).v);
+            _mm256_storeu_pd(bounds, singularBound(scaled).v);
+            for (unsigned int k = 0; k < lanes; ++k)
+            {
+                if (checkSingular(dets[k], bounds[k], singular, i + k))
+                {
+                    out[i + k] = Matrix3D();
+                    ++count;
+                    continue;
+                }
+                out[i + k] = Matrix3D(entries[0][k], entries[1][k], entries[2][k],
+                                      entries[3][k], entries[4][k], entries[5][k],
+                                      entries[6][k], entries[7][k], entries[8][k]);
+            }
+        }
+#endif
+        for (; i < end; ++i)
+        {
+            const double *m = matrices[i].data();
+            double adj[9], scaled[9];
+            scaleRows(m, scaled);
+            if (checkSingular(determinantOf(scaled), singularBound(scaled), singular, i))
+            {
+                out[i] = Matrix3D();
+                ++count;
+                continue;
+            }
+            // multiplies by the reciprocal, as the lanes do.
+            const double scale = 1.0 / adjugateOf(m, adj);
+            for (double &entry : adj)
+            {
+                entry *= scale;
+            }
+            out[i] = Matrix3D(adj);
+        }
+        singulars += count;
+    });
+    return singulars;
+}
+
+/**
+ * solves matrices[i] * x = rhs[i] for every i. a singular matrix gets a zero solution.
+ * throws std::invalid_argument if rhs and out sizes differ.
+ * @param matrices: array of rhs.size Matrix3D objects.
+ * @param rhs: the right-hand sides.
+ * @param out: receives the solutions.
+ * @param singular: array of rhs.size bools, receives true for every singular matrix (may be null).
+ * @return the number of singular matrices.
+ */
+size_t batchSolve(const Matrix3D *matrices, Batch3D const& rhs, Batch3D const& out, bool *singular)
+{
+    checkSizes(rhs.size, out.size);
+    atomic<size_t> singulars(0);
+    batchParallelFor(rhs.size, [&](const size_t begin, const size_t end)
+    {
+        size_t count = 0;
+        size_t i = begin;
+#ifdef __AVX__
+        // the last group is padded, so every matrix goes through the same lanes (the results
+        // don't depend on the matrices' positions).
+        for (; i < end; i += 4)
+        {
+            const size_t lanes = min((size_t) 4, end - i);
+            Lanes4 m[9], adj[9];
+            loadLanes(matrices + i, lanes, m);
+            const Lanes4 det = adjugateOf(m, adj);
+            const Lanes4 scale = Lanes4(1.0) / det;
+            const Lanes4 x = loadPartial(rhs.x + i, lanes), y = loadPartial(rhs.y + i, lanes),
+                         z = loadPartial(rhs.z + i, lanes);
+            double solution[3][4], dets[4], bounds[4];
+            _mm256_storeu_pd(solution[0], ((adj[0] * x + adj[1] * y + adj[2] * z) * scale).v);
+            _mm256_storeu_pd(solution[1], ((adj[3] * x + adj[4] * y + adj[5] * z) * scale).v);
+            _mm256_storeu_pd(solution[2], ((adj[6] * x + adj[7] * y + adj[8] * z) * scale).v);
+            Lanes4 scaled[9];
+            scaleRows(m, scaled);
+            _mm256_storeu_pd(dets, determinantOf(scaled).v);
+            _mm256_storeu_pd(bounds, singularBound(scaled).v);
+            for (unsigned int k = 0; k < lanes; ++k)
+            {
+                if (checkSingular(dets[k], bounds[k], singular, i + k))
+                {
+                    out.set(i + k, Vector3D());
+                    ++count;
+                    continue;
+                }
+                out.set(i + k, Vector3D(solution[0][k], solution[1][k], solution[2][k]));
+            }
+        }
+#endif
+        for (; i < end; ++i)
+        {
+            const double *m = matrices[i].data();
+            double adj[9], scaled[9];
+            scaleRows(m, scaled);
+            if (checkSingular(determinantOf(scaled), singularBound(scaled), singular, i))
+            {
+                out.set(i, Vector3D());
+                ++count;
+                continue;
+            }
+            const double scale = 1.0 / adjugateOf(m, adj);
+            out.set(i, (Matrix3D(adj) * rhs.at(i)) * scale);
+        }
+        singulars += count;
+    });
+    return singulars;
+}
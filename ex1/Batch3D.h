@@ -0,0 +1,166 @@
+#include <cstddef>
+#include "Vector3D.h"
+#include "Matrix3D.h"
+#include "ParallelFor.hpp"
+
+#ifndef BATCH3D_H
+#define BATCH3D_H
+/** error format for batches of different sizes.*/
+#define BATCH_SIZE_ERR "Error: batch sizes do not match."
+/** least number of points given to a thread (smaller batches run on the caller's thread).*/
+#define BATCH_MIN_PER_THREAD PARALLEL_MIN_PER_THREAD
+/**
+ * a matrix is singular when |det| <= BATCH_SINGULAR_TOLERANCE * |row0| * |row1| * |row2| (the
+ * determinant relative to its largest possible value, for the matrix's row norms).
+ */
+#define BATCH_SINGULAR_TOLERANCE 1e-12
+
+/**
+ * represents a batch of 3-dimensional points in structure-of-arrays layout: point i is
+ * (x[i] y[i] z[i]). the batch doesn't own the arrays.
+ */
+struct Batch3D
+{
+    /**
+     * hold the points' first, second and third entries.
+     */
+    double *x;
+    double *y;
+    double *z;
+
+    /**
+     * represents the number of points.
+     */
+    size_t size;
+
+    /**
+     * @param index: 0 <= index < size.
+     * @return a new Vector3D object that holds the point at <index>.
+     */
+    Vector3D at(size_t index) const
+    {
+        return Vector3D(x[index], y[index], z[index]);
+    }
+
+    /**
+     * updates the point at <index>.
+     * @param index: 0 <= index < size.
+     * @param vec: a Vector3D object.
+     */
+    void set(size_t index, Vector3D const& vec) const
+    {
+        x[index] = vec[0];
+        y[index] = vec[1];
+        z[index] = vec[2];
+    }
+};
+
+//---------------------Threads:
+
+/**
+ * sets the number of threads the batch kernels split a batch between.
+ * @param threads: number of threads (0 for the number of cores).
+ */
+void setBatchThreads(unsigned int threads);
+
+/**
+ * @return the number of threads the batch kernels split a batch between.
+ */
+unsigned int batchThreads();
+
+/**
+ * runs <kernel> over [0, n), split into contiguous ranges between the batch threads (see
+ * parallelFor). the ranges start on a multiple of 4 points, so every thread but the last runs
+ * whole vectors.
+ * @param n: the number of points.
+ * @param kernel: callable as kernel(begin, end).
+ */
+template <typename Kernel>
+void batchParallelFor(const size_t n, Kernel kernel)
+{
+    parallelFor(n, parallelChunks(n, batchThreads()), 4, kernel);
+}
+
+//---------------------Kernels:
+// every kernel throws std::invalid_argument if its batches' sizes differ. an output may be one of
+// the inputs.
+
+/**
+ * multiplies every point of <in> by <matrix>.
+ * @param matrix: a Matrix3D object.
+ * @param in: the points.
+ * @param out: receives the products.
+ */
+void batchTransform(Matrix3D const& matrix, Batch3D const& in, Batch3D const& out);
+
+/**
+ * multiplies every point of <in> by <matrix>, and adds <translation> (an affine transform).
+ * @param matrix: a Matrix3D object.
+ * @param translation: a Vector3D object.
+ * @param in: the points.
+ * @param out: receives the transformed points.
+ */
+void batchTransform(Matrix3D const& matrix, Vector3D const& translation, Batch3D const& in,
+                    Batch3D const& out);
+
+/**
+ * @param in: the points.
+ * @param out: array of in.size doubles, receives the norm of every point.
+ */
+void batchNorm(Batch3D const& in, double *out);
+
+/**
+ * @param first: the points.
+ * @param second: the points.
+ * @param out: array of first.size doubles, receives the distance between every pair of points.
+ */
+void batchDist(Batch3D const& first, Batch3D const& second, double *out);
+
+/**
+ * @param first: the points.
+ * @param second: the points.
+ * @param out: array of first.size doubles, receives the scalar product of every pair of points.
+ */
+void batchDot(Batch3D const& first, Batch3D const& second, double *out);
+
+/**
+ * @param first: the points.
+ * @param second: the points.
+ * @param out: array of first.size doubles, receives the angle between every pair of points in
+ *             radians (as operator^).
+ */
+void batchAngle(Batch3D const& first, Batch3D const& second, double *out);
+
+//---------------------Matrix kernels:
+// the matrices are a plain array of Matrix3D objects; the kernels compute four matrices at once
+// (one per vector lane). an output may be the input.
+
+/**
+ * @param matrices: array of <n> Matrix3D objects.
+ * @param n: the number of matrices.
+ * @param out: array of <n> doubles, receives the determinant of every matrix.
+ */
+void batchDeterminant(const Matrix3D *matrices, size_t n, double *out);
+
+/**
+ * inverts every matrix. a singular matrix (see BATCH_SINGULAR_TOLERANCE) gets a zero inverse.
+ * @param matrices: array of <n> Matrix3D objects.
+ * @param n: the number of matrices.
+ * @param out: array of <n> Matrix3D objects, receives the inverses.
+ * @param singular: array of <n> bools, receives true for every singular matrix (may be null).
+ * @return the number of singular matrices.
+ */
+size_t batchInverse(const Matrix3D *matrices, size_t n, Matrix3D *out, bool *singular);
+
+/**
+ * solves matrices[i] * x = rhs[i] for every i. a singular matrix gets a zero solution.
+ * throws std::invalid_argument if rhs and out sizes differ.
+ * @param matrices: array of rhs.size Matrix3D objects.
+ * @param rhs: the right-hand sides.
+ * @param out: receives the solutions.
+ * @param singular: array of rhs.size bools, receives true for every singular matrix (may be null).
+ * @return the number of singular matrices.
+ */
+size_t batchSolve(const Matrix3D *matrices, Batch3D const& rhs, Batch3D const& out, bool *singular);
+
+#endif //BATCH3D_H
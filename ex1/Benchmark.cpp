@@ -0,0 +1,338 @@
+// with ALLOC_TRACKING (make TRACK=1), counts every heap allocation of the program (defined
+// before any header includes the tracker).
+#define ALLOC_TRACK_GLOBAL_NEW
+#include "AllocTracker.hpp"
+#include "Vector3D.h"
+#include "Matrix3D.h"
+#include "Batch3D.h"
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/** error format for a malformed command line.*/
+#define BENCH_USAGE_ERR "Usage: benchmark [--n=<elements>] [--reps=<n>] [--threads=<n>] [--seed=<n>]"
+
+//---------------------Options:
+
+/**
+ * represents the benchmark's parameters.
+ */
+struct BenchOptions
+{
+    /** number of elements in every array.*/
+    size_t n = 1 << 19;
+    /** number of passes over the arrays per operation (the fastest one is reported).*/
+    unsigned long reps = 5;
+    /** number of threads of the batch kernels.*/
+    unsigned int threads = 1;
+    /** seed of the data generator.*/
+    unsigned long seed = 1;
+};
+
+/**
+ * parses a positive integer option (a fraction, a sign or an out of range value is an error).
+ * @param arg: the argument.
+ * @param name: the option's name (e.g. "--n=").
+ * @param out: the value (if arg is the option).
+ * @return true if arg is the option.
+ */
+static bool parseOption(const char *arg, const char *name, unsigned long &out)
+{
+    size_t length = strlen(name);
+    if (strncmp(arg, name, length) != 0)
+    {
+        return false;
+    }
+    const char *digits = arg + length;
+    char *end;
+    errno = 0;
+    out = strtoul(digits, &end, 10);
+    if (!isdigit((unsigned char) *digits) || *end != '\0' || errno == ERANGE || out == 0)
+    {
+        cerr << BENCH_USAGE_ERR << endl;
+        exit(EXIT_FAILURE);
+    }
+    return true;
+}
+
+/**
+ * parses the command line.
+ * @param argc: the number of arguments.
+ * @param argv: the arguments.
+ * @return the options.
+ */
+static BenchOptions parseOptions(int argc, char *argv[])
+{
+    BenchOptions options;
+    for (int i = 1; i < argc; ++i)
+    {
+        unsigned long value = 0;
+        if (parseOption(argv[i], "--n=", value))
+        {
+            options.n = value;
+        }
+        else if (parseOption(argv[i], "--reps=", value))
+        {
+            options.reps = value;
+        }
+        else if (parseOption(argv[i], "--threads=", value) && value <= UINT_MAX)
+        {
+            options.threads = (unsigned int) value;
+        }
+        else if (parseOption(argv[i], "--seed=", value))
+        {
+            options.seed = value;
+        }
+        else
+        {
+            cerr << BENCH_USAGE_ERR << endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+    return options;
+}
+
+//---------------------Timing:
+
+/**
+ * runs <pass> (one pass over the arrays) <reps> times, and prints the fastest pass's time per
+ * element and, if the allocations are counted, the calling thread's allocations per element (over
+ * all the passes).
+ * @param name: the operation's name.
+ * @param n: the number of elements a pass goes over.
+ * @param reps: the number of passes.
+ * @param pass: callable as pass().
+ */
+template <typename Pass>
+static void measure(const string &name, const size_t n, const unsigned long reps, Pass pass)
+{
+    double best = 0;
+    const AllocProbe probe;
+    for (unsigned long rep = 0; rep < reps; ++rep)
+    {
+        const auto start = chrono::steady_clock::now();
+        pass();
+        const double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        best = (rep == 0) ? seconds : min(best, seconds);
+    }
+    cout << left << setw(16) << name << right << fixed << setprecision(2) << setw(10)
+         << best * 1e9 / (double) n << " ns/op";
+    if (AllocTracker::enabled())
+    {
+        const double perOp = (double) probe.allocations() / ((double) n * (double) reps);
+        cout << setprecision(3) << setw(10) << perOp << " allocs/op";
+    }
+    cout << endl;
+}
+
+//---------------------Main:
+
+/**
+ * times the Vector3D and Matrix3D operations, element by element over large arrays, and the batch
+ * kernels over the same data. prints the time per operation and the heap allocations per
+ * operation (if built with TRACK=1) of every one, and a checksum of the results (which keeps them
+ * from being optimized away).
+ */
+int main(int argc, char *argv[])
+{
+    const BenchOptions options = parseOptions(argc, argv);
+    AllocTracker::setEnabled(true);
+    const size_t n = options.n;
+    const unsigned long reps = options.reps;
+    setBatchThreads(options.threads);
+
+    mt19937_64 gen(options.seed);
+    uniform_real_distribution<double> entry(-1, 1);
+    vector<double> x(n), y(n), z(n);
+    vector<Vector3D> a(n), b(n), c(n), out(n);
+    vector<Matrix3D> m1(n), m2(n), matrices(n);
+    vector<double> scalars(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        x[i] = entry(gen);
+        y[i] = entry(gen);
+        z[i] = entry(gen);
+        a[i] = Vector3D(entry(gen), entry(gen), entry(gen));
+        b[i] = Vector3D(entry(gen), entry(gen), entry(gen));
+        c[i] = Vector3D(entry(gen), entry(gen), entry(gen));
+    }
+    for (size_t i = 0; i < n; ++i)
+    {
+        m1[i] = Matrix3D(a[i], b[i], c[i]);
+        m2[i] = Matrix3D(c[i], a[i], b[i]);
+    }
+    const double factor = 1.5;
+    cout << "elements " << n << ", passes " << reps << ", batch threads " << batchThreads()
+         << endl;
+
+    double checksum = 0;
+    // Vector3D:
+    measure("construct", n, reps, [&]()
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            out[i] = Vector3D(x[i], y[i], z[i]);
+        }
+    });
+    checksum += out[n / 2][0];
+    measure("copy", n, reps, [&]()
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            out[i] = Vector3D(a[i]);
+        }
+    });
+    checksum += out[n / 2][1];
+    measure("add", n, reps, [&]()
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            out[i] = a[i] + b[i];
+        }
+    });
+    checksum += out[n / 2][2];
+    measure("subtract", n, reps, [&]()
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            out[i] = a[i] - b[i];
+        }
+    });
+    checksum += out[n / 2][0];
+    measure("add-assign", n, reps, [&]()
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            out[i] += a[i];
+        }
+    });
+    checksum += out[n / 2][1];
+    measure("scale", n, reps, [&]()
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            out[i] = a[i] * factor;
+        }
+    });
+    checksum += out[n / 2][2];
+    measure("divide", n, reps, [&]()
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            out[i] = a[i] / factor;
+        }
+    });
+    checksum += out[n / 2][0];
+    measure("dot", n, reps, [&]()
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            scalars[i] = a[i] * b[i];
+        }
+    });
+    checksum += scalars[n / 2];
+    measure("angle", n, reps, [&]()
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            scalars[i] = a[i] ^ b[i];
+        }
+    });
+    checksum += scalars[n / 2];
+    measure("norm", n, reps, [&]()
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            scalars[i] = a[i].norm();
+        }
+    });
+    checksum += scalars[n / 2];
+    measure("dist", n, reps, [&]()
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            scalars[i] = a[i].dist(b[i]);
+        }
+    });
+    checksum += scalars[n / 2];
+
+    // Matrix3D:
+    measure("matrix construct", n, reps, [&]()
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            matrices[i] = Matrix3D(a[i], b[i], c[i]);
+        }
+    });
+    checksum += matrices[n / 2][1][1];
+    measure("matrix copy", n, reps, [&]()
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            matrices[i] = Matrix3D(m1[i]);
+        }
+    });
+    checksum += matrices[n / 2][2][2];
+    measure("compose", n, reps, [&]()
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            matrices[i] = m1[i] * m2[i];
+        }
+    });
+    checksum += matrices[n / 2][0][0];
+    measure("determinant", n, reps, [&]()
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            scalars[i] = m1[i].determinant();
+        }
+    });
+    checksum += scalars[n / 2];
+    measure("transform", n, reps, [&]()
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            out[i] = m1[i] * a[i];
+        }
+    });
+    checksum += out[n / 2][1];
+
+    // the batch kernels, over the structure-of-arrays layout:
+    vector<double> ox(n), oy(n), oz(n);
+    const Batch3D in{x.data(), y.data(), z.data(), n};
+    const Batch3D transformed{ox.data(), oy.data(), oz.data(), n};
+    measure("batch transform", n, reps, [&]()
+    {
+        batchTransform(m1[0], in, transformed);
+    });
+    checksum += ox[n / 2];
+    measure("batch norm", n, reps, [&]()
+    {
+        batchNorm(in, scalars.data());
+    });
+    checksum += scalars[n / 2];
+    measure("batch dot", n, reps, [&]()
+    {
+        batchDot(in, transformed, scalars.data());
+    });
+    checksum += scalars[n / 2];
+    measure("batch det", n, reps, [&]()
+    {
+        batchDeterminant(m1.data(), n, scalars.data());
+    });
+    checksum += scalars[n / 2];
+
+    cout << "checksum " << setprecision(6) << checksum << endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,304 @@
+#include "KdTree.h"
+#include "AllocTracker.hpp"
+#include "ParallelFor.hpp"
+#include <algorithm>
+#include <limits>
+
+using namespace std;
+
+//---------------------Build:
+
+/**
+ * builds a tree over <points>, the top levels in parallel (on the batch threads).
+ * @param points: the points.
+ */
+KdTree::KdTree(Batch3D const& points)
+{
+    ALLOC_SCOPE("KdTree::KdTree");
+    vector<Entry> entries(points.size);
+    for (size_t i = 0; i < points.size; ++i)
+    {
+        entries[i] = {{points.x[i], points.y[i], points.z[i]}, i};
+    }
+    size_t leaves = 1;
+    while (leaves * KDTREE_LEAF_SIZE < points.size)
+    {
+        leaves *= 2;
+        ++_depth;
+    }
+    _nodes.resize(leaves - 1);
+    unsigned int spawnLevels = 0;
+    if (points.size >= BATCH_MIN_PER_THREAD)
+    {
+        while ((1u << spawnLevels) < batchThreads() && spawnLevels < _depth)
+        {
+            ++spawnLevels;
+        }
+    }
+    _build(entries, 0, 0, points.size, 0, spawnLevels);
+
+    _x.resize(points.size);
+    _y.resize(points.size);
+    _z.resize(points.size);
+    _ids.resize(points.size);
+    for (size_t i = 0; i < points.size; ++i)
+    {
+        _x[i] = entries[i].coords[0];
+        _y[i] = entries[i].coords[1];
+        _z[i] = entries[i].coords[2];
+        _ids[i] = entries[i].id;
+    }
+}
+
+/**
+ * builds the subtree of <node> over entries[begin, end).
+ * @param entries: the points, reordered into tree order.
+ * @param node: the subtree's root.
+ * @param begin: the subtree's first point.
+ * @param end: the subtree's end.
+ * @param level: the node's depth.
+ * @param spawnLevels: number of levels that build their two subtrees in parallel (see parallelFor).
+ */
+void KdTree::_build(vector<Entry>& entries, const size_t node, const size_t begin, const size_t end,
+                    const unsigned int level, const unsigned int spawnLevels)
+{
+    if (level == _depth)
+    {
+        return;
+    }
+    // split across the entry the points spread the most on:
+    double low[3], high[3];
+    for (unsigned int d = 0; d < 3; ++d)
+    {
+        low[d] = numeric_limits<double>::infinity();
+        high[d] = -numeric_limits<double>::infinity();
+    }
+    for (size_t i = begin; i < end; ++i)
+    {
+        for (unsigned int d = 0; d < 3; ++d)
+        {
+            low[d] = min(low[d], entries[i].coords[d]);
+            high[d] = max(high[d], entries[i].coords[d]);
+        }
+    }
+    unsigned int dim = 0;
+    for (unsigned int d = 1; d < 3; ++d)
+    {
+        if (high[d] - low[d] > high[dim] - low[dim])
+        {
+            dim = d;
+        }
+    }
+    const size_t mid = begin + (end - begin) / 2;
+    nth_element(entries.begin() + begin, entries.begin() + mid, entries.begin() + end,
+                [dim](Entry const& a, Entry const& b) { return a.coords[dim] < b.coords[dim]; });
+    _nodes[node] = {entries[mid].coords[dim], dim};
+
+    if (level < spawnLevels)
+    {
+        // the subtrees own disjoint ranges of <entries>, so they are built in parallel.
+        parallelFor(2, 2, 1, [&](const size_t first, const size_t last)
+        {
+            for (size_t side = first; side < last; ++side)
+            {
+                _build(entries, 2 * node + 1 + side, side == 0 ? begin : mid, side == 0 ? mid : end,
+                       level + 1, spawnLevels);
+            }
+        });
+        return;
+    }
+    _build(entries, 2 * node + 1, begin, mid, level + 1, spawnLevels);
+    _build(entries, 2 * node + 2, mid, end, level + 1, spawnLevels);
+}
+
+//---------------------Helpers:
+
+/**
+ * @param index: a point's index in tree order.
+ * @param query: a Vector3D object.
+ * @return the squared distance between the point and <query>.
+ */
+inline double KdTree::_distSquared(const size_t index, Vector3D const& query) const
+{
+    const Vector3D diff = Vector3D(_x[index], _y[index], _z[index]) - query;
+    return diff * diff;
+}
+
+/**
+ * adds the nearest points of the subtree of <node> over [begin, end) to <heap>.
+ * @param query: a Vector3D object.
+ * @param k: the number of neighbours.
+ * @param node, begin, end, level: the subtree (as in _build).
+ * @param heap: max-heap of (squared distance, original index), of at most <k> points.
+ */
+void KdTree::_nearest(Vector3D const& query, const size_t k, const size_t node, const size_t begin,
+                      const size_t end, const unsigned int level,
+                      vector<pair<double, size_t>>& heap) const
+{
+    if (level == _depth)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            const pair<double, size_t> candidate(_distSquared(i, query), _ids[i]);
+            if (heap.size() < k)
+            {
+                heap.push_back(candidate);
+                push_heap(heap.begin(), heap.end());
+            }
+            else if (candidate < heap.front())
+            {
+                pop_heap(heap.begin(), heap.end());
+                heap.back() = candidate;
+                push_heap(heap.begin(), heap.end());
+            }
+        }
+        return;
+    }
+    const Node &split = _nodes[node];
+    const size_t mid = begin + (end - begin) / 2;
+    const double diff = query[split.dim] - split.split;
+    // the near side first; the far one only if the splitting plane is closer than the k-th point.
+    if (diff < 0)
+    {
+        _nearest(query, k, 2 * node + 1, begin, mid, level + 1, heap);
+    }
+    else
+    {
+        _nearest(query, k, 2 * node + 2, mid, end, level + 1, heap);
+    }
+    if (heap.size() < k || diff * diff <= heap.front().first)
+    {
+        if (diff < 0)
+        {
+            _nearest(query, k, 2 * node + 2, mid, end, level + 1, heap);
+        }
+        else
+        {
+            _nearest(query, k, 2 * node + 1, begin, mid, level + 1, heap);
+        }
+    }
+}
+
+/**
+ * adds the points of the subtree of <node> over [begin, end) in the box to <out>.
+ * @param low: a Vector3D object, the box's lowest corner.
+ * @param high: a Vector3D object, the box's highest corner.
+ * @param node, begin, end, level: the subtree (as in _build).
+ * @param out: receives the points' original indexes.
+ */
+void KdTree::_box(Vector3D const& low, Vector3D const& high, const size_t node, const size_t begin,
+                  const size_t end, const unsigned int level, vector<size_t>& out) const
+{
+    if (level == _depth)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            if (_x[i] >= low[0] && _x[i] <= high[0] && _y[i] >= low[1] && _y[i] <= high[1] &&
+                _z[i] >= low[2] && _z[i] <= high[2])
+            {
+                out.push_back(_ids[i]);
+            }
+        }
+        return;
+    }
+    const Node &split = _nodes[node];
+    const size_t mid = begin + (end - begin) / 2;
+    if (low[split.dim] <= split.split)
+    {
+        _box(low, high, 2 * node + 1, begin, mid, level + 1, out);
+    }
+    if (high[split.dim] >= split.split)
+    {
+        _box(low, high, 2 * node + 2, mid, end, level + 1, out);
+    }
+}
+
+/**
+ * adds the points of the subtree of <node> over [begin, end) in the ball to <out>.
+ * @param center: a Vector3D object, the ball's center.
+ * @param radiusSquared: the ball's squared radius.
+ * @param node, begin, end, level: the subtree (as in _build).
+ * @param out: receives the points' original indexes.
+ */
+void KdTree::_radius(Vector3D const& center, const double radiusSquared, const size_t node,
+                     const size_t begin, const size_t end, const unsigned int level,
+                     vector<size_t>& out) const
+{
+    if (level == _depth)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            if (_distSquared(i, center) <= radiusSquared)
+            {
+                out.push_back(_ids[i]);
+            }
+        }
+        return;
+    }
+    const Node &split = _nodes[node];
+    const size_t mid = begin + (end - begin) / 2;
+    const double diff = center[split.dim] - split.split;
+    if (diff <= 0 || diff * diff <= radiusSquared)
+    {
+        _radius(center, radiusSquared, 2 * node + 1, begin, mid, level + 1, out);
+    }
+    if (diff >= 0 || diff * diff <= radiusSquared)
+    {
+        _radius(center, radiusSquared, 2 * node + 2, mid, end, level + 1, out);
+    }
+}
+
+//---------------------Queries:
+
+/**
+ * @param query: a Vector3D object.
+ * @param k: the number of neighbours.
+ * @return the indexes of the min(k, size) points nearest to <query>, nearest first.
+ */
+vector<size_t> KdTree::nearest(Vector3D const& query, const size_t k) const
+{
+    ALLOC_SCOPE("KdTree::nearest");
+    vector<pair<double, size_t>> heap;
+    heap.reserve(min(k, size()));
+    if (k > 0)
+    {
+        _nearest(query, k, 0, 0, size(), 0, heap);
+    }
+    sort_heap(heap.begin(), heap.end());
+    vector<size_t> out;
+    out.reserve(heap.size());
+    for (const pair<double, size_t> &point : heap)
+    {
+        out.push_back(point.second);
+    }
+    return out;
+}
+
+/**
+ * @param center: a Vector3D object.
+ * @param radius: a double.
+ * @return the indexes of the points at distance <= radius from <center>, in no given order.
+ */
+vector<size_t> KdTree::radius(Vector3D const& center, const double radius) const
+{
+    ALLOC_SCOPE("KdTree::radius");
+    vector<size_t> out;
+    if (radius >= 0)
+    {
+        _radius(center, radius * radius, 0, 0, size(), 0, out);
+    }
+    return out;
+}
+
+/**
+ * @param low: a Vector3D object, the box's lowest corner.
+ * @param high: a Vector3D object, the box's highest corner.
+ * @return the indexes of the points in the box (borders included), in no given order.
+ */
+vector<size_t> KdTree::box(Vector3D const& low, Vector3D const& high) const
+{
+    ALLOC_SCOPE("KdTree::box");
+    vector<size_t> out;
+    _box(low, high, 0, 0, size(), 0, out);
+    return out;
+}
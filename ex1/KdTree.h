@@ -0,0 +1,144 @@
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Vector3D.h"
+#include "Batch3D.h"
+
+#ifndef KDTREE_H
+#define KDTREE_H
+/** largest number of points in a leaf.*/
+#define KDTREE_LEAF_SIZE 16
+
+/**
+ * represents a k-d tree over a set of 3-dimensional points, for nearest-neighbour, radius and
+ * box queries in logarithmic time. the tree is balanced and implicit (node i's children are
+ * 2i+1 and 2i+2, and every node splits its points at their median), and it holds its own copy
+ * of the points in tree order, so a leaf's points are contiguous. queries return the points'
+ * indexes in the batch the tree was built from. the tree is immutable: concurrent queries are safe.
+ */
+class KdTree
+{
+private:
+    /**
+     * represents an inner node: the points of its left child have entry <dim> <= split, those of
+     * its right child >= split.
+     */
+    struct Node
+    {
+        double split;
+        unsigned int dim;
+    };
+
+    /**
+     * holds the nodes (the leaves have none).
+     */
+    vector<Node> _nodes;
+
+    /**
+     * represents the depth of the leaves.
+     */
+    unsigned int _depth = 0;
+
+    /**
+     * hold the points in tree order, and their indexes in the original batch.
+     */
+    vector<double> _x, _y, _z;
+    vector<size_t> _ids;
+
+    /**
+     * represents a point while the tree is built (so the build reads contiguous memory).
+     */
+    struct Entry
+    {
+        double coords[3];
+        size_t id;
+    };
+
+    /**
+     * builds the subtree of <node> over entries[begin, end).
+     * @param entries: the points, reordered into tree order.
+     * @param node: the subtree's root.
+     * @param begin: the subtree's first point.
+     * @param end: the subtree's end.
+     * @param level: the node's depth.
+     * @param spawnLevels: number of levels that build their two subtrees in parallel (see
+     *                    parallelFor).
+     */
+    void _build(vector<Entry>& entries, size_t node, size_t begin, size_t end, unsigned int level,
+                unsigned int spawnLevels);
+
+    /**
+     * @param index: a point's index in tree order.
+     * @param query: a Vector3D object.
+     * @return the squared distance between the point and <query>.
+     */
+    double _distSquared(size_t index, Vector3D const& query) const;
+
+    /**
+     * adds the nearest points of the subtree of <node> over [begin, end) to <heap>.
+     * @param query: a Vector3D object.
+     * @param k: the number of neighbours.
+     * @param node, begin, end, level: the subtree (as in _build).
+     * @param heap: max-heap of (squared distance, original index), of at most <k> points.
+     */
+    void _nearest(Vector3D const& query, size_t k, size_t node, size_t begin, size_t end,
+                  unsigned int level, vector<pair<double, size_t>>& heap) const;
+
+    /**
+     * adds the points of the subtree of <node> over [begin, end) in the box to <out>.
+     * @param low: a Vector3D object, the box's lowest corner.
+     * @param high: a Vector3D object, the box's highest corner.
+     * @param node, begin, end, level: the subtree (as in _build).
+     * @param out: receives the points' original indexes.
+     */
+    void _box(Vector3D const& low, Vector3D const& high, size_t node, size_t begin, size_t end,
+              unsigned int level, vector<size_t>& out) const;
+
+    /**
+     * adds the points of the subtree of <node> over [begin, end) in the ball to <out>.
+     * @param center: a Vector3D object, the ball's center.
+     * @param radiusSquared: the ball's squared radius.
+     * @param node, begin, end, level: the subtree (as in _build).
+     * @param out: receives the points' original indexes.
+     */
+    void _radius(Vector3D const& center, double radiusSquared, size_t node, size_t begin,
+                 size_t end, unsigned int level, vector<size_t>& out) const;
+
+public:
+    /**
+     * builds a tree over <points>, the top levels in parallel (on the batch threads).
+     * @param points: the points.
+     */
+    explicit KdTree(Batch3D const& points);
+
+    /**
+     * @return the number of points.
+     */
+    size_t size() const
+    {
+        return _ids.size();
+    }
+
+    /**
+     * @param query: a Vector3D object.
+     * @param k: the number of neighbours.
+     * @return the indexes of the min(k, size) points nearest to <query>, nearest first.
+     */
+    vector<size_t> nearest(Vector3D const& query, size_t k) const;
+
+    /**
+     * @param center: a Vector3D object.
+     * @param radius: a double.
+     * @return the indexes of the points at distance <= radius from <center>, in no given order.
+     */
+    vector<size_t> radius(Vector3D const& center, double radius) const;
+
+    /**
+     * @param low: a Vector3D object, the box's lowest corner.
+     * @param high: a Vector3D object, the box's highest corner.
+     * @return the indexes of the points in the box (borders included), in no given order.
+     */
+    vector<size_t> box(Vector3D const& low, Vector3D const& high) const;
+};
+
+#endif //KDTREE_H
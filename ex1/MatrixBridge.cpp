@@ -0,0 +1,148 @@
+#include "MatrixBridge.h"
+#include "Batch3D.h"
+#include <stdexcept>
+
+using namespace std;
+
+//---------------------Views:
+
+/**
+ * @param matrix: a Matrix3D object.
+ * @return a 3X3 view of the matrix's entries.
+ */
+MatrixView<double> asView(Matrix3D& matrix)
+{
+    return MatrixView<double>(matrix.data(), 3, 3);
+}
+
+/**
+ * @param matrix: a Matrix3D object.
+ * @return a read-only 3X3 view of the matrix's entries.
+ */
+MatrixView<const double> asView(Matrix3D const& matrix)
+{
+    return MatrixView<const double>(matrix.data(), 3, 3);
+}
+
+/**
+ * @param vec: a Vector3D object.
+ * @return a 3X1 (column) view of the vector's entries.
+ */
+MatrixView<double> asView(Vector3D& vec)
+{
+    return MatrixView<double>(vec.data(), 3, 1);
+}
+
+/**
+ * @param vec: a Vector3D object.
+ * @return a read-only 3X1 (column) view of the vector's entries.
+ */
+MatrixView<const double> asView(Vector3D const& vec)
+{
+    return MatrixView<const double>(vec.data(), 3, 1);
+}
+
+//---------------------Conversions:
+
+/**
+ * @param matrix: a Matrix3D object.
+ * @return a new fixed 3X3 matrix with the matrix's entries.
+ */
+FixedMatrix<double, 3, 3> toFixed(Matrix3D const& matrix)
+{
+    return FixedMatrix<double, 3, 3>(matrix.data());
+}
+
+/**
+ * @param vec: a Vector3D object.
+ * @return a new fixed 3X1 matrix with the vector's entries.
+ */
+FixedMatrix<double, 3, 1> toFixed(Vector3D const& vec)
+{
+    return FixedMatrix<double, 3, 1>(vec.data());
+}
+
+/**
+ * throws std::invalid_argument if the view isn't 3X3.
+ * @param view: a view of a generic matrix.
+ * @return a new Matrix3D object with the view's entries.
+ */
+Matrix3D toMatrix3D(MatrixView<const double> const& view)
+{
+    if (view.rows() != 3 || view.cols() != 3)
+    {
+        throw invalid_argument(BRIDGE_SHAPE_ERR);
+    }
+    const double *cells = view.data();
+    const size_t stride = view.stride();
+    return Matrix3D(Vector3D(cells), Vector3D(cells + stride), Vector3D(cells + 2 * stride));
+}
+
+/**
+ * throws std::invalid_argument if the view isn't 3X1 or 1X3.
+ * @param view: a view of a generic matrix.
+ * @return a new Vector3D object with the view's entries.
+ */
+Vector3D toVector3D(MatrixView<const double> const& view)
+{
+    if (view.rows() == 1 && view.cols() == 3)
+    {
+        return Vector3D(view.data());
+    }
+    if (view.rows() != 3 || view.cols() != 1)
+    {
+        throw invalid_argument(BRIDGE_SHAPE_ERR);
+    }
+    return Vector3D(view(0, 0), view(1, 0), view(2, 0));
+}
+
+//---------------------Batch kernels:
+
+/**
+ * composes every pair of matrices through the fixed-size 3X3 kernel (split between the batch
+ * threads): out[i] = first[i] * second[i].
+ * @param first: array of <n> Matrix3D objects.
+ * @param second: array of <n> Matrix3D objects.
+ * @param out: array of <n> Matrix3D objects, receives the products (may not overlap the inputs).
+ * @param n: the number of matrices.
+ */
+void batchMultiply(const Matrix3D *first, const Matrix3D *second, Matrix3D *out, const size_t n)
+{
+    if (n == 0)
+    {
+        return;
+    }
+    batchParallelFor(n, [&](const size_t begin, const size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            multiply(asView(first[i]), asView(second[i]), asView(out[i]));
+        }
+    });
+}
+
+/**
+ * transforms every vector by its matrix through the fixed-size 3X3 by 3X1 kernel (split between
+ * the batch threads): out[i] = matrices[i] * vectors[i].
+ * @param matrices: array of <n> Matrix3D objects.
+ * @param vectors: array of <n> Vector3D objects.
+ * @param out: array of <n> Vector3D objects, receives the products (may not overlap the inputs).
+ * @param n: the number of vectors.
+ */
+void batchMultiply(const Matrix3D *matrices, const Vector3D *vectors, Vector3D *out,
+                   const size_t n)
+{
+    if (n == 0)
+    {
+        return;
+    }
+    batchParallelFor(n, [&](const size_t begin, const size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            // the shapes are fixed, so the views go straight to the unrolled kernel.
+            fixedMultiply<double, 3, 3, 1>(asView(matrices[i]).data(), asView(vectors[i]).data(),
+                                           asView(out[i]).data());
+        }
+    });
+}
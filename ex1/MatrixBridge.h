@@ -0,0 +1,92 @@
+#include <cstddef>
+#include "Vector3D.h"
+#include "Matrix3D.h"
+#include "MatrixView.hpp"
+#include "FixedMatrix.hpp"
+
+#ifndef MATRIXBRIDGE_H
+#define MATRIXBRIDGE_H
+/** error format for a matrix whose dimensions don't fit a Matrix3D or a Vector3D.*/
+#define BRIDGE_SHAPE_ERR "Error: the matrix's dimensions don't fit a Matrix3D or a Vector3D."
+
+// bridges libalg's Matrix3D and Vector3D to the generic matrices of ex3 (MatrixView, FixedMatrix
+// and Matrix<T>): a view sees the libalg object's entries in place (no copy), and any generic
+// matrix is built from a view, e.g. Matrix<double>(asView(m)) or FixedMatrix<double, 3, 3>(asView(m)).
+
+//---------------------Views:
+
+/**
+ * @param matrix: a Matrix3D object.
+ * @return a 3X3 view of the matrix's entries.
+ */
+MatrixView<double> asView(Matrix3D& matrix);
+
+/**
+ * @param matrix: a Matrix3D object.
+ * @return a read-only 3X3 view of the matrix's entries.
+ */
+MatrixView<const double> asView(Matrix3D const& matrix);
+
+/**
+ * @param vec: a Vector3D object.
+ * @return a 3X1 (column) view of the vector's entries.
+ */
+MatrixView<double> asView(Vector3D& vec);
+
+/**
+ * @param vec: a Vector3D object.
+ * @return a read-only 3X1 (column) view of the vector's entries.
+ */
+MatrixView<const double> asView(Vector3D const& vec);
+
+//---------------------Conversions:
+
+/**
+ * @param matrix: a Matrix3D object.
+ * @return a new fixed 3X3 matrix with the matrix's entries.
+ */
+FixedMatrix<double, 3, 3> toFixed(Matrix3D const& matrix);
+
+/**
+ * @param vec: a Vector3D object.
+ * @return a new fixed 3X1 matrix with the vector's entries.
+ */
+FixedMatrix<double, 3, 1> toFixed(Vector3D const& vec);
+
+/**
+ * throws std::invalid_argument if the view isn't 3X3.
+ * @param view: a view of a generic matrix.
+ * @return a new Matrix3D object with the view's entries.
+ */
+Matrix3D toMatrix3D(MatrixView<const double> const& view);
+
+/**
+ * throws std::invalid_argument if the view isn't 3X1 or 1X3.
+ * @param view: a view of a generic matrix.
+ * @return a new Vector3D object with the view's entries.
+ */
+Vector3D toVector3D(MatrixView<const double> const& view);
+
+//---------------------Batch kernels:
+
+/**
+ * composes every pair of matrices through the fixed-size 3X3 kernel (split between the batch
+ * threads): out[i] = first[i] * second[i].
+ * @param first: array of <n> Matrix3D objects.
+ * @param second: array of <n> Matrix3D objects.
+ * @param out: array of <n> Matrix3D objects, receives the products (may not overlap the inputs).
+ * @param n: the number of matrices.
+ */
+void batchMultiply(const Matrix3D *first, const Matrix3D *second, Matrix3D *out, size_t n);
+
+/**
+ * transforms every vector by its matrix through the fixed-size 3X3 by 3X1 kernel (split between
+ * the batch threads): out[i] = matrices[i] * vectors[i].
+ * @param matrices: array of <n> Matrix3D objects.
+ * @param vectors: array of <n> Vector3D objects.
+ * @param out: array of <n> Vector3D objects, receives the products (may not overlap the inputs).
+ * @param n: the number of vectors.
+ */
+void batchMultiply(const Matrix3D *matrices, const Vector3D *vectors, Vector3D *out, size_t n);
+
+#endif //MATRIXBRIDGE_H
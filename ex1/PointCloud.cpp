@@ -0,0 +1,435 @@
+#include "PointCloud.h"
+#include "AllocTracker.hpp"
+#include "ParallelFor.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+//---------------------Helpers:
+
+/**
+ * @param c: a character.
+ * @return true if <c> separates numbers (as for operator>>).
+ */
+static inline bool isSpace(const char c)
+{
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+/**
+ * maps a whole file privately.
+ * @param path: the file's path.
+ * @param writable: true to allow (private) writes to the mapping.
+ * @param length: receives the file's length.
+ * @return the mapping (null for an empty file).
+ */
+static void *mapFile(const char *path, const bool writable, size_t &length)
+{
+    const int fd = open(path, O_RDONLY);
+    struct stat info;
+    if (fd < 0 || fstat(fd, &info) != 0)
+    {
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+        throw runtime_error(string(POINTS_FILE_ERR) + path);
+    }
+    length = (size_t) info.st_size;
+    void *mapping = nullptr;
+    if (length > 0)
+    {
+        mapping = mmap(nullptr, length, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_PRIVATE,
+                       fd, 0);
+    }
+    close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        throw runtime_error(string(POINTS_FILE_ERR) + path);
+    }
+    return mapping;
+}
+
+/**
+ * unmaps a mapping made by mapFile when it goes out of scope.
+ */
+struct MappingGuard
+{
+    void *mapping;
+    size_t length;
+
+    ~MappingGuard()
+    {
+        if (mapping != nullptr)
+        {
+            munmap(mapping, length);
+        }
+    }
+};
+
+/**
+ * parses the whitespace-separated numbers of text[begin, end).
+ * @param text: the whole text (for error offsets).
+ * @param begin: the range's first byte.
+ * @param end: the range's end.
+ * @param out: receives the numbers.
+ */
+static void parseRange(const char *text, const char *begin, const char *end, vector<double> &out)
+{
+    const char *p = begin;
+    while (true)
+    {
+        while (p < end && isSpace(*p))
+        {
+            ++p;
+        }
+        if (p == end)
+        {
+            return;
+        }
+        const char *number = p;
+        if (*p == '+' && p + 1 < end && *(p + 1) != '-') // from_chars doesn't take a leading '+'.
+        {
+            ++p;
+        }
+        double value;
+        const from_chars_result result = from_chars(p, end, value);
+        if (result.ec != errc() || (result.ptr < end && !isSpace(*result.ptr)))
+        {
+            throw invalid_argument(POINTS_PARSE_ERR + to_string(number - text) + ".");
+        }
+        out.push_back(value);
+        p = result.ptr;
+    }
+}
+
+/**
+ * parses whitespace-separated numbers, splitting long texts between the batch threads (at
+ * whitespace, so no number is split).
+ * @param text: the text.
+ * @param length: the text's length.
+ * @param group: the number of values in a point or matrix (the count must be a multiple of it).
+ * @return the numbers, in order.
+ */
+static vector<double> parseValues(const char *text, const size_t length, const size_t group)
+{
+    const size_t chunks = max((size_t) 1, min((size_t) batchThreads(),
+                                              length / POINTS_MIN_PARSE_BYTES));
+    vector<size_t> bounds(1, 0);
+    for (size_t k = 1; k < chunks; ++k)
+    {
+        size_t pos = max(bounds.back(), k * length / chunks);
+        while (pos < length && !isSpace(text[pos]))
+        {
+            ++pos;
+        }
+        bounds.push_back(pos);
+    }
+    bounds.push_back(length);
+
+    vector<vector<double>> parts(chunks);
+    parallelFor(chunks, chunks, 1, [&](const size_t first, const size_t last)
+    {
+        for (size_t k = first; k < last; ++k)
+        {
+            parts[k].reserve((bounds[k + 1] - bounds[k]) / 8);
+            parseRange(text, text + bounds[k], text + bounds[k + 1], parts[k]);
+        }
+    });
+
+    vector<double> values = move(parts[0]);
+    for (size_t k = 1; k < chunks; ++k)
+    {
+        values.insert(values.end(), parts[k].begin(), parts[k].end());
+    }
+    if (values.size() % group != 0)
+    {
+        throw invalid_argument(POINTS_COUNT_ERR + to_string(group) + ".");
+    }
+    return values;
+}
+
+/**
+ * formats doubles into a buffer, and writes it to a stream whenever it fills up.
+ */
+class TextWriter
+{
+private:
+    /**
+     * the stream written to.
+     */
+    ostream &_os;
+
+    /**
+     * holds the formatted text not written yet.
+     */
+    vector<char> _buffer;
+    size_t _used = 0;
+
+public:
+    /**
+     * @param os: a out stream object.
+     */
+    explicit TextWriter(ostream &os): _os(os), _buffer(POINTS_WRITE_BUFFER + 64){}
+
+    /**
+     * writes the rest of the text.
+     */
+    ~TextWriter()
+    {
+        _os.write(_buffer.data(), (streamsize) _used);
+    }
+
+    /**
+     * formats <value> (the shortest text that reads back to it), followed by <separator>.
+     * @param value: a double.
+     * @param separator: a character.
+     */
+    void put(const double value, const char separator)
+    {
+        char *end = to_chars(_buffer.data() + _used, _buffer.data() + _buffer.size(), value).ptr;
+        *end++ = separator;
+        _used = (size_t) (end - _buffer.data());
+        if (_used >= POINTS_WRITE_BUFFER)
+        {
+            _os.write(_buffer.data(), (streamsize) _used);
+            _used = 0;
+        }
+    }
+};
+
+//---------------------Constructors:
+
+/**
+ * construct a new cloud of <size> points initialized to 0.
+ * @param size: the number of points.
+ */
+PointCloud::PointCloud(const size_t size): _storage(3 * size, 0)
+{
+    _batch = {_storage.data(), _storage.data() + size, _storage.data() + 2 * size, size};
+}
+
+/**
+ * construct a new cloud that owns a copy of <points>.
+ * @param points: the points.
+ */
+PointCloud::PointCloud(Batch3D const& points): PointCloud(points.size)
+{
+    copy(points.x, points.x + points.size, _batch.x);
+    copy(points.y, points.y + points.size, _batch.y);
+    copy(points.z, points.z + points.size, _batch.z);
+}
+
+PointCloud::PointCloud(PointCloud&& other) noexcept:
+    _storage(move(other._storage)), _mapping(other._mapping),
+    _mappingLength(other._mappingLength), _batch(other._batch)
+{
+    other._mapping = nullptr;
+    other._batch = {nullptr, nullptr, nullptr, 0};
+}
+
+PointCloud& PointCloud::operator=(PointCloud&& other) noexcept
+{
+    if (this != &other)
+    {
+        _unmap();
+        _storage = move(other._storage);
+        _mapping = other._mapping;
+        _mappingLength = other._mappingLength;
+        _batch = other._batch;
+        other._mapping = nullptr;
+        other._batch = {nullptr, nullptr, nullptr, 0};
+    }
+    return *this;
+}
+
+/**
+ * deletes this cloud (unmaps its file, if any).
+ */
+PointCloud::~PointCloud()
+{
+    _unmap();
+}
+
+/**
+ * unmaps the binary points file, if any.
+ */
+void PointCloud::_unmap()
+{
+    if (_mapping != nullptr)
+    {
+        munmap(_mapping, _mappingLength);
+        _mapping = nullptr;
+    }
+}
+
+//---------------------Loaders:
+
+/**
+ * parses whitespace-separated numbers, every 3 of which are a point ("x y z").
+ * @param text: the text.
+ * @param length: the text's length.
+ * @return a new PointCloud object that owns the points.
+ */
+PointCloud PointCloud::parseText(const char *text, const size_t length)
+{
+    ALLOC_SCOPE("PointCloud::parseText");
+    const vector<double> values = parseValues(text, length, 3);
+    PointCloud cloud(values.size() / 3);
+    const Batch3D &points = cloud._batch;
+    for (size_t i = 0; i < points.size; ++i)
+    {
+        points.x[i] = values[3 * i];
+        points.y[i] = values[3 * i + 1];
+        points.z[i] = values[3 * i + 2];
+    }
+    return cloud;
+}
+
+/**
+ * reads a text file of whitespace-separated numbers, every 3 of which are a point.
+ * @param path: the file's path.
+ * @return a new PointCloud object that owns the points.
+ */
+PointCloud PointCloud::readText(const char *path)
+{
+    ALLOC_SCOPE("PointCloud::readText");
+    size_t length;
+    const MappingGuard guard = {mapFile(path, false, length), length};
+    return parseText((const char *) guard.mapping, length);
+}
+
+/**
+ * maps a binary points file (see PointsHeader). writes to the points are private.
+ * @param path: the file's path.
+ * @return a new PointCloud object whose points are the file's.
+ */
+PointCloud PointCloud::mapBinary(const char *path)
+{
+    ALLOC_SCOPE("PointCloud::mapBinary");
+    size_t length;
+    void *mapping = mapFile(path, true, length);
+    const PointsHeader *header = (const PointsHeader *) mapping;
+    if (length < sizeof(PointsHeader) || memcmp(header->magic, POINTS_MAGIC, 8) != 0 ||
+        header->version != POINTS_VERSION || header->valueSize != sizeof(double) ||
+        header->count > (length - sizeof(PointsHeader)) / (3 * sizeof(double)) ||
+        length != sizeof(PointsHeader) + 3 * sizeof(double) * header->count)
+    {
+        if (mapping != nullptr)
+        {
+            munmap(mapping, length);
+        }
+        throw invalid_argument(string(POINTS_FORMAT_ERR) + path);
+    }
+    PointCloud cloud;
+    cloud._mapping = mapping;
+    cloud._mappingLength = length;
+    const size_t count = (size_t) header->count;
+    double *x = (double *) ((char *) mapping + sizeof(PointsHeader));
+    cloud._batch = {x, x + count, x + 2 * count, count};
+    return cloud;
+}
+
+//---------------------Bulk writers and readers:
+
+/**
+ * writes every point of <points> as a line "x y z" (the shortest text that reads back to the
+ * same doubles).
+ * @param os: a out stream object.
+ * @param points: the points.
+ */
+void writeText(ostream& os, Batch3D const& points)
+{
+    TextWriter writer(os);
+    for (size_t i = 0; i < points.size; ++i)
+    {
+        writer.put(points.x[i], ' ');
+        writer.put(points.y[i], ' ');
+        writer.put(points.z[i], '\n');
+    }
+}
+
+/**
+ * writes <points> in the binary points format (see PointsHeader).
+ * @param path: the file's path.
+ * @param points: the points.
+ */
+void writeBinary(const char *path, Batch3D const& points)
+{
+    ofstream file(path, ios::binary | ios::trunc);
+    PointsHeader header = {{0}, POINTS_VERSION, sizeof(double), points.size, 0};
+    memcpy(header.magic, POINTS_MAGIC, 8);
+    file.write((const char *) &header, sizeof(header));
+    for (const double *array : {points.x, points.y, points.z})
+    {
+        file.write((const char *) array, (streamsize) (points.size * sizeof(double)));
+    }
+    file.close();
+    if (!file)
+    {
+        throw runtime_error(string(POINTS_FILE_ERR) + path);
+    }
+}
+
+/**
+ * parses whitespace-separated numbers, every 9 of which are a matrix (row by row).
+ * @param text: the text.
+ * @param length: the text's length.
+ * @return the matrices.
+ */
+vector<Matrix3D> parseMatrices(const char *text, const size_t length)
+{
+    ALLOC_SCOPE("parseMatrices");
+    const vector<double> values = parseValues(text, length, 9);
+    vector<Matrix3D> matrices;
+    matrices.reserve(values.size() / 9);
+    for (size_t i = 0; i < values.size(); i += 9)
+    {
+        matrices.emplace_back(values.data() + i);
+    }
+    return matrices;
+}
+
+/**
+ * reads a text file of whitespace-separated numbers, every 9 of which are a matrix (row by row).
+ * @param path: the file's path.
+ * @return the matrices.
+ */
+vector<Matrix3D> readMatrices(const char *path)
+{
+    ALLOC_SCOPE("readMatrices");
+    size_t length;
+    const MappingGuard guard = {mapFile(path, false, length), length};
+    return parseMatrices((const char *) guard.mapping, length);
+}
+
+/**
+ * writes every matrix as in operator<< (three lines "a b c"), with the shortest text that reads
+ * back to the same doubles.
+ * @param os: a out stream object.
+ * @param matrices: array of <n> Matrix3D objects.
+ * @param n: the number of matrices.
+ */
+void writeMatrices(ostream& os, const Matrix3D *matrices, const size_t n)
+{
+    TextWriter writer(os);
+    for (size_t i = 0; i < n; ++i)
+    {
+        for (unsigned short row = 0; row < 3; ++row)
+        {
+            const double *vec = matrices[i][row];
+            writer.put(vec[0], ' ');
+            writer.put(vec[1], ' ');
+            writer.put(vec[2], '\n');
+        }
+    }
+}
@@ -0,0 +1,193 @@
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+#include "Vector3D.h"
+#include "Matrix3D.h"
+#include "Batch3D.h"
+
+#ifndef POINTCLOUD_H
+#define POINTCLOUD_H
+/** error format for a file that can't be read or written.*/
+#define POINTS_FILE_ERR "Error: cannot access file: "
+/** error format for text that isn't whitespace-separated numbers.*/
+#define POINTS_PARSE_ERR "Error: malformed number at byte "
+/** error format for a number count that doesn't fill whole points or matrices.*/
+#define POINTS_COUNT_ERR "Error: the number of values is not a multiple of "
+/** error format for a file that isn't in the binary points format.*/
+#define POINTS_FORMAT_ERR "Error: not a binary points file: "
+/** the binary format's magic bytes.*/
+#define POINTS_MAGIC "ALG3DSOA"
+/** the binary format's version.*/
+#define POINTS_VERSION 1
+/** least number of text bytes given to a parsing thread.*/
+#define POINTS_MIN_PARSE_BYTES (1 << 20)
+/** size of the buffer the text writers format into, before writing it out.*/
+#define POINTS_WRITE_BUFFER (1 << 20)
+
+/**
+ * the binary points format: this header, then the x entries of all points, then the y entries,
+ * then the z entries (native doubles). the header is 32 bytes, so on a mapped file every array is
+ * 32-byte aligned when count is a multiple of 4, and always 8-byte aligned.
+ */
+struct PointsHeader
+{
+    /** holds POINTS_MAGIC (not null-terminated).*/
+    char magic[8];
+    /** holds POINTS_VERSION.*/
+    uint32_t version;
+    /** holds sizeof(double), to reject files of other platforms.*/
+    uint32_t valueSize;
+    /** holds the number of points.*/
+    uint64_t count;
+    /** reserved (0).*/
+    uint64_t reserved;
+};
+
+/**
+ * represents a set of 3-dimensional points in structure-of-arrays layout (see Batch3D). the points
+ * are either owned, or a private (copy-on-write) mapping of a binary points file, so loading a
+ * file of any size costs no copy.
+ * throws std::runtime_error if a file can't be accessed, and std::invalid_argument for bad data.
+ */
+class PointCloud
+{
+private:
+    /**
+     * holds the owned points: all x entries, then all y entries, then all z entries.
+     */
+    vector<double> _storage;
+
+    /**
+     * hold the mapping of a binary points file (null if the points are owned).
+     */
+    void *_mapping = nullptr;
+    size_t _mappingLength = 0;
+
+    /**
+     * holds the points' view.
+     */
+    Batch3D _batch = {nullptr, nullptr, nullptr, 0};
+
+    /**
+     * unmaps the binary points file, if any.
+     */
+    void _unmap();
+
+public:
+    //--------------------constructors:
+    /**
+     * construct a new cloud of <size> points initialized to 0.
+     * @param size: the number of points.
+     */
+    explicit PointCloud(size_t size = 0);
+
+    /**
+     * construct a new cloud that owns a copy of <points>.
+     * @param points: the points.
+     */
+    explicit PointCloud(Batch3D const& points);
+
+    PointCloud(PointCloud&& other) noexcept;
+    PointCloud& operator=(PointCloud&& other) noexcept;
+    PointCloud(PointCloud const& other) = delete;
+    PointCloud& operator=(PointCloud const& other) = delete;
+
+    /**
+     * deletes this cloud (unmaps its file, if any).
+     */
+    ~PointCloud();
+
+    //---------------------Loaders:
+
+    /**
+     * parses whitespace-separated numbers, every 3 of which are a point ("x y z").
+     * @param text: the text.
+     * @param length: the text's length.
+     * @return a new PointCloud object that owns the points.
+     */
+    static PointCloud parseText(const char *text, size_t length);
+
+    /**
+     * reads a text file of whitespace-separated numbers, every 3 of which are a point.
+     * @param path: the file's path.
+     * @return a new PointCloud object that owns the points.
+     */
+    static PointCloud readText(const char *path);
+
+    /**
+     * maps a binary points file (see PointsHeader). writes to the points are private.
+     * @param path: the file's path.
+     * @return a new PointCloud object whose points are the file's.
+     */
+    static PointCloud mapBinary(const char *path);
+
+    //---------------------Methods:
+
+    /**
+     * @return the number of points.
+     */
+    size_t size() const
+    {
+        return _batch.size;
+    }
+
+    /**
+     * @return a view of the points.
+     */
+    Batch3D const& batch() const
+    {
+        return _batch;
+    }
+
+    /**
+     * @return true if the points are a mapping of a binary points file.
+     */
+    bool isMapped() const
+    {
+        return _mapping != nullptr;
+    }
+};
+
+//---------------------Bulk writers and readers:
+
+/**
+ * writes every point of <points> as a line "x y z" (the shortest text that reads back to the
+ * same doubles).
+ * @param os: a out stream object.
+ * @param points: the points.
+ */
+void writeText(ostream& os, Batch3D const& points);
+
+/**
+ * writes <points> in the binary points format (see PointsHeader).
+ * @param path: the file's path.
+ * @param points: the points.
+ */
+void writeBinary(const char *path, Batch3D const& points);
+
+/**
+ * parses whitespace-separated numbers, every 9 of which are a matrix (row by row).
+ * @param text: the text.
+ * @param length: the text's length.
+ * @return the matrices.
+ */
+vector<Matrix3D> parseMatrices(const char *text, size_t length);
+
+/**
+ * reads a text file of whitespace-separated numbers, every 9 of which are a matrix (row by row).
+ * @param path: the file's path.
+ * @return the matrices.
+ */
+vector<Matrix3D> readMatrices(const char *path);
+
+/**
+ * writes every matrix as in operator<< (three lines "a b c"), with the shortest text that reads
+ * back to the same doubles.
+ * @param os: a out stream object.
+ * @param matrices: array of <n> Matrix3D objects.
+ * @param n: the number of matrices.
+ */
+void writeMatrices(ostream& os, const Matrix3D *matrices, size_t n);
+
+#endif //POINTCLOUD_H
@@ -0,0 +1,146 @@
+#include "Quaternion.h"
+#include <cmath>
+
+using namespace std;
+
+//---------------------Factories:
+
+/**
+ * @param axis: Vector3D object, the rotation's axis (need not be normalized).
+ * @param angle: the rotation's angle in radians (counter-clockwise around the axis).
+ * @return a new unit Quaternion that represents the rotation.
+ */
+Quaternion Quaternion::fromAxisAngle(Vector3D const& axis, const double angle)
+{
+    const double norm = axis.norm();
+    if (norm == 0)
+    {
+        return Quaternion();
+    }
+    return Quaternion(cos(angle / 2), axis * (sin(angle / 2) / norm));
+}
+
+/**
+ * @param rotation: Matrix3D object, a rotation matrix.
+ * @return a new unit Quaternion that represents the rotation.
+ */
+Quaternion Quaternion::fromMatrix(Matrix3D const& rotation)
+{
+    const double *r0 = rotation[0], *r1 = rotation[1], *r2 = rotation[2];
+    const double trace = rotation.trace();
+    // Shepperd's method: divide by the largest of the four candidates, for stability.
+    if (trace > 0)
+    {
+        const double s = sqrt(trace + 1) * 2;
+        return Quaternion(s / 4, (r2[1] - r1[2]) / s, (r0[2] - r2[0]) / s,
+                          (r1[0] - r0[1]) / s).normalized();
+    }
+    if (r0[0] > r1[1] && r0[0] > r2[2])
+    {
+        const double s = sqrt(1 + r0[0] - r1[1] - r2[2]) * 2;
+        return Quaternion((r2[1] - r1[2]) / s, s / 4, (r0[1] + r1[0]) / s,
+                          (r0[2] + r2[0]) / s).normalized();
+    }
+    if (r1[1] > r2[2])
+    {
+        const double s = sqrt(1 + r1[1] - r0[0] - r2[2]) * 2;
+        return Quaternion((r0[2] - r2[0]) / s, (r0[1] + r1[0]) / s, s / 4,
+                          (r1[2] + r2[1]) / s).normalized();
+    }
+    const double s = sqrt(1 + r2[2] - r0[0] - r1[1]) * 2;
+    return Quaternion((r1[0] - r0[1]) / s, (r0[2] + r2[0]) / s, (r1[2] + r2[1]) / s,
+                      s / 4).normalized();
+}
+
+//---------------------Other methods:
+
+/**
+ * @return the norm of this Quaternion object.
+ */
+double Quaternion::norm() const
+{
+    return sqrt(_w * _w + _vec * _vec);
+}
+
+/**
+ * @return a new unit Quaternion object, in the direction of this one.
+ */
+Quaternion Quaternion::normalized() const
+{
+    const double norm = this->norm();
+    return Quaternion(_w / norm, _vec / norm);
+}
+
+/**
+ * @return a new Quaternion object, this one's multiplicative inverse.
+ */
+Quaternion Quaternion::inverse() const
+{
+    const double normSquared = _w * _w + _vec * _vec;
+    return Quaternion(_w / normSquared, _vec / -normSquared);
+}
+
+/**
+ * @return a new Matrix3D object, the rotation matrix of this unit Quaternion.
+ */
+Matrix3D Quaternion::toMatrix() const
+{
+    const double x = _vec[0], y = _vec[1], z = _vec[2];
+    const double xx = x * x, yy = y * y, zz = z * z;
+    const double xy = x * y, xz = x * z, yz = y * z, wx = _w * x, wy = _w * y, wz = _w * z;
+    return Matrix3D(1 - 2 * (yy + zz), 2 * (xy - wz), 2 * (xz + wy),
+                    2 * (xy + wz), 1 - 2 * (xx + zz), 2 * (yz - wx),
+                    2 * (xz - wy), 2 * (yz + wx), 1 - 2 * (xx + yy));
+}
+
+/**
+ * spherical linear interpolation between two unit quaternions, along the shorter arc.
+ * @param from: a Quaternion object (returned for t = 0).
+ * @param to: a Quaternion object (returned for t = 1, up to sign).
+ * @param t: 0 <= t <= 1.
+ * @return a new unit Quaternion object.
+ */
+Quaternion Quaternion::slerp(Quaternion const& from, Quaternion const& to, const double t)
+{
+    double cosine = from._w * to._w + from._vec * to._vec;
+    // q and -q are the same rotation: take the one on the shorter arc.
+    const double sign = cosine < 0 ? -1 : 1;
+    cosine *= sign;
+    double fromWeight = 1 - t, toWeight = t * sign;
+    if (cosine < SLERP_LINEAR_THRESHOLD)
+    {
+        const double angle = acos(cosine), sine = sin(angle);
+        fromWeight = sin((1 - t) * angle) / sine;
+        toWeight = sign * sin(t * angle) / sine;
+    }
+    return Quaternion(from._w * fromWeight + to._w * toWeight,
+                      from._vec * fromWeight + to._vec * toWeight).normalized();
+}
+
+//---------------------Operators:
+
+/**
+ * prints the quaternion at the format: "w x y z" and \n, to <os>.
+ * @param os: a out stream object.
+ * @param quaternion: a Quaternion object.
+ * @return the <os>. (to allow concatenating).
+ */
+ostream& operator<<(ostream& os, Quaternion const& quaternion)
+{
+    os << quaternion._w << " " << quaternion._vec;
+    return os;
+}
+
+//---------------------Batch kernels:
+
+/**
+ * rotates every point of <in> by the unit quaternion <rotation>.
+ * @param rotation: a Quaternion object.
+ * @param in: the points.
+ * @param out: receives the rotated points (may be <in>).
+ */
+void batchRotate(Quaternion const& rotation, Batch3D const& in, Batch3D const& out)
+{
+    // for many points, one conversion to a matrix makes every point 9 fused multiply-adds.
+    batchTransform(rotation.toMatrix(), in, out);
+}
@@ -0,0 +1,55 @@
+#include "RigidTransform.h"
+
+using namespace std;
+
+//---------------------Methods:
+
+/**
+ * @return a new RigidTransform object, this one's inverse.
+ */
+RigidTransform RigidTransform::inverse() const
+{
+    const Quaternion rotation = _rotation.conjugate();
+    return RigidTransform(rotation, rotation.rotate(_translation) * -1);
+}
+
+/**
+ * interpolates between two transforms: slerp of the rotations, linear of the translations.
+ * @param from: a RigidTransform object (returned for t = 0).
+ * @param to: a RigidTransform object (returned for t = 1).
+ * @param t: 0 <= t <= 1.
+ * @return a new RigidTransform object.
+ */
+RigidTransform RigidTransform::interpolate(RigidTransform const& from, RigidTransform const& to,
+                                           const double t)
+{
+    return RigidTransform(Quaternion::slerp(from._rotation, to._rotation, t),
+                          from._translation * (1 - t) + to._translation * t);
+}
+
+//---------------------Operators:
+
+/**
+ * prints the transform at the format: "rotation's w x y z" \n "translation" \n, to <os>.
+ * @param os: a out stream object.
+ * @param transform: a RigidTransform object.
+ * @return the <os>. (to allow concatenating).
+ */
+ostream& operator<<(ostream& os, RigidTransform const& transform)
+{
+    os << transform._rotation << transform._translation;
+    return os;
+}
+
+//---------------------Batch kernels:
+
+/**
+ * applies <transform> to every point of <in>.
+ * @param transform: a RigidTransform object.
+ * @param in: the points.
+ * @param out: receives the transformed points (may be <in>).
+ */
+void batchApply(RigidTransform const& transform, Batch3D const& in, Batch3D const& out)
+{
+    batchTransform(transform.toMatrix(), transform.translation(), in, out);
+}
@@ -0,0 +1,135 @@
+#include <iostream>
+#include "Vector3D.h"
+#include "Matrix3D.h"
+#include "Quaternion.h"
+#include "Batch3D.h"
+
+#ifndef RIGIDTRANSFORM_H
+#define RIGIDTRANSFORM_H
+
+/**
+ * represents a rigid transform: a rotation (unit quaternion) followed by a translation. applying
+ * one to a vector v gives rotation * v + translation.
+ */
+class RigidTransform
+{
+private:
+    /**
+     * holds the rotation.
+     */
+    Quaternion _rotation;
+
+    /**
+     * holds the translation.
+     */
+    Vector3D _translation;
+
+public:
+    //--------------------constructors:
+    /**
+     * default constructor: the identity transform.
+     */
+    constexpr RigidTransform() = default;
+
+    /**
+     * construct a new transform.
+     * @param rotation: a unit Quaternion object.
+     * @param translation: a Vector3D object.
+     */
+    constexpr RigidTransform(Quaternion const& rotation, Vector3D const& translation):
+        _rotation(rotation), _translation(translation){}
+
+    //---------------------Methods:
+
+    /**
+     * @return the rotation.
+     */
+    constexpr Quaternion const& rotation() const
+    {
+        return _rotation;
+    }
+
+    /**
+     * @return the translation.
+     */
+    constexpr Vector3D const& translation() const
+    {
+        return _translation;
+    }
+
+    /**
+     * @return a new RigidTransform object, this one's inverse.
+     */
+    RigidTransform inverse() const;
+
+    /**
+     * @return a new Matrix3D object, the rotation matrix of this transform.
+     */
+    Matrix3D toMatrix() const
+    {
+        return _rotation.toMatrix();
+    }
+
+    /**
+     * applies this transform to <vec>.
+     * @param vec: a Vector3D object.
+     * @return a new Vector3D object, the transformed vector.
+     */
+    constexpr Vector3D apply(Vector3D const& vec) const
+    {
+        return _rotation.rotate(vec) + _translation;
+    }
+
+    /**
+     * interpolates between two transforms: slerp of the rotations, linear of the translations.
+     * @param from: a RigidTransform object (returned for t = 0).
+     * @param to: a RigidTransform object (returned for t = 1).
+     * @param t: 0 <= t <= 1.
+     * @return a new RigidTransform object.
+     */
+    static RigidTransform interpolate(RigidTransform const& from, RigidTransform const& to,
+                                      double t);
+
+    //---------------------Operators:
+
+    /**
+     * composes two transforms: (first * second) applies <second>, then <first>.
+     * @param first: a RigidTransform object.
+     * @param second: a RigidTransform object.
+     * @return : a new RigidTransform object, that holds the composition.
+     */
+    friend constexpr RigidTransform operator*(RigidTransform const& first,
+                                              RigidTransform const& second)
+    {
+        return RigidTransform(first._rotation * second._rotation, first.apply(second._translation));
+    }
+
+    /**
+     * applies <transform> to <vec>.
+     * @param transform: a RigidTransform object.
+     * @param vec: a Vector3D object.
+     * @return : a new Vector3D object, the transformed vector.
+     */
+    friend constexpr Vector3D operator*(RigidTransform const& transform, Vector3D const& vec)
+    {
+        return transform.apply(vec);
+    }
+
+    /**
+     * prints the transform at the format: "rotation's w x y z" \n "translation" \n, to <os>.
+     * @param os: a out stream object.
+     * @param transform: a RigidTransform object.
+     * @return the <os>. (to allow concatenating).
+     */
+    friend ostream& operator<<(ostream& os, RigidTransform const& transform);
+};
+
+/**
+ * applies <transform> to every point of <in>.
+ * @param transform: a RigidTransform object.
+ * @param in: the points.
+ * @param out: receives the transformed points (may be <in>).
+ */
+void batchApply(RigidTransform const& transform, Batch3D const& in, Batch3D const& out);
+
+#endif //RIGIDTRANSFORM_H
@@ -0,0 +1,390 @@
+#include "Vector3D.h"
+#include "Matrix3D.h"
+#include "Batch3D.h"
+#include "KdTree.h"
+#include "UniformGrid.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/** number of queries of every type, run on every point set.*/
+#define CHECK_QUERIES 40
+/** number of copies of every matrix in its batch: covers the vectorized groups and the tail.*/
+#define CHECK_COPIES 7
+/**
+ * largest error accepted in the entries of inverse * matrix, and in a solution's coordinates (the
+ * worst conditioned matrices checked lose about 7 digits).
+ */
+#define CHECK_MATRIX_ERROR 1e-6
+
+//---------------------Point sets:
+
+/**
+ * holds a point set's entries, and the batch that points to them.
+ */
+struct PointSet
+{
+    string name;
+    vector<double> x, y, z;
+
+    /**
+     * @return the batch of the set's points.
+     */
+    Batch3D batch()
+    {
+        return Batch3D{x.data(), y.data(), z.data(), x.size()};
+    }
+
+    /**
+     * @param index: 0 <= index < size.
+     * @return the point at <index>.
+     */
+    Vector3D at(size_t index) const
+    {
+        return Vector3D(x[index], y[index], z[index]);
+    }
+};
+
+/**
+ * @param name: the set's name.
+ * @param n: the number of points.
+ * @param point: callable as point(i), returns the i-th point.
+ * @return the set.
+ */
+template <typename Point>
+static PointSet makeSet(string const& name, const size_t n, Point point)
+{
+    PointSet set{name, vector<double>(n), vector<double>(n), vector<double>(n)};
+    for (size_t i = 0; i < n; ++i)
+    {
+        const Vector3D p = point(i);
+        set.x[i] = p[0];
+        set.y[i] = p[1];
+        set.z[i] = p[2];
+    }
+    return set;
+}
+
+/**
+ * @param rng: the random generator.
+ * @return random, planar and degenerate (duplicated, identical and collinear) sets, small and
+ * large (the large ones are built in parallel).
+ */
+static vector<PointSet> makeSets(mt19937_64& rng)
+{
+    uniform_real_distribution<double> coord(-10, 10);
+    uniform_int_distribution<int> lattice(-3, 3);
+    vector<PointSet> sets;
+    for (const size_t n : {(size_t) 0, (size_t) 1, (size_t) 17, (size_t) 1000, (size_t) 70000})
+    {
+        const string size = " (" + to_string(n) + ")";
+        sets.push_back(makeSet("random" + size, n, [&](size_t)
+        {
+            return Vector3D(coord(rng), coord(rng), coord(rng));
+        }));
+        sets.push_back(makeSet("planar" + size, n, [&](size_t)
+        {
+            return Vector3D(coord(rng), coord(rng), 0);
+        }));
+        sets.push_back(makeSet("duplicated" + size, n, [&](size_t)
+        {
+            return Vector3D(lattice(rng), lattice(rng), lattice(rng));
+        }));
+        sets.push_back(makeSet("identical" + size, n, [&](size_t)
+        {
+            return Vector3D(1, 2, 3);
+        }));
+        sets.push_back(makeSet("collinear" + size, n, [&](size_t)
+        {
+            return Vector3D(coord(rng), 0, 0);
+        }));
+    }
+    return sets;
+}
+
+//---------------------Brute force:
+
+/**
+ * @param a: a Vector3D object.
+ * @param b: a Vector3D object.
+ * @return the squared distance between a and b.
+ */
+static double distSquared(Vector3D const& a, Vector3D const& b)
+{
+    const double dx = a[0] - b[0], dy = a[1] - b[1], dz = a[2] - b[2];
+    return dx * dx + dy * dy + dz * dz;
+}
+
+/**
+ * @param set: the points.
+ * @param query: a Vector3D object.
+ * @return the squared distances of all the points from <query>, smallest first.
+ */
+static vector<double> sortedDistances(PointSet const& set, Vector3D const& query)
+{
+    vector<double> dists(set.x.size());
+    for (size_t i = 0; i < dists.size(); ++i)
+    {
+        dists[i] = distSquared(set.at(i), query);
+    }
+    sort(dists.begin(), dists.end());
+    return dists;
+}
+
+/**
+ * @param set: the points.
+ * @param keep: callable as keep(point), true for the points that belong in the result.
+ * @return the indexes of the points kept, in order.
+ */
+template <typename Keep>
+static vector<size_t> bruteSelect(PointSet const& set, Keep keep)
+{
+    vector<size_t> ids;
+    for (size_t i = 0; i < set.x.size(); ++i)
+    {
+        if (keep(set.at(i)))
+        {
+            ids.push_back(i);
+        }
+    }
+    return ids;
+}
+
+//---------------------Checks:
+
+/**
+ * counts the failed checks, and prints the first ones.
+ */
+struct Report
+{
+    unsigned long checks = 0;
+    unsigned long failures = 0;
+
+    /**
+     * records a check.
+     * @param ok: true if it passed.
+     * @param what: describes it.
+     */
+    void check(const bool ok, string const& what)
+    {
+        ++checks;
+        if (!ok && failures++ < 10)
+        {
+            cerr << "failed: " << what << endl;
+        }
+    }
+};
+
+/**
+ * checks the nearest, radius and box queries of <index> (a KdTree or a UniformGrid) over <set>
+ * against brute force: the nearest points must be at the k smallest distances (ties may be
+ * broken either way), and the radius and box queries must return exactly the points in range.
+ * @param index: the spatial index, built over <set>.
+ * @param name: the index's name.
+ * @param set: the points.
+ * @param rng: the random generator.
+ * @param report: records the checks.
+ */
+template <typename Index>
+static void checkIndex(Index const& index, string const& name, PointSet const& set,
+                       mt19937_64& rng, Report& report)
+{
+    const string where = name + " over " + set.name;
+    const size_t n = set.x.size();
+    report.check(index.size() == n, where + ": size");
+    uniform_real_distribution<double> coord(-12, 12);
+    uniform_real_distribution<double> extent(0, 6);
+    for (unsigned int q = 0; q < CHECK_QUERIES; ++q)
+    {
+        // every other query is one of the points (or a random point, if there are none).
+        const Vector3D query = (q % 2 == 0 && n > 0) ? set.at(rng() % n)
+                                                     : Vector3D(coord(rng), coord(rng), coord(rng));
+        const vector<double> dists = sortedDistances(set, query);
+        for (const size_t k : {(size_t) 0, (size_t) 1, (size_t) 5, n + 3})
+        {
+            const vector<size_t> ids = index.nearest(query, k);
+            bool ok = ids.size() == min(k, n);
+            vector<bool> seen(n, false);
+            for (size_t i = 0; ok && i < ids.size(); ++i)
+            {
+                ok = ids[i] < n && !seen[ids[i]] && distSquared(set.at(ids[i]), query) == dists[i];
+                if (ok)
+                {
+                    seen[ids[i]] = true;
+                }
+            }
+            report.check(ok, where + ": nearest " + to_string(k));
+        }
+        for (const double radius : {0.0, 0.5, 1.0, extent(rng)})
+        {
+            vector<size_t> ids = index.radius(query, radius);
+            sort(ids.begin(), ids.end());
+            report.check(ids == bruteSelect(set, [&](Vector3D const& p)
+            {
+                return distSquared(p, query) <= radius * radius;
+            }), where + ": radius " + to_string(radius));
+        }
+        const Vector3D high(query[0] + extent(rng), query[1] + extent(rng), query[2] + extent(rng));
+        for (const Vector3D& top : {query, high})
+        {
+            vector<size_t> ids = index.box(query, top);
+            sort(ids.begin(), ids.end());
+            report.check(ids == bruteSelect(set, [&](Vector3D const& p)
+            {
+                return p[0] >= query[0] && p[0] <= top[0] && p[1] >= query[1] && p[1] <= top[1] &&
+                       p[2] >= query[2] && p[2] <= top[2];
+            }), where + ": box");
+        }
+    }
+}
+
+/**
+ * checks that a grid rejects a cell size that splits the points' bounds into more cells than its
+ * coordinates hold, and that a nearest query far from two tight clusters, over tiny cells (most
+ * of them empty), ends quickly (by scanning the points).
+ * @param report: records the checks.
+ */
+static void checkGridLimits(Report& report)
+{
+    PointSet spread = makeSet("spread", 2, [](size_t i)
+    {
+        return Vector3D((double) i, 0, 0);
+    });
+    bool rejected = false;
+    try
+    {
+        UniformGrid(spread.batch(), 1e-300);
+    }
+    catch (invalid_argument const&)
+    {
+        rejected = true;
+    }
+    report.check(rejected, "UniformGrid(1e-300) over spread: rejected");
+    PointSet clusters = makeSet("clusters", 200000, [](size_t i)
+    {
+        const Vector3D offset = Vector3D((double) (i % 97), (double) (i % 89), (double) (i % 83));
+        return offset * 1e-5 + (i % 2 == 0 ? Vector3D() : Vector3D(100, 100, 100));
+    });
+    const Vector3D query(1e3, 0, 0);
+    const vector<size_t> ids = UniformGrid(clusters.batch(), 1e-2).nearest(query, 1);
+    report.check(ids.size() == 1 && distSquared(clusters.at(ids[0]), query) ==
+                 sortedDistances(clusters, query)[0], "UniformGrid(0.01) over clusters: far nearest");
+}
+
+/**
+ * checks batchInverse and batchSolve over copies of <matrix>: every copy must be flagged as
+ * <singular> expects, get the same result wherever it sits in the batch, and (if it is regular)
+ * get an inverse and a solution within CHECK_MATRIX_ERROR (relative to the matrix's scale).
+ * @param matrix: a Matrix3D object.
+ * @param singular: true if the matrix must be flagged as singular.
+ * @param name: the matrix's name.
+ * @param report: records the checks.
+ */
+static void checkMatrix(Matrix3D const& matrix, const bool singular, string const& name,
+                        Report& report)
+{
+    const string where = "batch matrices over " + name;
+    const Vector3D expected(1, -2, 3);
+    const Vector3D product = matrix * expected;
+    vector<Matrix3D> matrices(CHECK_COPIES, matrix), inverses(CHECK_COPIES);
+    vector<double> x(CHECK_COPIES, product[0]), y(CHECK_COPIES, product[1]),
+                   z(CHECK_COPIES, product[2]), sx(CHECK_COPIES), sy(CHECK_COPIES), sz(CHECK_COPIES);
+    bool inverseFlags[CHECK_COPIES], solveFlags[CHECK_COPIES];
+    const size_t inverseSingulars = batchInverse(matrices.data(), CHECK_COPIES, inverses.data(),
+                                                 inverseFlags);
+    const size_t solveSingulars = batchSolve(matrices.data(), Batch3D{x.data(), y.data(), z.data(),
+                                             CHECK_COPIES}, Batch3D{sx.data(), sy.data(), sz.data(),
+                                             CHECK_COPIES}, solveFlags);
+    report.check(inverseSingulars == (singular ? CHECK_COPIES : 0) &&
+                 solveSingulars == inverseSingulars, where + ": singular count");
+    bool same = true;
+    for (size_t i = 0; i < CHECK_COPIES; ++i)
+    {
+        same = same && inverseFlags[i] == singular && solveFlags[i] == singular &&
+               equal(inverses[i].data(), inverses[i].data() + 9, inverses[0].data()) &&
+               sx[i] == sx[0] && sy[i] == sy[0] && sz[i] == sz[0];
+    }
+    report.check(same, where + ": same result at every position");
+    if (singular)
+    {
+        return;
+    }
+    const Matrix3D identity = inverses[0] * matrix;
+    bool ok = true;
+    for (unsigned short r = 0; r < 3; ++r)
+    {
+        for (unsigned short c = 0; c < 3; ++c)
+        {
+            ok = ok && fabs(identity[r][c] - (r == c ? 1 : 0)) <= CHECK_MATRIX_ERROR;
+        }
+    }
+    report.check(ok, where + ": inverse");
+    report.check(fabs(sx[0] - expected[0]) <= CHECK_MATRIX_ERROR &&
+                 fabs(sy[0] - expected[1]) <= CHECK_MATRIX_ERROR &&
+                 fabs(sz[0] - expected[2]) <= CHECK_MATRIX_ERROR, where + ": solve");
+}
+
+/**
+ * checks the matrix kernels over scaled identities, from tiny to huge (all perfectly
+ * conditioned), and over singular, near-singular and badly scaled regular matrices.
+ * @param report: records the checks.
+ */
+static void checkMatrices(Report& report)
+{
+    for (const double scale : {1e-80, 1e-60, 1e-40, 1.0, 1e40, 1e60, 1e80})
+    {
+        checkMatrix(Matrix3D(scale), false, "identity * " + to_string(log10(scale)), report);
+    }
+    // the third row is the sum of the first two, up to a relative <e> in its last entry.
+    for (const double scale : {1e-60, 1.0, 1e60})
+    {
+        for (const double e : {0.0, 1e-14, 1e-6})
+        {
+            const Matrix3D matrix(Vector3D(1, 2, 3) * scale, Vector3D(4, 5, 6) * scale,
+                                  Vector3D(5, 7, 9 * (1 + e)) * scale);
+            checkMatrix(matrix, e < 1e-12, "near singular (" + to_string(e) + ") * " +
+                        to_string(log10(scale)), report);
+        }
+    }
+    checkMatrix(Matrix3D(1, 2, 3, 0, 0, 0, 7, 8, 9), true, "zero row", report);
+    checkMatrix(Matrix3D(), true, "zero", report);
+    checkMatrix(Matrix3D(1e-30, 0, 0, 0, 1, 0, 0, 0, 1e30), false, "badly scaled rows", report);
+    checkMatrix(Matrix3D(2, 1, 0, 1, 3, 1, 0, 1, 4), false, "tridiagonal", report);
+}
+
+/**
+ * checks the KdTree and UniformGrid queries against brute force, over random, planar and
+ * degenerate point sets, and the batch matrix kernels over scaled and near-singular matrices.
+ * prints the first failures and exits with failure if there are any, otherwise prints the
+ * number of checks and exits successfully.
+ */
+int main()
+{
+    mt19937_64 rng(2019);
+    setBatchThreads(4); // builds the large sets in parallel, even on one core.
+    Report report;
+    for (PointSet& set : makeSets(rng))
+    {
+        const Batch3D points = set.batch();
+        checkIndex(KdTree(points), "KdTree", set, rng, report);
+        checkIndex(UniformGrid(points), "UniformGrid", set, rng, report);
+        checkIndex(UniformGrid(points, 0.7), "UniformGrid(0.7)", set, rng, report);
+        checkIndex(UniformGrid(points, 1e-2), "UniformGrid(0.01)", set, rng, report);
+    }
+    checkGridLimits(report);
+    checkMatrices(report);
+    if (report.failures > 0)
+    {
+        cerr << report.failures << " of " << report.checks << " checks failed" << endl;
+        exit(EXIT_FAILURE);
+    }
+    cout << "all " << report.checks << " checks passed" << endl;
+    return 0;
+}
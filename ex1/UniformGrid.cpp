@@ -0,0 +1,358 @@
+#include "UniformGrid.h"
+#include "AllocTracker.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+using namespace std;
+
+//---------------------Helpers:
+
+/**
+ * @param entry: a point's entry.
+ * @param d: 0 <= d <= 2, the entry's index.
+ * @return the coordinate of the cell that holds the entry, along entry <d> (clamped to one cell
+ *         past the occupied cells, so it never overflows).
+ */
+inline int64_t UniformGrid::_cell(const double entry, const unsigned int d) const
+{
+    const double cell = floor((entry - _origin[d]) * _inverseCellSize);
+    return (int64_t) max((double) _low[d] - 1, min((double) _high[d] + 1, cell));
+}
+
+/**
+ * @param ix: a cell's first coordinate.
+ * @param iy: the cell's second coordinate.
+ * @param iz: the cell's third coordinate.
+ * @return the cell's bucket.
+ */
+inline size_t UniformGrid::_bucket(const int64_t ix, const int64_t iy, const int64_t iz) const
+{
+    uint64_t hash = (uint64_t) ix * 0x9E3779B97F4A7C15ull ^ (uint64_t) iy * 0xC2B2AE3D27D4EB4Full ^
+                    (uint64_t) iz * 0x165667B19E3779F9ull;
+    hash ^= hash >> 29;
+    return (size_t) (hash & (_starts.size() - 2)); // the number of buckets is a power of 2.
+}
+
+/**
+ * calls <visit> with the sorted index of every point in cell (ix iy iz).
+ * @param visit: callable as visit(index).
+ */
+template <typename Visit>
+void UniformGrid::_forEachInCell(const int64_t ix, const int64_t iy, const int64_t iz,
+                                 Visit visit) const
+{
+    const size_t bucket = _bucket(ix, iy, iz);
+    for (size_t j = _starts[bucket]; j < _starts[bucket + 1]; ++j)
+    {
+        // other cells may share the bucket.
+        if (_cell(_x[j], 0) == ix && _cell(_y[j], 1) == iy && _cell(_z[j], 2) == iz)
+        {
+            visit(j);
+        }
+    }
+}
+
+//---------------------Build:
+
+/**
+ * builds a grid over <points> (in parallel, on the batch threads).
+ * throws std::invalid_argument if the cell size isn't positive, or if the points' bounds span
+ * more than GRID_MAX_AXIS_CELLS cells along an axis.
+ * @param points: the points.
+ * @param cellSize: the cells' edge length (0 for a size that holds about
+ *                  GRID_POINTS_PER_CELL points per cell, were they uniform in their bounds).
+ */
+UniformGrid::UniformGrid(Batch3D const& points, const double cellSize): _cellSize(cellSize)
+{
+    ALLOC_SCOPE("UniformGrid::UniformGrid");
+    if (!(cellSize >= 0))
+    {
+        throw invalid_argument(GRID_CELL_ERR);
+    }
+    const size_t n = points.size;
+    double low[3] = {0, 0, 0}, high[3] = {0, 0, 0};
+    for (size_t i = 0; i < n; ++i)
+    {
+        const Vector3D point = points.at(i);
+        for (unsigned int d = 0; d < 3; ++d)
+        {
+            low[d] = (i == 0) ? point[d] : min(low[d], point[d]);
+            high[d] = (i == 0) ? point[d] : max(high[d], point[d]);
+        }
+    }
+    if (_cellSize == 0)
+    {
+        // the volume (or area, or length) of the bounds, over the dimensions the points span:
+        const double extent = max(high[0] - low[0], max(high[1] - low[1], high[2] - low[2]));
+        double volume = 1;
+        unsigned int dims = 0;
+        for (unsigned int d = 0; d < 3; ++d)
+        {
+            if (high[d] - low[d] > extent * 1e-9)
+            {
+                volume *= high[d] - low[d];
+                ++dims;
+            }
+        }
+        _cellSize = (dims == 0) ? 1 : pow(volume * GRID_POINTS_PER_CELL / (double) n, 1.0 / dims);
+    }
+    _inverseCellSize = 1 / _cellSize;
+    _origin = Vector3D(low[0], low[1], low[2]);
+    if (n > 0)
+    {
+        for (unsigned int d = 0; d < 3; ++d)
+        {
+            const double cells = floor((high[d] - low[d]) * _inverseCellSize);
+            if (!(cells < GRID_MAX_AXIS_CELLS))
+            {
+                throw invalid_argument(GRID_CELLS_ERR);
+            }
+            _low[d] = 0;
+            _high[d] = (int64_t) cells;
+        }
+    }
+    size_t buckets = 1;
+    while (buckets < n)
+    {
+        buckets *= 2;
+    }
+    _starts.assign(buckets + 1, 0);
+
+    // the points' buckets (in parallel), then a counting sort by bucket:
+    vector<size_t> keys(n);
+    batchParallelFor(n, [&](const size_t begin, const size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            keys[i] = _bucket(_cell(points.x[i], 0), _cell(points.y[i], 1), _cell(points.z[i], 2));
+        }
+    });
+    for (size_t i = 0; i < n; ++i)
+    {
+        ++_starts[keys[i] + 1];
+    }
+    for (size_t b = 0; b < buckets; ++b)
+    {
+        _starts[b + 1] += _starts[b];
+    }
+    vector<size_t> next(_starts.begin(), _starts.end() - 1);
+    _ids.resize(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        _ids[next[keys[i]]++] = i;
+    }
+    _x.resize(n);
+    _y.resize(n);
+    _z.resize(n);
+    batchParallelFor(n, [&](const size_t begin, const size_t end)
+    {
+        for (size_t j = begin; j < end; ++j)
+        {
+            _x[j] = points.x[_ids[j]];
+            _y[j] = points.y[_ids[j]];
+            _z[j] = points.z[_ids[j]];
+        }
+    });
+}
+
+//---------------------Queries:
+
+/**
+ * @param query: a Vector3D object.
+ * @param k: the number of neighbours.
+ * @return the indexes of the min(k, size) points nearest to <query>, nearest first.
+ */
+vector<size_t> UniformGrid::nearest(Vector3D const& query, const size_t k) const
+{
+    ALLOC_SCOPE("UniformGrid::nearest");
+    vector<pair<double, size_t>> heap;
+    const size_t count = min(k, size());
+    heap.reserve(count);
+    int64_t center[3];
+    for (unsigned int d = 0; d < 3; ++d)
+    {
+        center[d] = max(_low[d], min(_high[d], _cell(query[d], d)));
+    }
+    auto visit = [&](const size_t j)
+    {
+        const Vector3D diff = Vector3D(_x[j], _y[j], _z[j]) - query;
+        const pair<double, size_t> candidate(diff * diff, _ids[j]);
+        if (heap.size() < count)
+        {
+            heap.push_back(candidate);
+            push_heap(heap.begin(), heap.end());
+        }
+        else if (candidate < heap.front())
+        {
+            pop_heap(heap.begin(), heap.end());
+            heap.back() = candidate;
+            push_heap(heap.begin(), heap.end());
+        }
+    };
+    // visits shells of cells around the query's cell, until the shells visited hold every cell
+    // closer than the k-th point found, or every occupied cell.
+    for (int64_t shell = 0; count > 0; ++shell)
+    {
+        int64_t from[3], to[3];
+        double cells = 1;
+        for (unsigned int d = 0; d < 3; ++d)
+        {
+            from[d] = max(_low[d], center[d] - shell);
+            to[d] = min(_high[d], center[d] + shell);
+            cells *= (double) (to[d] - from[d] + 1);
+        }
+        if (cells > (double) size()) // more cells than points: scanning the points is cheaper.
+        {
+            heap.clear();
+            for (size_t j = 0; j < size(); ++j)
+            {
+                visit(j);
+            }
+            break;
+        }
+        for (int64_t ix = from[0]; ix <= to[0]; ++ix)
+        {
+            for (int64_t iy = from[1]; iy <= to[1]; ++iy)
+            {
+                // inside the shell's cube, only the cells on its faces are new.
+                if (shell == 0 || abs(ix - center[0]) == shell || abs(iy - center[1]) == shell)
+                {
+                    for (int64_t iz = from[2]; iz <= to[2]; ++iz)
+                    {
+                        _forEachInCell(ix, iy, iz, visit);
+                    }
+                    continue;
+                }
+                if (center[2] - shell >= _low[2])
+                {
+                    _forEachInCell(ix, iy, center[2] - shell, visit);
+                }
+                if (center[2] + shell <= _high[2])
+                {
+                    _forEachInCell(ix, iy, center[2] + shell, visit);
+                }
+            }
+        }
+        bool covered = true;
+        double reach = numeric_limits<double>::infinity();
+        for (unsigned int d = 0; d < 3; ++d)
+        {
+            covered = covered && center[d] - shell <= _low[d] && center[d] + shell >= _high[d];
+            const double lowFace = _origin[d] + (double) (center[d] - shell) * _cellSize;
+            const double highFace = _origin[d] + (double) (center[d] + shell + 1) * _cellSize;
+            reach = min(reach, min(query[d] - lowFace, highFace - query[d]));
+        }
+        reach = max(reach, 0.0);
+        if (covered || (heap.size() == count && heap.front().first <= reach * reach))
+        {
+            break;
+        }
+    }
+    sort_heap(heap.begin(), heap.end());
+    vector<size_t> out;
+    out.reserve(heap.size());
+    for (const pair<double, size_t> &point : heap)
+    {
+        out.push_back(point.second);
+    }
+    return out;
+}
+
+/**
+ * @param center: a Vector3D object.
+ * @param radius: a double.
+ * @return the indexes of the points at distance <= radius from <center>, in no given order.
+ */
+vector<size_t> UniformGrid::radius(Vector3D const& center, const double radius) const
+{
+    ALLOC_SCOPE("UniformGrid::radius");
+    vector<size_t> out;
+    if (!(radius >= 0))
+    {
+        return out;
+    }
+    const double radiusSquared = radius * radius;
+    auto visit = [&](const size_t j)
+    {
+        const Vector3D diff = Vector3D(_x[j], _y[j], _z[j]) - center;
+        if (diff * diff <= radiusSquared)
+        {
+            out.push_back(_ids[j]);
+        }
+    };
+    int64_t from[3], to[3];
+    double cells = 1;
+    for (unsigned int d = 0; d < 3; ++d)
+    {
+        from[d] = max(_low[d], _cell(center[d] - radius, d));
+        to[d] = min(_high[d], _cell(center[d] + radius, d));
+        cells *= (double) max((int64_t) 0, to[d] - from[d] + 1);
+    }
+    if (cells > (double) size()) // more cells than points: scanning the points is cheaper.
+    {
+        for (size_t j = 0; j < size(); ++j)
+        {
+            visit(j);
+        }
+        return out;
+    }
+    for (int64_t ix = from[0]; ix <= to[0]; ++ix)
+    {
+        for (int64_t iy = from[1]; iy <= to[1]; ++iy)
+        {
+            for (int64_t iz = from[2]; iz <= to[2]; ++iz)
+            {
+                _forEachInCell(ix, iy, iz, visit);
+            }
+        }
+    }
+    return out;
+}
+
+/**
+ * @param low: a Vector3D object, the box's lowest corner.
+ * @param high: a Vector3D object, the box's highest corner.
+ * @return the indexes of the points in the box (borders included), in no given order.
+ */
+vector<size_t> UniformGrid::box(Vector3D const& low, Vector3D const& high) const
+{
+    ALLOC_SCOPE("UniformGrid::box");
+    vector<size_t> out;
+    auto visit = [&](const size_t j)
+    {
+        if (_x[j] >= low[0] && _x[j] <= high[0] && _y[j] >= low[1] && _y[j] <= high[1] &&
+            _z[j] >= low[2] && _z[j] <= high[2])
+        {
+            out.push_back(_ids[j]);
+        }
+    };
+    int64_t from[3], to[3];
+    double cells = 1;
+    for (unsigned int d = 0; d < 3; ++d)
+    {
+        from[d] = max(_low[d], _cell(low[d], d));
+        to[d] = min(_high[d], _cell(high[d], d));
+        cells *= (double) max((int64_t) 0, to[d] - from[d] + 1);
+    }
+    if (cells > (double) size()) // more cells than points: scanning the points is cheaper.
+    {
+        for (size_t j = 0; j < size(); ++j)
+        {
+            visit(j);
+        }
+        return out;
+    }
+    for (int64_t ix = from[0]; ix <= to[0]; ++ix)
+    {
+        for (int64_t iy = from[1]; iy <= to[1]; ++iy)
+        {
+            for (int64_t iz = from[2]; iz <= to[2]; ++iz)
+            {
+                _forEachInCell(ix, iy, iz, visit);
+            }
+        }
+    }
+    return out;
+}
@@ -0,0 +1,128 @@
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Vector3D.h"
+#include "Batch3D.h"
+
+#ifndef UNIFORMGRID_H
+#define UNIFORMGRID_H
+/** error format for a cell size that isn't positive.*/
+#define GRID_CELL_ERR "Error: the grid's cell size must be positive."
+/** error format for a cell size that splits the points' bounds into too many cells.*/
+#define GRID_CELLS_ERR "Error: the grid's cell size is too small for the points' bounds."
+/** largest number of cells along an axis (2^52: the cell coordinates stay exact as doubles).*/
+#define GRID_MAX_AXIS_CELLS 4503599627370496.0
+/** number of points per cell the default cell size aims at.*/
+#define GRID_POINTS_PER_CELL 4
+
+/**
+ * represents a uniform grid of cubic cells over a set of 3-dimensional points, hashed into a
+ * table of buckets, so only occupied cells cost memory. a radius or box query visits the cells
+ * it overlaps (constant time for a radius around the cell size); a nearest-neighbour query visits
+ * growing shells of cells. either scans the points instead once it would visit more cells than
+ * there are points. the grid holds its own copy of the points, sorted by bucket, and queries
+ * return the points' indexes in the batch the grid was built from. the grid is immutable:
+ * concurrent queries are safe.
+ */
+class UniformGrid
+{
+private:
+    /**
+     * represent the cells' edge length, and its inverse.
+     */
+    double _cellSize, _inverseCellSize = 1;
+
+    /**
+     * represents the lowest corner of cell (0 0 0).
+     */
+    Vector3D _origin;
+
+    /**
+     * represent the lowest and highest occupied cell coordinates.
+     */
+    int64_t _low[3] = {0, 0, 0}, _high[3] = {-1, -1, -1};
+
+    /**
+     * holds the index of every bucket's first point (plus the end), into the arrays below.
+     */
+    vector<size_t> _starts;
+
+    /**
+     * hold the points sorted by bucket, and their indexes in the original batch.
+     */
+    vector<double> _x, _y, _z;
+    vector<size_t> _ids;
+
+    /**
+     * @param entry: a point's entry.
+     * @param d: 0 <= d <= 2, the entry's index.
+     * @return the coordinate of the cell that holds the entry, along entry <d> (clamped to one
+     *         cell past the occupied cells, so it never overflows).
+     */
+    int64_t _cell(double entry, unsigned int d) const;
+
+    /**
+     * @param ix: a cell's first coordinate.
+     * @param iy: the cell's second coordinate.
+     * @param iz: the cell's third coordinate.
+     * @return the cell's bucket.
+     */
+    size_t _bucket(int64_t ix, int64_t iy, int64_t iz) const;
+
+    /**
+     * calls <visit> with the sorted index of every point in cell (ix iy iz).
+     * @param visit: callable as visit(index).
+     */
+    template <typename Visit>
+    void _forEachInCell(int64_t ix, int64_t iy, int64_t iz, Visit visit) const;
+
+public:
+    /**
+     * builds a grid over <points> (in parallel, on the batch threads).
+     * throws std::invalid_argument if the cell size isn't positive, or if the points' bounds span
+     * more than GRID_MAX_AXIS_CELLS cells along an axis.
+     * @param points: the points.
+     * @param cellSize: the cells' edge length (0 for a size that holds about
+     *                  GRID_POINTS_PER_CELL points per cell, were they uniform in their bounds).
+     */
+    explicit UniformGrid(Batch3D const& points, double cellSize = 0);
+
+    /**
+     * @return the number of points.
+     */
+    size_t size() const
+    {
+        return _ids.size();
+    }
+
+    /**
+     * @return the cells' edge length.
+     */
+    double cellSize() const
+    {
+        return _cellSize;
+    }
+
+    /**
+     * @param query: a Vector3D object.
+     * @param k: the number of neighbours.
+     * @return the indexes of the min(k, size) points nearest to <query>, nearest first.
+     */
+    vector<size_t> nearest(Vector3D const& query, size_t k) const;
+
+    /**
+     * @param center: a Vector3D object.
+     * @param radius: a double.
+     * @return the indexes of the points at distance <= radius from <center>, in no given order.
+     */
+    vector<size_t> radius(Vector3D const& center, double radius) const;
+
+    /**
+     * @param low: a Vector3D object, the box's lowest corner.
+     * @param high: a Vector3D object, the box's highest corner.
+     * @return the indexes of the points in the box (borders included), in no given order.
+     */
+    vector<size_t> box(Vector3D const& low, Vector3D const& high) const;
+};
+
+#endif //UNIFORMGRID_H
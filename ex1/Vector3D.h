@@ -1,210 +1,390 @@
-using namespace std;
-#include <iostream>
-#include <vector>
-#include <cmath>
-
-#ifndef VECTOR3D_H
-#define VECTOR3D_H
-
-/** error format for division by zero.*/
-#define DIVISION_BY_ZERO "Error: attempted division by zero."
-/** represents pi*/
-#define PI 3.14
-
-/** class representing a 3-dimensional vector.*/
-class Vector3D
-{
-
-private:
-    /**
-     * holds the vector
-     */
-    vector<double> *_vector;
-
-public:
-    //--------------------constructors:
-    /**
-     * default constructor: construct a new vector of size 3 initialized to 0.
-     */
-    Vector3D():Vector3D(0, 0, 0){}
-
-    /**
-     * construct a new vector of size 3, that is: (a b c).
-     * @param a: double representing the vector's first entry.
-     * @param b: double representing the vector's second entry.
-     * @param c: double representing the vector's third entry.
-     */
-    Vector3D(const double a, const double b, const double c): _vector(new vector<double> {a, b, c}){}
-
-    /**
-     * construct a new vector from <arr>.
-     * @param arr: array of 3 doubles, holding the vector's entries.
-     */
-    explicit Vector3D(const double arr[3]): Vector3D(arr[0], arr[1], arr[2]){}
-
-    /**
-     * copy constructor: creates a new Vector3D object, with identical entries to <other>'s entries.
-     * @param other: Vector3D object.
-     */
-    Vector3D(const Vector3D& other):Vector3D(other[0], other[1], other[2]){}
-
-
-    //---------------------destructor:
-
-    /**
-     * deletes this Vector3D object (frees memory).
-     */
-    ~Vector3D()
-    {
-        delete _vector;
-    }
-
-
-    //---------------------Methods:
-
-    /**
-     * @param other: a Vector3D object.
-     * @return the distance between the other Vector3D object, and this Vector3D object.
-     */
-    double dist(Vector3D const& other) const;
-
-    /**
-     * @return the norm of this Vector3D Object.
-     */
-    double norm() const;
-
-    //---------------------Operators:
-
-    /**
-     * subtract the <second> Vector3D object from the <first> Vector3D object.
-     * @param first: a Vector3D object.
-     * @param second: a Vector3D object.
-     * @return : a new Vector3D object, that holds the subtraction result.
-     */
-    friend Vector3D operator-(Vector3D const& first, Vector3D const& second);
-
-    /**
-     * adds the <second> Vector3D object to the <first> Vector3D object.
-     * @param first: a Vector3D object.
-     * @param second: a Vector3D object.
-     * @return : a new Vector3D object, that holds the addition result.
-     */
-    friend Vector3D operator+(Vector3D const& first, Vector3D const& second);
-
-    /**
-     * updates this Vector3D object: adds the <other> Vector3D object to it.
-     * @param other: a Vector3D object.
-     * @return a reference to this object.
-     */
-    Vector3D& operator+= (Vector3D const& other);
-
-    /**
-      * updates this Vector3D object: subtracts the <other> Vector3D object from it.
-      * @param other: a Vector3D object.
-      * @return a reference to this object.
-      */
-    Vector3D& operator-= (Vector3D const& other);
-
-    /**
-     * updates this Vector3D object to represent it's additive inverse.
-     * @return: a reference to the object.
-     */
-    Vector3D& operator-();
-
-    /**
-     * multiplies the <vec> Vector3D object by the <first> Vector3D object.
-     * @param vec: a Vector3D object.
-     * @param val: a double.
-     * @return : a new Vector3D object, that holds the product.
-     */
-    friend Vector3D operator*(Vector3D const& vec, double val);
-
-    /**
-     * divides the <vec> Vector3D object by <val>. if val = 0: prints an error.
-     * @param vec: a Vector3D object.
-     * @param val: a double.
-     * @return : a new Vector3D object, that holds the quotient.
-     */
-    friend Vector3D operator/(Vector3D const& vec, double val);
-
-    /**
-     * multiplies the <vec> Vector3D object by the <first> Vector3D object.
-     * @param val: a double.
-     * @param vec: a Vector3D object.
-     * @return : a new Vector3D object, that holds the product.
-     */
-    friend Vector3D operator*(double val, Vector3D const& vec);
-
-    /**
-     * updates this Vector3D object: multiply it by <val>.
-     * @param val: a double.
-     * @return a reference to this object.
-     */
-    Vector3D& operator*=(double val);
-
-    /**
-     * updates this Vector3D object: divide it by <val>. if val = 0: prints an error.
-     * @param val: a double.
-     * @return a reference to this object.
-     */
-    Vector3D& operator/=(double val);
-
-    /**
-     * @param v1: Vector2D object.
-     * @param v2: Vector2D object.
-     * @return the distance between the 2 objects.
-     */
-    friend double operator|(Vector3D const& v1, Vector3D const& v2);
-
-    /**
-     * @param v1: Vector2D object.
-     * @param v2: Vector2D object.
-     * @return: the scalar product of the two objects.
-     */
-    friend double operator*(Vector3D const& v1, Vector3D const& v2);
-
-    /**
-     * @param v1: Vector2D object.
-     * @param v2: Vector2D object.
-     * @return the angle between <v1> and <v2> in radians.
-     */
-    friend double operator^(Vector3D const& v1, Vector3D const& v2);
-
-    /**
-     * reads the vector at the format: "vec[0] vec[1] vec[2]", from <is> to <vec>.
-     * @param is: a out stream object.
-     * @param vec: a Vector3D object.
-     * @return the <is>. (to allow concatenating).
-     */
-    friend istream& operator>>(istream& is, Vector3D& vec);
-
-    /**
-     * prints the vector at the format: "vec[0] vec[1] vec[2]" and \n, to <os>.
-     * @param os: a out stream object.
-     * @param vec: a Vector3D object.
-     * @return the <os>. (to allow concatenating).
-     */
-    friend ostream& operator<<(ostream& os, Vector3D const& vec);
-
-    /**
-     * assign this Vector3D with <other>'s attributes.
-     * @param other : Vector3D object.
-     * @return this vector, after the assignment.
-     */
-    Vector3D& operator=(const Vector3D& other);
-
-    /**
-     * for modifying the Vector3D at <index>.
-     * @param index: represents an index in a Vector3D.
-     * @return the double at <index> place in this object.
-     */
-    double& operator[](unsigned int index);
-
-    /**
-     * for accessing the Vector3D at <index>.
-     * @param index: represents an index in a Vector3D.
-     * @return the double at <index> place in this object.
-     */
-    double operator[](unsigned int index) const;
-};
-#endif //VECTOR3D_H
\ No newline at end of file
+using namespace std;
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+#include <cmath>
+
+#ifndef VECTOR3D_H
+#define VECTOR3D_H
+
+/** error format for division by zero.*/
+#define DIVISION_BY_ZERO "Error: attempted division by zero."
+/** error format for an index out of the vector's range.*/
+#define VECTOR_INDEX_ERR "Error: Vector3D index out of range."
+/** represents pi*/
+#define PI 3.14
+
+/**
+ * class representing a 3-dimensional vector.
+ * the entries are held inline, so a Vector3D is a trivially copyable 24-byte value: constructing,
+ * copying and destroying one never touches the allocator.
+ */
+class Vector3D
+{
+
+private:
+    /**
+     * holds the vector's entries.
+     */
+    double _coords[3];
+
+public:
+    //--------------------constructors:
+    /**
+     * default constructor: construct a new vector of size 3 initialized to 0.
+     */
+    constexpr Vector3D():Vector3D(0, 0, 0){}
+
+    /**
+     * construct a new vector of size 3, that is: (a b c).
+     * @param a: double representing the vector's first entry.
+     * @param b: double representing the vector's second entry.
+     * @param c: double representing the vector's third entry.
+     */
+    constexpr Vector3D(const double a, const double b, const double c): _coords{a, b, c}{}
+
+    /**
+     * construct a new vector from <arr>.
+     * @param arr: array of 3 doubles, holding the vector's entries.
+     */
+    constexpr explicit Vector3D(const double arr[3]): Vector3D(arr[0], arr[1], arr[2]){}
+
+    /**
+     * copy constructor: creates a new Vector3D object, with identical entries to <other>'s entries.
+     * @param other: Vector3D object.
+     */
+    constexpr Vector3D(const Vector3D& other) = default;
+
+    /**
+     * move constructor: same as copying (the entries are held inline).
+     * @param other: Vector3D object.
+     */
+    constexpr Vector3D(Vector3D&& other) = default;
+
+
+    //---------------------destructor:
+
+    /**
+     * deletes this Vector3D object (nothing to free).
+     */
+    ~Vector3D() = default;
+
+
+    //---------------------Methods:
+
+    /**
+     * @param other: a Vector3D object.
+     * @return the distance between the other Vector3D object, and this Vector3D object.
+     */
+    double dist(Vector3D const& other) const;
+
+    /**
+     * @return the norm of this Vector3D Object.
+     */
+    double norm() const;
+
+    /**
+     * @return a pointer to the vector's 3 contiguous entries.
+     */
+    constexpr const double* data() const
+    {
+        return _coords;
+    }
+
+    /**
+     * @return a pointer to the vector's 3 contiguous entries.
+     */
+    constexpr double* data()
+    {
+        return _coords;
+    }
+
+    //---------------------Operators:
+
+    /**
+     * subtract the <second> Vector3D object from the <first> Vector3D object.
+     * @param first: a Vector3D object.
+     * @param second: a Vector3D object.
+     * @return : a new Vector3D object, that holds the subtraction result.
+     */
+    friend constexpr Vector3D operator-(Vector3D const& first, Vector3D const& second);
+
+    /**
+     * adds the <second> Vector3D object to the <first> Vector3D object.
+     * @param first: a Vector3D object.
+     * @param second: a Vector3D object.
+     * @return : a new Vector3D object, that holds the addition result.
+     */
+    friend constexpr Vector3D operator+(Vector3D const& first, Vector3D const& second);
+
+    /**
+     * updates this Vector3D object: adds the <other> Vector3D object to it.
+     * @param other: a Vector3D object.
+     * @return a reference to this object.
+     */
+    constexpr Vector3D& operator+= (Vector3D const& other);
+
+    /**
+      * updates this Vector3D object: subtracts the <other> Vector3D object from it.
+      * @param other: a Vector3D object.
+      * @return a reference to this object.
+      */
+    constexpr Vector3D& operator-= (Vector3D const& other);
+
+    /**
+     * updates this Vector3D object to represent it's additive inverse.
+     * @return: a reference to the object.
+     */
+    constexpr Vector3D& operator-();
+
+    /**
+     * multiplies the <vec> Vector3D object by the <first> Vector3D object.
+     * @param vec: a Vector3D object.
+     * @param val: a double.
+     * @return : a new Vector3D object, that holds the product.
+     */
+    friend constexpr Vector3D operator*(Vector3D const& vec, double val);
+
+    /**
+     * divides the <vec> Vector3D object by <val>. if val = 0: prints an error.
+     * @param vec: a Vector3D object.
+     * @param val: a double.
+     * @return : a new Vector3D object, that holds the quotient.
+     */
+    friend constexpr Vector3D operator/(Vector3D const& vec, double val);
+
+    /**
+     * multiplies the <vec> Vector3D object by the <first> Vector3D object.
+     * @param val: a double.
+     * @param vec: a Vector3D object.
+     * @return : a new Vector3D object, that holds the product.
+     */
+    friend constexpr Vector3D operator*(double val, Vector3D const& vec);
+
+    /**
+     * updates this Vector3D object: multiply it by <val>.
+     * @param val: a double.
+     * @return a reference to this object.
+     */
+    constexpr Vector3D& operator*=(double val);
+
+    /**
+     * updates this Vector3D object: divide it by <val>. if val = 0: prints an error.
+     * @param val: a double.
+     * @return a reference to this object.
+     */
+    Vector3D& operator/=(double val);
+
+    /**
+     * @param v1: Vector2D object.
+     * @param v2: Vector2D object.
+     * @return the distance between the 2 objects.
+     */
+    friend double operator|(Vector3D const& v1, Vector3D const& v2);
+
+    /**
+     * @param v1: Vector2D object.
+     * @param v2: Vector2D object.
+     * @return: the scalar product of the two objects.
+     */
+    friend constexpr double operator*(Vector3D const& v1, Vector3D const& v2);
+
+    /**
+     * @param v1: Vector2D object.
+     * @param v2: Vector2D object.
+     * @return the angle between <v1> and <v2> in radians.
+     */
+    friend double operator^(Vector3D const& v1, Vector3D const& v2);
+
+    /**
+     * @param v1: Vector3D object.
+     * @param v2: Vector3D object.
+     * @return : a new Vector3D object, that holds the cross product v1 x v2.
+     */
+    friend constexpr Vector3D cross(Vector3D const& v1, Vector3D const& v2);
+
+    /**
+     * reads the vector at the format: "vec[0] vec[1] vec[2]", from <is> to <vec>.
+     * @param is: a out stream object.
+     * @param vec: a Vector3D object.
+     * @return the <is>. (to allow concatenating).
+     */
+    friend istream& operator>>(istream& is, Vector3D& vec);
+
+    /**
+     * prints the vector at the format: "vec[0] vec[1] vec[2]" and \n, to <os>.
+     * @param os: a out stream object.
+     * @param vec: a Vector3D object.
+     * @return the <os>. (to allow concatenating).
+     */
+    friend ostream& operator<<(ostream& os, Vector3D const& vec);
+
+    /**
+     * assign this Vector3D with <other>'s attributes.
+     * @param other : Vector3D object.
+     * @return this vector, after the assignment.
+     */
+    constexpr Vector3D& operator=(const Vector3D& other) = default;
+
+    /**
+     * move assignment: same as copying (the entries are held inline).
+     * @param other : Vector3D object.
+     * @return this vector, after the assignment.
+     */
+    constexpr Vector3D& operator=(Vector3D&& other) = default;
+
+    /**
+     * for modifying the Vector3D at <index>. throws std::out_of_range if index > 2.
+     * @param index: represents an index in a Vector3D.
+     * @return the double at <index> place in this object.
+     */
+    constexpr double& operator[](unsigned int index)
+    {
+        return index < 3 ? _coords[index] : throw out_of_range(VECTOR_INDEX_ERR);
+    }
+
+    /**
+     * for accessing the Vector3D at <index>. throws std::out_of_range if index > 2.
+     * @param index: represents an index in a Vector3D.
+     * @return the double at <index> place in this object.
+     */
+    constexpr double operator[](unsigned int index) const
+    {
+        return index < 3 ? _coords[index] : throw out_of_range(VECTOR_INDEX_ERR);
+    }
+};
+
+static_assert(is_trivially_copyable<Vector3D>::value, "Vector3D must stay trivially copyable");
+static_assert(sizeof(Vector3D) == 3 * sizeof(double), "Vector3D must stay 3 packed doubles");
+
+//---------------------Inline operators:
+
+/**
+ * subtract the <second> Vector3D object from the <first> Vector3D object.
+ * @param first: a Vector3D object.
+ * @param second: a Vector3D object.
+ * @return : a new Vector3D object, that holds the subtraction result.
+ */
+constexpr Vector3D operator-(Vector3D const& first, Vector3D const& second)
+{
+    return Vector3D(first._coords[0] - second._coords[0], first._coords[1] - second._coords[1],
+                    first._coords[2] - second._coords[2]);
+}
+
+/**
+ * adds the <second> Vector3D object to the <first> Vector3D object.
+ * @param first: a Vector3D object.
+ * @param second: a Vector3D object.
+ * @return : a new Vector3D object, that holds the addition result.
+ */
+constexpr Vector3D operator+(Vector3D const& first, Vector3D const& second)
+{
+    return Vector3D(first._coords[0] + second._coords[0], first._coords[1] + second._coords[1],
+                    first._coords[2] + second._coords[2]);
+}
+
+/**
+ * updates this Vector3D object: adds the <other> Vector3D object to it.
+ * @param other: a Vector3D object.
+ * @return a reference to this object.
+ */
+constexpr Vector3D& Vector3D::operator+= (Vector3D const& other)
+{
+    _coords[0] += other._coords[0];
+    _coords[1] += other._coords[1];
+    _coords[2] += other._coords[2];
+    return *this;
+}
+
+/**
+ * updates this Vector3D object: subtracts the <other> Vector3D object from it.
+ * @param other: a Vector3D object.
+ * @return a reference to this object.
+ */
+constexpr Vector3D& Vector3D::operator-= (Vector3D const& other)
+{
+    _coords[0] -= other._coords[0];
+    _coords[1] -= other._coords[1];
+    _coords[2] -= other._coords[2];
+    return *this;
+}
+
+/**
+ * updates this Vector3D object to represent it's additive inverse.
+ * @return: a reference to the object.
+ */
+constexpr Vector3D& Vector3D::operator-()
+{
+    return (*this) *= -1;
+}
+
+/**
+ * multiplies the <vec> Vector3D object by the <first> Vector3D object.
+ * @param vec: a Vector3D object.
+ * @param val: a double.
+ * @return : a new Vector3D object, that holds the product.
+ */
+constexpr Vector3D operator*(Vector3D const& vec, const double val)
+{
+    return Vector3D(vec._coords[0] * val, vec._coords[1] * val, vec._coords[2] * val);
+}
+
+/**
+ * divides the <vec> Vector3D object by <val>. if val = 0: prints an error.
+ * @param vec: a Vector3D object.
+ * @param val: a double.
+ * @return : a new Vector3D object, that holds the quotient.
+ */
+constexpr Vector3D operator/(Vector3D const& vec, const double val)
+{
+    return Vector3D(vec._coords[0] / val, vec._coords[1] / val, vec._coords[2] / val);
+}
+
+/**
+ * multiplies the <vec> Vector3D object by the <first> Vector3D object.
+ * @param val: a double.
+ * @param vec: a Vector3D object.
+ * @return : a new Vector3D object, that holds the product.
+ */
+constexpr Vector3D operator*(const double val, Vector3D const& vec)
+{
+    return vec * val;
+}
+
+/**
+ * updates this Vector3D object: multiply it by <val>.
+ * @param val: a double.
+ * @return a reference to this object.
+ */
+constexpr Vector3D& Vector3D::operator*=(const double val)
+{
+    _coords[0] *= val;
+    _coords[1] *= val;
+    _coords[2] *= val;
+    return *this;
+}
+
+/**
+ * @param v1: Vector2D object.
+ * @param v2: Vector2D object.
+ * @return: the scalar product of the two objects.
+ */
+constexpr double operator*(Vector3D const& v1, Vector3D const& v2)
+{
+    return v1._coords[0] * v2._coords[0] + v1._coords[1] * v2._coords[1] +
+           v1._coords[2] * v2._coords[2];
+}
+
+/**
+ * @param v1: Vector3D object.
+ * @param v2: Vector3D object.
+ * @return : a new Vector3D object, that holds the cross product v1 x v2.
+ */
+constexpr Vector3D cross(Vector3D const& v1, Vector3D const& v2)
+{
+    return Vector3D(v1._coords[1] * v2._coords[2] - v1._coords[2] * v2._coords[1],
+                    v1._coords[2] * v2._coords[0] - v1._coords[0] * v2._coords[2],
+                    v1._coords[0] * v2._coords[1] - v1._coords[1] * v2._coords[0]);
+}
+
+#endif //VECTOR3D_H
@@ -1,5 +1,8 @@
 #include "Vector3D.h"
 #include "Matrix3D.h"
+// with ALLOC_TRACKING, counts every heap allocation of the program.
+#define ALLOC_TRACK_GLOBAL_NEW
+#include "AllocTracker.hpp"
 
 #include <iostream>
 
@@ -16,5 +19,9 @@ int main()
   std::cout << "Matrix m = \n" << m << std::endl;
   std::cout << "m.determinant = " << m.determinant() << std::endl;
   std::cout << "m*a = " << m*a << std::endl;
+  if (AllocTracker::enabled())
+  {
+    AllocTracker::print(std::cerr);
+  }
   return 0;
 }
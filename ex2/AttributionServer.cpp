@@ -0,0 +1,254 @@
+//
+// Created by baraloni, ex2 cpp 2018-19 winter semester.
+// contains the long-running (daemon) mode of find_the_author.
+//
+
+#include "AttributionServer.h"
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+//---------------------Helpers:
+
+/**
+ * reads a non-negative decimal number (a flag's value, or a request's <k>).
+ * @param value: the number's text.
+ * @param n: receives the number.
+ * @return true if the value is a number and nothing else.
+ */
+bool parseCount(const char *value, size_t &n)
+{
+    if (*value < '0' || *value > '9')
+    {
+        return false;
+    }
+    char *end = nullptr;
+    errno = 0;
+    const unsigned long parsed = std::strtoul(value, &end, 10);
+    if (*end != '\0' || errno == ERANGE)
+    {
+        return false;
+    }
+    n = parsed;
+    return true;
+}
+
+/**
+ * writes all of <data> to <fd>.
+ * @param fd: connected socket.
+ * @param data: the bytes to write.
+ * @return false if the peer went away.
+ */
+static bool sendAll(const int fd, const std::string &data)
+{
+    size_t sent = 0;
+    while (sent < data.size())
+    {
+        ssize_t n = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0)
+        {
+            return false;
+        }
+        sent += n;
+    }
+    return true;
+}
+
+/**
+ * answers the request lines read from the connection <fd>, until the peer closes it (or sends a
+ * line longer than SERVER_MAX_LINE).
+ * @param server: the server answering.
+ * @param fd: connected socket (closed at the end).
+ */
+static void serveConnection(AttributionServer *server, const int fd)
+{
+    std::string pending;
+    char buffer[4096];
+    ssize_t n;
+    while ((n = recv(fd, buffer, sizeof(buffer), 0)) > 0)
+    {
+        pending.append(buffer, n);
+        size_t lineEnd;
+        while ((lineEnd = pending.find('\n')) != std::string::npos)
+        {
+            std::string request = pending.substr(0, lineEnd);
+            pending.erase(0, lineEnd + 1);
+            if (!sendAll(fd, server->answer(request)))
+            {
+                close(fd);
+                return;
+            }
+        }
+        if (pending.size() > SERVER_MAX_LINE)
+        {
+            sendAll(fd, std::string("error ") + QUERY_LINE_ERR + "\n\n");
+            break;
+        }
+    }
+    close(fd);
+}
+
+//---------------------Methods:
+
+/**
+ * @param request: a request line.
+ * @return the answer (safe to call concurrently).
+ */
+std::string AttributionServer::answer(const std::string &request)
+{
+    auto start = std::chrono::steady_clock::now();
+    std::string line = request;
+    if (!line.empty() && line.back() == '\r')
+    {
+        line.pop_back();
+    }
+    std::ostringstream out;
+    std::string path = line;
+    size_t k = _k;
+    size_t tab = line.find('\t');
+    if (tab != std::string::npos)
+    {
+        path = line.substr(0, tab);
+        if (!parseCount(line.c_str() + tab + 1, k))
+        {
+            out << "error " << QUERY_K_ERR << "\n\n";
+            return out.str();
+        }
+    }
+
+    MappedFile unknownFile(path);
+    if (!unknownFile)
+    {
+        out << "error " << QUERY_FIO_ERR << "\n\n";
+        return out.str();
+    }
+    const std::vector<AuthorMatch> matches = _detector.rank(unknownFile, k, _approx);
+    for (size_t i = 0; i < matches.size(); ++i)
+    {
+        out << i + 1 << " " << matches[i].name << " " << matches[i].score << "\n";
+    }
+    std::chrono::duration<double, std::milli> latency = std::chrono::steady_clock::now() - start;
+    out << "latency_ms " << latency.count() << "\n\n";
+    ++_served;
+    return out.str();
+}
+
+/**
+ * answers the requests in <in> one by one, until it ends.
+ * @param in: stream of request lines.
+ * @param out: receives the answers.
+ */
+void AttributionServer::serve(std::istream &in, std::ostream &out)
+{
+    std::string request;
+    while (getline(in, request))
+    {
+        if (!request.empty())
+        {
+            out << answer(request) << std::flush;
+        }
+    }
+}
+
+/**
+ * listens on a unix domain socket at <path>, and answers the connections on a pool of
+ * SERVER_WORKERS threads (joined before returning). returns only on error.
+ * @param path: the socket's path (a stale socket there is replaced; any other file is left
+ * alone, and fails).
+ * @return false.
+ */
+bool AttributionServer::serveSocket(const std::string &path)
+{
+    sockaddr_un address{};
+    if (path.size() >= sizeof(address.sun_path))
+    {
+        return false;
+    }
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0)
+    {
+        return false;
+    }
+    struct stat existing{};
+    if (lstat(path.c_str(), &existing) == 0)
+    {
+        if (!S_ISSOCK(existing.st_mode))
+        {
+            std::cerr << SOCKET_PATH_ERR << std::endl;
+            close(listener);
+            return false;
+        }
+        unlink(path.c_str());
+    }
+    if (bind(listener, (sockaddr *) &address, sizeof(address)) < 0 || listen(listener, SOMAXCONN) < 0)
+    {
+        close(listener);
+        return false;
+    }
+
+    // the accepted connections wait in <pending> for a worker; accepting pauses while it's full.
+    std::deque<int> pending;
+    bool stopping = false;
+    std::mutex lock;
+    std::condition_variable changed;
+    std::vector<std::thread> workers;
+    for (unsigned int w = 0; w < SERVER_WORKERS; ++w)
+    {
+        workers.emplace_back([&]()
+        {
+            while (true)
+            {
+                int fd;
+                {
+                    std::unique_lock<std::mutex> guard(lock);
+                    changed.wait(guard, [&]() {return stopping || !pending.empty();});
+                    if (pending.empty())
+                    {
+                        return;
+                    }
+                    fd = pending.front();
+                    pending.pop_front();
+                }
+                changed.notify_all();
+                serveConnection(this, fd);
+            }
+        });
+    }
+    int connection;
+    while ((connection = accept(listener, nullptr, nullptr)) >= 0 || errno == EINTR)
+    {
+        if (connection >= 0)
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            changed.wait(guard, [&]() {return pending.size() < SERVER_MAX_PENDING;});
+            pending.push_back(connection);
+            guard.unlock();
+            changed.notify_all();
+        }
+    }
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    changed.notify_all();
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+    close(listener);
+    return false;
+}
@@ -0,0 +1,106 @@
+//
+// Created by baraloni, ex2 cpp 2018-19 winter semester.
+// contains the long-running (daemon) mode of find_the_author.
+//
+
+#ifndef EX2_ATTRIBUTIONSERVER_H
+#define EX2_ATTRIBUTIONSERVER_H
+
+#include <atomic>
+#include <iostream>
+#include <string>
+#include "FrequenciesDetector.h"
+
+/**
+ * reads a non-negative decimal number (a flag's value, or a request's <k>).
+ * @param value: the number's text.
+ * @param n: receives the number.
+ * @return true if the value is a number and nothing else.
+ */
+bool parseCount(const char *value, size_t &n);
+
+#define QUERY_FIO_ERR "Error: could not open or read the unknown text."
+#define SOCKET_ERR "Error: could not listen on the supplied socket."
+#define SOCKET_PATH_ERR "Error: the socket's path exists and is not a socket."
+#define QUERY_K_ERR "Error: the requested number of authors is not a number."
+#define QUERY_LINE_ERR "Error: the request line is too long."
+/** longest request line a connection may send (it is dropped past it).*/
+#define SERVER_MAX_LINE 65536
+/** number of threads answering the socket's connections.*/
+#define SERVER_WORKERS 8
+/** number of accepted connections waiting for a thread (more wait in the listen backlog).*/
+#define SERVER_MAX_PENDING 64
+
+/**
+ * answers attribution queries against a detector whose frequent words and authors were loaded
+ * once, up front.
+ *
+ * protocol (one request per line): "<unknown.txt>" or "<unknown.txt>\t<k>".
+ * every request is answered by its <k> closest authors, one per line at the format
+ * "<rank> <fName> <distance>", then "latency_ms <ms>" and an empty line.
+ * a request whose file can't be read, or whose <k> isn't a number, is answered by "error <msg>"
+ * and an empty line. a connection that sends a line longer than SERVER_MAX_LINE is answered the
+ * same way, then dropped.
+ */
+class AttributionServer
+{
+private:
+    /**
+     * holds the frequent words and the authors (only read from, so shared by all the requests).
+     */
+    const FrequenciesDetector &_detector;
+
+    /**
+     * represents the number of authors returned by default.
+     */
+    size_t _k;
+
+    /**
+     * true to use the detector's approximate search tables.
+     */
+    bool _approx;
+
+    /**
+     * counts the requests answered so far.
+     */
+    std::atomic<unsigned long> _served{0};
+
+public:
+    /**
+     * constructs a new server.
+     * @param detector: detector holding the frequent words and the authors.
+     * @param k: number of authors returned by default.
+     * @param approx: true to use the detector's approximate search tables.
+     */
+    AttributionServer(const FrequenciesDetector &detector, size_t k, bool approx):
+        _detector(detector), _k(k), _approx(approx) {}
+
+    /**
+     * @param request: a request line.
+     * @return the answer (safe to call concurrently).
+     */
+    std::string answer(const std::string &request);
+
+    /**
+     * answers the requests in <in> one by one, until it ends.
+     * @param in: stream of request lines.
+     * @param out: receives the answers.
+     */
+    void serve(std::istream &in, std::ostream &out);
+
+    /**
+     * listens on a unix domain socket at <path>, and answers the connections on a pool of
+     * SERVER_WORKERS threads (joined before returning). returns only on error.
+     * @param path: the socket's path (a stale socket there is replaced; any other file is left
+     * alone, and fails).
+     * @return false.
+     */
+    bool serveSocket(const std::string &path);
+
+    /**
+     * @return the number of requests answered so far.
+     */
+    inline unsigned long served() const {return _served;}
+};
+
+#endif //EX2_ATTRIBUTIONSERVER_H
@@ -0,0 +1,264 @@
+//
+// Created by baraloni, ex2 cpp 2018-19 winter semester.
+// contains the index of author profiles searched by find_the_author.
+//
+
+#include "AuthorIndex.h"
+#include <algorithm>
+#include <queue>
+#include <random>
+#include <unordered_set>
+
+//---------------------Helpers:
+
+/**
+ * @param v: vector of length _profiles.stride().
+ * @param norm: <v>'s norm.
+ * @param table: table index.
+ * @return the signature of <v> in <table>.
+ */
+uint64_t AuthorIndex::_signature(const double *v, const double norm, const size_t table) const
+{
+    const size_t stride = _profiles.stride();
+    const double *plane = _planes.data() + table * _bits * stride;
+    const double *offset = _offsets.data() + table * _bits;
+    uint64_t signature = 0;
+    for (unsigned int b = 0; b < _bits; ++b, plane += stride)
+    {
+        double projection = 0;
+        for (size_t i = 0; i < stride; ++i)
+        {
+            projection += plane[i] * v[i];
+        }
+        signature = (signature << 1u) | (projection >= offset[b] * norm ? 1u : 0u);
+    }
+    return signature;
+}
+
+/**
+ * @param a: author index.
+ * @param aScore: <a>'s score.
+ * @param b: author index.
+ * @param bScore: <b>'s score.
+ * @return true if <a> ranks before <b>: higher score, then smaller name, then earlier index.
+ */
+bool AuthorIndex::_ranksBefore(const size_t a, const double aScore,
+                               const size_t b, const double bScore) const
+{
+    if (aScore != bScore)
+    {
+        return aScore > bScore;
+    }
+    int byName = _names[a].compare(_names[b]);
+    return byName != 0 ? byName < 0 : a < b;
+}
+
+/**
+ * keeps the <k> best of the supplied candidates in a bounded heap (its top is the worst
+ * match kept so far, so every candidate costs at most O(log k)).
+ * @param ids: candidate indexes.
+ * @param scores: their scores.
+ * @param k: number of matches to keep.
+ * @return the best <k> matches, best first.
+ */
+std::vector<AuthorMatch> AuthorIndex::_best(const std::vector<size_t> &ids,
+                                            const std::vector<double> &scores,
+                                            const size_t k) const
+{
+    typedef std::pair<double, size_t> Scored;
+    auto cmp = [this](const Scored &p1, const Scored &p2)
+    {
+        return _ranksBefore(p1.second, p1.first, p2.second, p2.first);
+    };
+    std::priority_queue<Scored, std::vector<Scored>, decltype(cmp)> heap(cmp);
+    for (size_t i = 0; i < ids.size() && k > 0; ++i)
+    {
+        if (heap.size() < k)
+        {
+            heap.emplace(scores[i], ids[i]);
+        }
+        else if (_ranksBefore(ids[i], scores[i], heap.top().second, heap.top().first))
+        {
+            heap.pop();
+            heap.emplace(scores[i], ids[i]);
+        }
+    }
+    std::vector<AuthorMatch> best(heap.size());
+    for (size_t i = best.size(); i > 0; --i)
+    {
+        best[i - 1] = AuthorMatch{_names[heap.top().second], heap.top().second, heap.top().first};
+        heap.pop();
+    }
+    return best;
+}
+
+//---------------------Methods:
+
+/**
+ * adds an author to the index (and to the LSH tables, if they were built).
+ * @param name: the author's name.
+ * @param freq: the author's frequency vector.
+ * @return the author's index.
+ */
+size_t AuthorIndex::add(const std::string &name, const std::vector<int> &freq)
+{
+    size_t id = _profiles.addRow(freq);
+    _names.push_back(name);
+    for (size_t t = 0; t < _buckets.size(); ++t)
+    {
+        _buckets[t][_signature(_profiles.row(id), _profiles.norm(id), t)].push_back(id);
+    }
+    return id;
+}
+
+/**
+ * scores every author against <query>.
+ * @param query: kernel holding the query.
+ * @param k: number of matches to return.
+ * @return the <k> best matching authors, best first.
+ */
+std::vector<AuthorMatch> AuthorIndex::topK(const CosineKernel &query, const size_t k) const
+{
+    std::vector<double> scores;
+    query.scoreAll(_profiles, scores);
+    return topK(scores, k);
+}
+
+/**
+ * ranks the authors by precomputed scores.
+ * @param scores: the score of author i at scores[i] (one per author).
+ * @param k: number of matches to return.
+ * @return the <k> best matching authors, best first.
+ */
+std::vector<AuthorMatch> AuthorIndex::topK(const std::vector<double> &scores, const size_t k) const
+{
+    std::vector<size_t> ids(scores.size());
+    for (size_t i = 0; i < ids.size(); ++i)
+    {
+        ids[i] = i;
+    }
+    return _best(ids, scores, k);
+}
+
+/**
+ * (re)builds the LSH tables over all the authors in the index.
+ * @param tables: number of hash tables (0 drops the tables: the searches are then exact).
+ * @param bits: number of bits in a signature (1 to 64).
+ * @param seed: seed of the random hyperplanes.
+ */
+void AuthorIndex::buildLsh(const unsigned int tables, const unsigned int bits,
+                           const unsigned int seed)
+{
+    _bits = (tables == 0) ? 0 : std::max(1u, std::min(bits, 64u));
+    const size_t stride = _profiles.stride();
+    std::mt19937 generator(seed);
+    std::normal_distribution<double> gaussian(0.0, 1.0);
+    _planes.assign(tables * _bits * stride, 0.0);
+    for (size_t t = 0; t < tables; ++t)
+    {
+        for (size_t b = 0; b < _bits; ++b)
+        {
+            double *plane = _planes.data() + (t * _bits + b) * stride;
+            for (size_t i = 0; i < _profiles.cols(); ++i)
+            {
+                plane[i] = gaussian(generator);
+            }
+        }
+    }
+    std::vector<double> mean(stride, 0.0);
+    for (size_t id = 0; id < size(); ++id)
+    {
+        const double *row = _profiles.row(id);
+        for (size_t i = 0; _profiles.norm(id) != 0 && i < stride; ++i)
+        {
+            mean[i] += row[i] / _profiles.norm(id) / size();
+        }
+    }
+    _offsets.assign(tables * _bits, 0.0);
+    for (size_t p = 0; p < _offsets.size(); ++p)
+    {
+        const double *plane = _planes.data() + p * stride;
+        for (size_t i = 0; i < stride; ++i)
+        {
+            _offsets[p] += plane[i] * mean[i];
+        }
+    }
+    _buckets.assign(tables, std::unordered_map<uint64_t, std::vector<size_t>>());
+    for (size_t id = 0; id < size(); ++id)
+    {
+        for (size_t t = 0; t < tables; ++t)
+        {
+            _buckets[t][_signature(_profiles.row(id), _profiles.norm(id), t)].push_back(id);
+        }
+    }
+}
+
+/**
+ * scores only the authors that share a bucket with <query>, or a bucket one bit away from it.
+ * falls back to exact search if the LSH tables were not built.
+ * @param query: kernel holding the query.
+ * @param k: number of matches to return.
+ * @return (up to) <k> matching authors, best first.
+ */
+std::vector<AuthorMatch> AuthorIndex::approxTopK(const CosineKernel &query, const size_t k) const
+{
+    if (!hasLsh())
+    {
+        return topK(query, k);
+    }
+    std::vector<bool> seen(size(), false);
+    std::vector<size_t> ids;
+    for (size_t t = 0; t < _buckets.size(); ++t)
+    {
+        uint64_t signature = _signature(query.query(), query.queryNorm(), t);
+        for (unsigned int flip = 0; flip <= _bits; ++flip)
+        {
+            // flip == _bits probes the query's own bucket, the others probe its neighbours.
+            uint64_t probe = (flip == _bits) ? signature : signature ^ (uint64_t(1) << flip);
+            auto bucket = _buckets[t].find(probe);
+            if (bucket == _buckets[t].end())
+            {
+                continue;
+            }
+            for (size_t id : bucket->second)
+            {
+                if (!seen[id])
+                {
+                    seen[id] = true;
+                    ids.push_back(id);
+                }
+            }
+        }
+    }
+    std::vector<double> scores(ids.size());
+    for (size_t i = 0; i < ids.size(); ++i)
+    {
+        scores[i] = query.scoreRow(_profiles, ids[i]);
+    }
+    return _best(ids, scores, k);
+}
+
+/**
+ * @param exact: the result of an exact search.
+ * @param approx: the result of an approximate search of the same query.
+ * @return the fraction of <exact>'s authors that were found by <approx> (1 if <exact> is empty).
+ */
+double AuthorIndex::recall(const std::vector<AuthorMatch> &exact,
+                           const std::vector<AuthorMatch> &approx)
+{
+    if (exact.empty())
+    {
+        return 1;
+    }
+    std::unordered_set<size_t> found;
+    for (const AuthorMatch &match : approx)
+    {
+        found.insert(match.id);
+    }
+    size_t hits = 0;
+    for (const AuthorMatch &match : exact)
+    {
+        hits += found.count(match.id);
+    }
+    return (double) hits / exact.size();
+}
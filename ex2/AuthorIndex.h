@@ -0,0 +1,181 @@
+//
+// Created by baraloni, ex2 cpp 2018-19 winter semester.
+// contains the index of author profiles searched by find_the_author.
+//
+
+#ifndef EX2_AUTHORINDEX_H
+#define EX2_AUTHORINDEX_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "CosineKernel.h"
+
+/** default number of hash tables used by the approximate search.*/
+#define LSH_DEFAULT_TABLES 8
+/** default number of bits in every approximate search signature.*/
+#define LSH_DEFAULT_BITS 12
+
+/**
+ * represents a scored author: its name (as given to the program), its index and its score.
+ */
+struct AuthorMatch
+{
+    /** the author's name.*/
+    std::string name;
+    /** the author's index (order of insertion).*/
+    size_t id;
+    /** the cosine similarity between the author and the query.*/
+    double score;
+};
+
+/**
+ * holds the frequency vectors of many authors, and finds the ones closest to a query.
+ * exact search scores every author (one sweep over the profile matrix) and keeps the best k
+ * in a bounded heap. approximate search hashes the normalized authors by random-projection LSH
+ * (the sides of random hyperplanes through their mean they fall on), and scores only the
+ * authors that share a bucket with the query.
+ */
+class AuthorIndex
+{
+private:
+    /**
+     * holds the authors' frequency vectors.
+     */
+    ProfileMatrix _profiles;
+
+    /**
+     * holds the authors' names (by index).
+     */
+    std::vector<std::string> _names;
+
+    /**
+     * represents the number of bits in a signature (0 if the LSH tables were not built).
+     */
+    unsigned int _bits = 0;
+
+    /**
+     * holds the random hyperplanes: _bits normals (of length _profiles.stride()) per table.
+     */
+    std::vector<double> _planes;
+
+    /**
+     * holds the offset of every hyperplane: its projection of the mean normalized profile.
+     * frequency vectors all lie in the positive orthant, so hyperplanes through the origin would
+     * put almost all of them on the same side.
+     */
+    std::vector<double> _offsets;
+
+    /**
+     * holds a table per signature set, mapping signatures to the indexes of their authors.
+     */
+    std::vector<std::unordered_map<uint64_t, std::vector<size_t>>> _buckets;
+
+    /**
+     * @param v: vector of length _profiles.stride().
+     * @param norm: <v>'s norm.
+     * @param table: table index.
+     * @return the signature of <v> in <table>.
+     */
+    uint64_t _signature(const double *v, double norm, size_t table) const;
+
+    /**
+     * @param a: author index.
+     * @param aScore: <a>'s score.
+     * @param b: author index.
+     * @param bScore: <b>'s score.
+     * @return true if <a> ranks before <b>: higher score, then smaller name, then earlier index.
+     */
+    bool _ranksBefore(size_t a, double aScore, size_t b, double bScore) const;
+
+    /**
+     * keeps the <k> best of the supplied candidates in a bounded heap.
+     * @param ids: candidate indexes.
+     * @param scores: their scores.
+     * @param k: number of matches to keep.
+     * @return the best <k> matches, best first.
+     */
+    std::vector<AuthorMatch> _best(const std::vector<size_t> &ids,
+                                   const std::vector<double> &scores, size_t k) const;
+
+public:
+    /**
+     * constructs an empty index for frequency vectors of length <cols>.
+     * @param cols: the length of the frequency vectors.
+     */
+    explicit AuthorIndex(size_t cols = 0): _profiles(cols) {}
+
+    /**
+     * adds an author to the index (and to the LSH tables, if they were built).
+     * @param name: the author's name.
+     * @param freq: the author's frequency vector.
+     * @return the author's index.
+     */
+    size_t add(const std::string &name, const std::vector<int> &freq);
+
+    /**
+     * @return the number of authors in the index.
+     */
+    inline size_t size() const {return _names.size();}
+
+    /**
+     * @return the authors' frequency vectors.
+     */
+    inline const ProfileMatrix &profiles() const {return _profiles;}
+
+    /**
+     * @param id: author index.
+     * @return the author's name.
+     */
+    inline const std::string &name(size_t id) const {return _names[id];}
+
+    /**
+     * scores every author against <query>.
+     * @param query: kernel holding the query.
+     * @param k: number of matches to return.
+     * @return the <k> best matching authors, best first.
+     */
+    std::vector<AuthorMatch> topK(const CosineKernel &query, size_t k) const;
+
+    /**
+     * ranks the authors by precomputed scores.
+     * @param scores: the score of author i at scores[i] (one per author).
+     * @param k: number of matches to return.
+     * @return the <k> best matching authors, best first.
+     */
+    std::vector<AuthorMatch> topK(const std::vector<double> &scores, size_t k) const;
+
+    /**
+     * (re)builds the LSH tables over all the authors in the index.
+     * @param tables: number of hash tables (0 drops the tables: the searches are then exact).
+     * @param bits: number of bits in a signature (1 to 64).
+     * @param seed: seed of the random hyperplanes.
+     */
+    void buildLsh(unsigned int tables = LSH_DEFAULT_TABLES, unsigned int bits = LSH_DEFAULT_BITS,
+                  unsigned int seed = 0);
+
+    /**
+     * @return true if the LSH tables were built.
+     */
+    inline bool hasLsh() const {return _bits != 0;}
+
+    /**
+     * scores only the authors that share a bucket with <query>, or a bucket one bit away from it.
+     * falls back to exact search if the LSH tables were not built.
+     * @param query: kernel holding the query.
+     * @param k: number of matches to return.
+     * @return (up to) <k> matching authors, best first.
+     */
+    std::vector<AuthorMatch> approxTopK(const CosineKernel &query, size_t k) const;
+
+    /**
+     * @param exact: the result of an exact search.
+     * @param approx: the result of an approximate search of the same query.
+     * @return the fraction of <exact>'s authors that were found by <approx> (1 if <exact> is empty).
+     */
+    static double recall(const std::vector<AuthorMatch> &exact,
+                         const std::vector<AuthorMatch> &approx);
+};
+
+#endif //EX2_AUTHORINDEX_H
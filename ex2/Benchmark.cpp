@@ -0,0 +1,369 @@
+//
+// Created by baraloni, ex2 cpp 2018-19 winter semester.
+// contains a throughput benchmark of the attribution stages, over synthetic corpora.
+//
+
+#include "FrequenciesDetector.h"
+#include "FeatureExtractor.h"
+#include "CosineKernel.h"
+#include "AuthorIndex.h"
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+#define BENCH_USAGE_ERR "Usage: benchmark [--mb=<text MB>] [--vocab=<distinct words>] " \
+                        "[--frequent=<frequent words>] [--authors=<n>] [--reps=<n>] [--seed=<n>]"
+
+/** a MiB, in bytes.*/
+#define MB (1024.0 * 1024.0)
+
+//---------------------Corpus:
+
+/**
+ * represents the benchmark's parameters.
+ */
+struct BenchOptions
+{
+    /** size of every synthetic text, in MiB.*/
+    double mb = 8;
+    /** number of distinct words in the corpus.*/
+    unsigned long vocab = 50000;
+    /** number of words in the frequent-word list.*/
+    unsigned long frequent = 500;
+    /** number of author texts (each of size mb / authors).*/
+    unsigned long authors = 16;
+    /** number of times every stage is repeated.*/
+    unsigned long reps = 200;
+    /** seed of the corpus generator.*/
+    unsigned long seed = 1;
+};
+
+/**
+ * generates the synthetic vocabulary: distinct lower- and upper-case words of varying length.
+ * @param size: the number of words.
+ * @param gen: the generator.
+ * @return the words, most frequent first.
+ */
+static std::vector<std::string> makeVocabulary(const unsigned long size, std::mt19937_64 &gen)
+{
+    std::vector<std::string> words;
+    words.reserve(size);
+    std::uniform_int_distribution<int> length(1, 6);
+    for (unsigned long i = 0; i < size; ++i)
+    {
+        std::string word;
+        unsigned long id = i;
+        do
+        {
+            word.push_back((char) ('a' + id % 26));
+            id /= 26;
+        } while (id > 0);
+        for (int extra = length(gen); extra > 0; --extra)
+        {
+            word.push_back((char) ('a' + gen() % 26));
+        }
+        if (gen() % 8 == 0)
+        {
+            word[0] = (char) (word[0] - 'a' + 'A');
+        }
+        words.push_back(word);
+    }
+    return words;
+}
+
+/**
+ * generates a text of Zipf-distributed words (as natural language is), with mixed separators.
+ * @param vocab: the vocabulary, most frequent first.
+ * @param bytes: the text's (approximate) size.
+ * @param shift: rotates the distribution, so that different authors favour different words.
+ * @param gen: the generator.
+ * @return the text.
+ */
+static std::string makeText(const std::vector<std::string> &vocab, const size_t bytes,
+                            const unsigned long shift, std::mt19937_64 &gen)
+{
+    std::vector<double> weights(vocab.size());
+    for (size_t i = 0; i < weights.size(); ++i)
+    {
+        weights[(i + shift) % weights.size()] = 1.0 / (double) (i + 1);
+    }
+    std::discrete_distribution<size_t> zipf(weights.begin(), weights.end());
+    static const char *separators[] = {" ", " ", " ", " ", ", ", "; ", "!\n", "\r\n"};
+    std::string text;
+    text.reserve(bytes + 64);
+    while (text.size() < bytes)
+    {
+        text += vocab[zipf(gen)];
+        text += separators[gen() % 8];
+    }
+    return text;
+}
+
+//---------------------Timing:
+
+/**
+ * @return the current time.
+ */
+static std::chrono::steady_clock::time_point tic()
+{
+    return std::chrono::steady_clock::now();
+}
+
+/**
+ * @param start: a time returned by tic().
+ * @return the seconds since <start>.
+ */
+static double toc(const std::chrono::steady_clock::time_point &start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * runs <stage> <reps> times (at least once).
+ * @param reps: the number of runs.
+ * @param stage: callable as stage().
+ * @return the wall time of the fastest run, in seconds (the first run warms the caches up).
+ */
+template <typename Stage>
+static double bestOf(const unsigned long reps, Stage stage)
+{
+    double best = INFINITY;
+    for (unsigned long rep = 0; rep == 0 || rep < reps; ++rep)
+    {
+        const auto start = tic();
+        stage();
+        best = std::min(best, toc(start));
+    }
+    return best;
+}
+
+/**
+ * prints one stage's throughput.
+ * @param stage: the stage's name.
+ * @param seconds: the stage's wall time.
+ * @param bytes: the number of bytes the stage went over.
+ * @param tokens: the number of tokens (words or vectors) the stage went over.
+ * @param unit: the name of a token.
+ */
+static void report(const std::string &stage, const double seconds, const double bytes,
+                   const double tokens, const std::string &unit)
+{
+    std::cout << std::left << std::setw(12) << stage << std::right << std::fixed
+              << std::setprecision(4) << std::setw(10) << seconds << " s"
+              << std::setprecision(1) << std::setw(12) << bytes / MB / seconds << " MB/s"
+              << std::setprecision(0) << std::setw(14) << tokens / seconds << " " << unit
+              << "/s" << std::endl;
+}
+
+//---------------------Helpers:
+
+/**
+ * parses a positive number option.
+ * @param arg: the argument.
+ * @param name: the option's name (e.g. "--mb=").
+ * @param out: the value (if arg is the option).
+ * @return true if arg is the option.
+ */
+static bool parseOption(const char *arg, const char *name, double &out)
+{
+    size_t length = strlen(name);
+    if (strncmp(arg, name, length) != 0)
+    {
+        return false;
+    }
+    char *end;
+    out = strtod(arg + length, &end);
+    if (*end != '\0' || !(out > 0) || !std::isfinite(out))
+    {
+        std::cerr << BENCH_USAGE_ERR << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    return true;
+}
+
+/**
+ * parses a positive integer option (a fraction, a sign or an out of range value is an error).
+ * @param arg: the argument.
+ * @param name: the option's name (e.g. "--authors=").
+ * @param out: the value (if arg is the option).
+ * @return true if arg is the option.
+ */
+static bool parseOption(const char *arg, const char *name, unsigned long &out)
+{
+    size_t length = strlen(name);
+    if (strncmp(arg, name, length) != 0)
+    {
+        return false;
+    }
+    const char *digits = arg + length;
+    char *end;
+    errno = 0;
+    out = strtoul(digits, &end, 10);
+    if (!isdigit((unsigned char) *digits) || *end != '\0' || errno == ERANGE || out == 0)
+    {
+        std::cerr << BENCH_USAGE_ERR << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    return true;
+}
+
+/**
+ * parses the command line.
+ * @param argc: the number of arguments.
+ * @param argv: the arguments.
+ * @return the options.
+ */
+static BenchOptions parseOptions(int argc, char *argv[])
+{
+    BenchOptions options;
+    for (int i = 1; i < argc; ++i)
+    {
+        double mb = 0;
+        unsigned long count = 0;
+        if (parseOption(argv[i], "--mb=", mb))
+        {
+            options.mb = mb;
+        }
+        else if (parseOption(argv[i], "--vocab=", count))
+        {
+            options.vocab = count;
+        }
+        else if (parseOption(argv[i], "--frequent=", count))
+        {
+            options.frequent = count;
+        }
+        else if (parseOption(argv[i], "--authors=", count))
+        {
+            options.authors = count;
+        }
+        else if (parseOption(argv[i], "--reps=", count))
+        {
+            options.reps = count;
+        }
+        else if (parseOption(argv[i], "--seed=", count))
+        {
+            options.seed = count;
+        }
+        else
+        {
+            std::cerr << BENCH_USAGE_ERR << std::endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+    options.frequent = std::min(options.frequent, options.vocab);
+    return options;
+}
+
+/**
+ * generates the synthetic corpora, and times every stage of the attribution on them:
+ * word-list load (from a file, as the CLI maps it), tokenization, counting (the feature lookups
+ * on top of tokenization) and scoring. the first three keep their fastest of --reps runs, and
+ * scoring is averaged over --reps queries.
+ * prints the throughput of every stage, in MB/s and tokens/s.
+ */
+int main(int argc, char *argv[])
+{
+    const BenchOptions options = parseOptions(argc, argv);
+    std::mt19937_64 gen(options.seed);
+    const size_t bytes = (size_t) (options.mb * MB);
+
+    std::vector<std::string> vocab = makeVocabulary(options.vocab, gen);
+    std::string wordList;
+    Vocabulary words;
+    for (unsigned long i = 0; i < options.frequent; ++i)
+    {
+        std::string word = vocab[i * (options.vocab / options.frequent)];
+        for (char &c : word)
+        {
+            c = (char) tolower(c);
+        }
+        wordList += word + "\n";
+        words.insert(word);
+    }
+    std::string unknown = makeText(vocab, bytes, 0, gen);
+    std::vector<std::string> authors;
+    for (unsigned long i = 0; i < options.authors; ++i)
+    {
+        authors.push_back(makeText(vocab, bytes / options.authors, i * 7, gen));
+    }
+    std::cout << "corpus " << std::fixed << std::setprecision(1) << unknown.size() / MB
+              << " MB, vocabulary " << options.vocab << ", frequent words " << words.size()
+              << ", authors " << options.authors << " x " << bytes / options.authors / MB
+              << " MB" << std::endl;
+
+    // word-list load (mapped from a file, through the CLI's constructor):
+    char wordsPath[] = "/tmp/benchmarkWordsXXXXXX";
+    const int wordsFd = mkstemp(wordsPath);
+    if (wordsFd < 0 || write(wordsFd, wordList.data(), wordList.size()) != (ssize_t) wordList.size())
+    {
+        std::cerr << "Error: could not write the word list to " << wordsPath << "." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    close(wordsFd);
+    double seconds = bestOf(options.reps, [&wordsPath]()
+    {
+        FrequenciesDetector detector(std::make_shared<const MappedFile>(wordsPath));
+    });
+    unlink(wordsPath);
+    report("load", seconds, wordList.size(), words.size(), "words");
+
+    // tokenization:
+    FeatureExtractor extractor(words, FeatureConfig(), SEPARATORS);
+    unsigned long tokens = 0;
+    const double tokenizeSeconds = bestOf(options.reps, [&]()
+    {
+        tokens = 0;
+        extractor.forEachWord(unknown.data(), unknown.size(), [&tokens](const std::string &)
+        {
+            ++tokens;
+        });
+    });
+    report("tokenize", tokenizeSeconds, unknown.size(), tokens, "tokens");
+
+    // counting (lookups of the tokens in the frequent-word table):
+    std::vector<int> query(extractor.size(), 0);
+    const double extractSeconds = bestOf(options.reps, [&]()
+    {
+        std::fill(query.begin(), query.end(), 0);
+        extractor.extract(unknown.data(), unknown.size(), query);
+    });
+    report("count", std::max(extractSeconds - tokenizeSeconds, 1e-9), unknown.size(), tokens,
+           "tokens");
+    report("extract", extractSeconds, unknown.size(), tokens, "tokens");
+
+    // scoring:
+    AuthorIndex index(extractor.size());
+    for (size_t i = 0; i < authors.size(); ++i)
+    {
+        std::vector<int> freq(extractor.size(), 0);
+        extractor.extract(authors[i].data(), authors[i].size(), freq);
+        index.add("author" + std::to_string(i), freq);
+    }
+    CosineKernel kernel;
+    auto start = tic();
+    double checksum = 0;
+    for (unsigned long rep = 0; rep < options.reps; ++rep)
+    {
+        ++query[rep % query.size()];
+        kernel.setQuery(query);
+        checksum += index.topK(kernel, 1).front().score;
+    }
+    seconds = toc(start);
+    // every query streams the authors' rows of the profile matrix.
+    const double vectorBytes = (double) options.reps * options.authors *
+                               index.profiles().stride() * sizeof(double);
+    report("score", seconds, vectorBytes, (double) options.reps * options.authors, "vectors");
+    std::cout << "checksum " << std::setprecision(6) << checksum << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,324 @@
+//
+// Created by baraloni, ex2 cpp 2018-19 winter semester.
+// contains the cosine-similarity scoring kernel used by find_the_author.
+//
+
+#include "CosineKernel.h"
+#include <algorithm>
+#include <cmath>
+#ifdef __AVX__
+#include <immintrin.h>
+#endif
+
+//---------------------Helpers:
+
+/**
+ * @param n: a length.
+ * @return <n> rounded up to a multiple of KERNEL_LANES.
+ */
+static inline size_t padded(size_t n)
+{
+    return (n + KERNEL_LANES - 1) / KERNEL_LANES * KERNEL_LANES;
+}
+
+#ifdef __AVX__
+/**
+ * @param v: 4 doubles.
+ * @return the sum of <v>'s entries.
+ */
+static inline double horizontalSum(__m256d v)
+{
+    __m128d sum = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(sum, _mm_unpackhi_pd(sum, sum)));
+}
+
+/**
+ * @return acc + (a * b), fused when the target supports it.
+ */
+static inline __m256d multiplyAdd(__m256d a, __m256d b, __m256d acc)
+{
+#ifdef __FMA__
+    return _mm256_fmadd_pd(a, b, acc);
+#else
+    return _mm256_add_pd(_mm256_mul_pd(a, b), acc);
+#endif
+}
+#endif
+
+//---------------------ProfileMatrix:
+
+/**
+ * constructs a new empty matrix, whose rows are of length <cols>.
+ * @param cols: the length of the frequency vectors.
+ */
+ProfileMatrix::ProfileMatrix(const size_t cols): _cols(cols), _stride(padded(cols))
+{
+}
+
+/**
+ * appends <freq> as the last row of the matrix.
+ * @param freq: frequency vector of length cols().
+ * @return the index of the new row.
+ */
+size_t ProfileMatrix::addRow(const std::vector<int> &freq)
+{
+    size_t first = _cells.size();
+    _cells.resize(first + _stride, 0.0);
+    double squaredNorm = 0;
+    for (size_t i = 0; i < _cols; ++i)
+    {
+        _cells[first + i] = freq[i];
+        squaredNorm += (double) freq[i] * freq[i];
+    }
+    _norms.push_back(sqrt(squaredNorm));
+    return _norms.size() - 1;
+}
+
+//---------------------CosineKernel:
+
+/**
+ * constructs a kernel that scores against <query>.
+ * @param query: frequency vector.
+ */
+CosineKernel::CosineKernel(const std::vector<int> &query)
+{
+    setQuery(query);
+}
+
+/**
+ * replaces the query vector (and its cached norm) with <query>.
+ * @param query: frequency vector.
+ */
+void CosineKernel::setQuery(const std::vector<int> &query)
+{
+    _query.assign(padded(query.size()), 0.0);
+    double squaredNorm = 0;
+    for (size_t i = 0; i < query.size(); ++i)
+    {
+        _query[i] = query[i];
+        squaredNorm += (double) query[i] * query[i];
+    }
+    _queryNorm = sqrt(squaredNorm);
+}
+
+/**
+ * computes the dot product with the query and the norm of <v> in one fused pass.
+ * @param v: frequency vector of the query's length.
+ * @return the cosine similarity between <v> and the query (0 if one of them is zero).
+ */
+double CosineKernel::score(const std::vector<int> &v) const
+{
+    const double *q = _query.data();
+    const int *x = v.data();
+    const size_t n = v.size();
+    size_t i = 0;
+    double dot = 0, squaredNorm = 0;
+#ifdef __AVX__
+    __m256d dotAcc = _mm256_setzero_pd(), normAcc = _mm256_setzero_pd();
+    for (; i + KERNEL_LANES <= n; i += KERNEL_LANES)
+    {
+        __m256d xv = _mm256_cvtepi32_pd(_mm_loadu_si128((const __m128i *) (x + i)));
+        dotAcc = multiplyAdd(xv, _mm256_loadu_pd(q + i), dotAcc);
+        normAcc = multiplyAdd(xv, xv, normAcc);
+    }
+    dot = horizontalSum(dotAcc);
+    squaredNorm = horizontalSum(normAcc);
+#else
+    double dotAcc[KERNEL_LANES] = {0}, normAcc[KERNEL_LANES] = {0};
+    for (; i + KERNEL_LANES <= n; i += KERNEL_LANES)
+    {
+        for (size_t l = 0; l < KERNEL_LANES; ++l)
+        {
+            double xl = x[i + l];
+            dotAcc[l] += xl * q[i + l];
+            normAcc[l] += xl * xl;
+        }
+    }
+    for (size_t l = 0; l < KERNEL_LANES; ++l)
+    {
+        dot += dotAcc[l];
+        squaredNorm += normAcc[l];
+    }
+#endif
+    for (; i < n; ++i)
+    {
+        double xi = x[i];
+        dot += xi * q[i];
+        squaredNorm += xi * xi;
+    }
+    return cosine(dot, _queryNorm, sqrt(squaredNorm));
+}
+
+/**
+ * scores every row of <profiles> against the query, in one GEMV-style sweep
+ * (the rows' norms are taken from the matrix).
+ * rows are processed KERNEL_LANES at a time, so every loaded chunk of the query is reused
+ * by all of them.
+ * @param profiles: matrix whose rows are of the query's length.
+ * @param out: receives the score of row i at out[i].
+ */
+void CosineKernel::scoreAll(const ProfileMatrix &profiles, std::vector<double> &out) const
+{
+    const size_t rows = profiles.rows(), stride = profiles.stride();
+    const double *q = _query.data();
+    out.resize(rows);
+    size_t r = 0;
+    for (; r + KERNEL_LANES <= rows; r += KERNEL_LANES)
+    {
+        const double *r0 = profiles.row(r), *r1 = profiles.row(r + 1);
+        const double *r2 = profiles.row(r + 2), *r3 = profiles.row(r + 3);
+        double dots[KERNEL_LANES] = {0};
+#ifdef __AVX__
+        __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+        __m256d acc2 = _mm256_setzero_pd(), acc3 = _mm256_setzero_pd();
+        for (size_t i = 0; i < stride; i += KERNEL_LANES)
+        {
+            __m256d qv = _mm256_loadu_pd(q + i);
+            acc0 = multiplyAdd(_mm256_loadu_pd(r0 + i), qv, acc0);
+            acc1 = multiplyAdd(_mm256_loadu_pd(r1 + i), qv, acc1);
+            acc2 = multiplyAdd(_mm256_loadu_pd(r2 + i), qv, acc2);
+            acc3 = multiplyAdd(_mm256_loadu_pd(r3 + i), qv, acc3);
+        }
+        dots[0] = horizontalSum(acc0);
+        dots[1] = horizontalSum(acc1);
+        dots[2] = horizontalSum(acc2);
+        dots[3] = horizontalSum(acc3);
+#else
+        for (size_t i = 0; i < stride; ++i)
+        {
+            dots[0] += r0[i] * q[i];
+            dots[1] += r1[i] * q[i];
+            dots[2] += r2[i] * q[i];
+            dots[3] += r3[i] * q[i];
+        }
+#endif
+        for (size_t l = 0; l < KERNEL_LANES; ++l)
+        {
+            out[r + l] = cosine(dots[l], _queryNorm, profiles.norm(r + l));
+        }
+    }
+    for (; r < rows; ++r)
+    {
+        out[r] = scoreRow(profiles, r);
+    }
+}
+
+/**
+ * scores a single row of <profiles> against the query (the row's norm is taken from the matrix).
+ * @param profiles: matrix whose rows are of the query's length.
+ * @param i: row index.
+ * @return the cosine similarity between row <i> and the query.
+ */
+double CosineKernel::scoreRow(const ProfileMatrix &profiles, const size_t i) const
+{
+    const double *row = profiles.row(i), *q = _query.data();
+    double dot = 0;
+    for (size_t j = 0; j < profiles.stride(); ++j)
+    {
+        dot += row[j] * q[j];
+    }
+    return cosine(dot, _queryNorm, profiles.norm(i));
+}
+
+/**
+ * adds the dot products of <rows> queries (1 or 2) and <cols> profile rows (1 to 4), over the
+ * columns [begin, end), to dots[query * n + row].
+ * @param q: the queries' first rows.
+ * @param r: the profile rows.
+ * @param rows: number of queries.
+ * @param cols: number of profile rows.
+ * @param begin: the first column.
+ * @param end: past the last column (both multiples of KERNEL_LANES).
+ * @param dots: the tile's first dot product.
+ * @param n: the distance between two queries' dot products.
+ */
+static inline void multiplyTile(const double *const *q, const double *const *r, const size_t rows,
+                                const size_t cols, const size_t begin, const size_t end,
+                                double *dots, const size_t n)
+{
+#ifdef __AVX__
+    if (rows == 2 && cols == KERNEL_LANES)
+    {
+        __m256d acc00 = _mm256_setzero_pd(), acc01 = _mm256_setzero_pd();
+        __m256d acc02 = _mm256_setzero_pd(), acc03 = _mm256_setzero_pd();
+        __m256d acc10 = _mm256_setzero_pd(), acc11 = _mm256_setzero_pd();
+        __m256d acc12 = _mm256_setzero_pd(), acc13 = _mm256_setzero_pd();
+        for (size_t i = begin; i < end; i += KERNEL_LANES)
+        {
+            const __m256d q0 = _mm256_loadu_pd(q[0] + i), q1 = _mm256_loadu_pd(q[1] + i);
+            const __m256d r0 = _mm256_loadu_pd(r[0] + i), r1 = _mm256_loadu_pd(r[1] + i);
+            const __m256d r2 = _mm256_loadu_pd(r[2] + i), r3 = _mm256_loadu_pd(r[3] + i);
+            acc00 = multiplyAdd(q0, r0, acc00);
+            acc01 = multiplyAdd(q0, r1, acc01);
+            acc02 = multiplyAdd(q0, r2, acc02);
+            acc03 = multiplyAdd(q0, r3, acc03);
+            acc10 = multiplyAdd(q1, r0, acc10);
+            acc11 = multiplyAdd(q1, r1, acc11);
+            acc12 = multiplyAdd(q1, r2, acc12);
+            acc13 = multiplyAdd(q1, r3, acc13);
+        }
+        dots[0] += horizontalSum(acc00);
+        dots[1] += horizontalSum(acc01);
+        dots[2] += horizontalSum(acc02);
+        dots[3] += horizontalSum(acc03);
+        dots[n] += horizontalSum(acc10);
+        dots[n + 1] += horizontalSum(acc11);
+        dots[n + 2] += horizontalSum(acc12);
+        dots[n + 3] += horizontalSum(acc13);
+        return;
+    }
+#endif
+    for (size_t a = 0; a < rows; ++a)
+    {
+        for (size_t b = 0; b < cols; ++b)
+        {
+            double dot = 0;
+            for (size_t i = begin; i < end; ++i)
+            {
+                dot += q[a][i] * r[b][i];
+            }
+            dots[a * n + b] += dot;
+        }
+    }
+}
+
+/**
+ * scores every row of <queries> against every row of <profiles>, as a single blocked matrix
+ * product (queries x profiles transposed): tiles of 2 queries by 4 profiles are accumulated in
+ * registers, over panels of KERNEL_BLOCK_COLS columns.
+ * @param queries: matrix of query vectors.
+ * @param profiles: matrix whose rows are of the queries' length.
+ * @param out: receives the score of query i and row j at out[i * profiles.rows() + j].
+ */
+void CosineKernel::scoreMatrix(const ProfileMatrix &queries, const ProfileMatrix &profiles,
+                               std::vector<double> &out)
+{
+    const size_t m = queries.rows(), n = profiles.rows(), stride = profiles.stride();
+    out.assign(m * n, 0.0);
+    for (size_t begin = 0; begin < stride; begin += KERNEL_BLOCK_COLS)
+    {
+        const size_t end = std::min(stride, begin + KERNEL_BLOCK_COLS);
+        for (size_t i = 0; i < m; i += 2)
+        {
+            const size_t rows = std::min((size_t) 2, m - i);
+            const double *q[2] = {queries.row(i), queries.row(i + rows - 1)};
+            for (size_t j = 0; j < n; j += KERNEL_LANES)
+            {
+                const size_t cols = std::min((size_t) KERNEL_LANES, n - j);
+                const double *r[KERNEL_LANES];
+                for (size_t b = 0; b < KERNEL_LANES; ++b)
+                {
+                    r[b] = profiles.row(j + std::min(b, cols - 1));
+                }
+                multiplyTile(q, r, rows, cols, begin, end, out.data() + i * n + j, n);
+            }
+        }
+    }
+    for (size_t i = 0; i < m; ++i)
+    {
+        for (size_t j = 0; j < n; ++j)
+        {
+            out[i * n + j] = cosine(out[i * n + j], queries.norm(i), profiles.norm(j));
+        }
+    }
+}
@@ -0,0 +1,186 @@
+//
+// Created by baraloni, ex2 cpp 2018-19 winter semester.
+// contains the cosine-similarity scoring kernel used by find_the_author.
+//
+
+#ifndef EX2_COSINEKERNEL_H
+#define EX2_COSINEKERNEL_H
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * number of doubles processed together by the kernels (one AVX register).
+ * every row of a ProfileMatrix is padded with zeros to a multiple of it.
+ */
+#define KERNEL_LANES 4
+
+/**
+ * number of columns (doubles) of the panels scoreMatrix multiplies at a time, so that a panel of
+ * every row of a tile stays in the l1 cache.
+ */
+#define KERNEL_BLOCK_COLS 512
+
+/**
+ * holds frequency vectors (one per author) as the rows of a single contiguous matrix of doubles.
+ * each row is zero padded to a multiple of KERNEL_LANES, and its norm is computed once,
+ * when the row is added.
+ */
+class ProfileMatrix
+{
+private:
+    /**
+     * holds the matrix cells, row after row (each row is _stride doubles long).
+     */
+    std::vector<double> _cells;
+
+    /**
+     * holds the norm of every row.
+     */
+    std::vector<double> _norms;
+
+    /**
+     * represents the number of meaningful entries in a row.
+     */
+    size_t _cols;
+
+    /**
+     * represents the distance (in doubles) between the beginnings of two consecutive rows.
+     */
+    size_t _stride;
+
+public:
+    /**
+     * constructs a new empty matrix, whose rows are of length <cols>.
+     * @param cols: the length of the frequency vectors.
+     */
+    explicit ProfileMatrix(size_t cols = 0);
+
+    /**
+     * appends <freq> as the last row of the matrix.
+     * @param freq: frequency vector of length cols().
+     * @return the index of the new row.
+     */
+    size_t addRow(const std::vector<int> &freq);
+
+    /**
+     * @return the number of rows in the matrix.
+     */
+    inline size_t rows() const {return _norms.size();}
+
+    /**
+     * @return the length of the rows (without the padding).
+     */
+    inline size_t cols() const {return _cols;}
+
+    /**
+     * @return the length of the rows (with the padding).
+     */
+    inline size_t stride() const {return _stride;}
+
+    /**
+     * @param i: row index.
+     * @return a pointer to the first cell of row <i>.
+     */
+    inline const double *row(size_t i) const {return _cells.data() + i * _stride;}
+
+    /**
+     * @param i: row index.
+     * @return the norm of row <i>.
+     */
+    inline double norm(size_t i) const {return _norms[i];}
+};
+
+/**
+ * scores frequency vectors against a fixed query vector by their cosine similarity.
+ * the query (and its norm) is converted and cached once, so scoring an author costs a
+ * single pass over its vector.
+ */
+class CosineKernel
+{
+private:
+    /**
+     * holds the query vector as doubles, zero padded to a multiple of KERNEL_LANES.
+     */
+    std::vector<double> _query;
+
+    /**
+     * holds the norm of the query vector.
+     */
+    double _queryNorm = 0;
+
+public:
+    /**
+     * constructs a kernel with an empty query.
+     */
+    CosineKernel() = default;
+
+    /**
+     * constructs a kernel that scores against <query>.
+     * @param query: frequency vector.
+     */
+    explicit CosineKernel(const std::vector<int> &query);
+
+    /**
+     * replaces the query vector (and its cached norm) with <query>.
+     * @param query: frequency vector.
+     */
+    void setQuery(const std::vector<int> &query);
+
+    /**
+     * @return the norm of the query vector.
+     */
+    inline double queryNorm() const {return _queryNorm;}
+
+    /**
+     * @return a pointer to the (zero padded) query vector.
+     */
+    inline const double *query() const {return _query.data();}
+
+    /**
+     * computes the dot product with the query and the norm of <v> in one fused pass.
+     * @param v: frequency vector of the query's length.
+     * @return the cosine similarity between <v> and the query (0 if one of them is zero).
+     */
+    double score(const std::vector<int> &v) const;
+
+    /**
+     * scores every row of <profiles> against the query, in one GEMV-style sweep
+     * (the rows' norms are taken from the matrix).
+     * @param profiles: matrix whose rows are of the query's length.
+     * @param out: receives the score of row i at out[i].
+     */
+    void scoreAll(const ProfileMatrix &profiles, std::vector<double> &out) const;
+
+    /**
+     * scores a single row of <profiles> against the query (the row's norm is taken from the matrix).
+     * @param profiles: matrix whose rows are of the query's length.
+     * @param i: row index.
+     * @return the cosine similarity between row <i> and the query.
+     */
+    double scoreRow(const ProfileMatrix &profiles, size_t i) const;
+
+    /**
+     * scores every row of <queries> against every row of <profiles>, as a single blocked matrix
+     * product (queries x profiles transposed): tiles of 2 queries by 4 profiles are accumulated in
+     * registers, over panels of KERNEL_BLOCK_COLS columns.
+     * @param queries: matrix of query vectors.
+     * @param profiles: matrix whose rows are of the queries' length.
+     * @param out: receives the score of query i and row j at out[i * profiles.rows() + j].
+     */
+    static void scoreMatrix(const ProfileMatrix &queries, const ProfileMatrix &profiles,
+                            std::vector<double> &out);
+
+    /**
+     * @param dot: the dot product of two vectors.
+     * @param norm1: the norm of the first vector.
+     * @param norm2: the norm of the second vector.
+     * @return the cosine similarity of the vectors (0 if one of them is zero).
+     */
+    static inline double cosine(double dot, double norm1, double norm2)
+    {
+        return (norm1 * norm2 == 0) ? 0 : dot / (norm1 * norm2);
+    }
+};
+
+#endif //EX2_COSINEKERNEL_H
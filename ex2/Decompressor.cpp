@@ -0,0 +1,217 @@
+//
+// Created by baraloni, ex2 cpp 2018-19 winter semester.
+// contains the streaming decompression of gzip and zstd texts.
+//
+
+#include "Decompressor.h"
+#include <algorithm>
+#include <climits>
+#include <thread>
+#include <zlib.h>
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+//---------------------Queue:
+
+/**
+ * @return an empty piece to decompress into (waits while DECOMPRESS_QUEUE pieces wait), or an
+ * empty string if the consumer stopped.
+ */
+std::string Decompressor::_take()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    _changed.wait(lock, [this] { return _ready.size() < DECOMPRESS_QUEUE || _cancelled; });
+    std::string piece;
+    if (_cancelled)
+    {
+        return piece;
+    }
+    if (!_pool.empty())
+    {
+        piece = std::move(_pool.front());
+        _pool.pop_front();
+    }
+    piece.resize(DECOMPRESS_CHUNK);
+    return piece;
+}
+
+/**
+ * hands a decompressed piece to the consumer.
+ * @param piece: the piece.
+ */
+void Decompressor::_push(std::string &&piece)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _ready.push_back(std::move(piece));
+    _changed.notify_all();
+}
+
+//---------------------Producer:
+
+/**
+ * decompresses a gzip (or zlib) text, made of one or more members.
+ * @return true if the text is well formed.
+ */
+bool Decompressor::_inflate()
+{
+    z_stream stream{};
+    if (inflateInit2(&stream, 15 + 32) != Z_OK) // 32: detect the gzip or zlib header.
+    {
+        return false;
+    }
+    // zlib counts the input in uInt: texts of 4GiB and more are fed UINT_MAX bytes at a time.
+    const Bytef *end = reinterpret_cast<const Bytef *>(_data) + _size;
+    stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(_data));
+    stream.avail_in = 0;
+    int status = Z_OK;
+    while (status != Z_STREAM_END || stream.next_in < end)
+    {
+        if (stream.avail_in == 0)
+        {
+            stream.avail_in = (uInt) std::min((size_t) (end - stream.next_in), (size_t) UINT_MAX);
+        }
+        if (status == Z_STREAM_END)
+        {
+            inflateReset(&stream); // the next member of a concatenated gzip.
+        }
+        std::string piece = _take();
+        if (piece.empty())
+        {
+            status = Z_DATA_ERROR;
+            break;
+        }
+        stream.next_out = reinterpret_cast<Bytef *>(&piece[0]);
+        stream.avail_out = (uInt) piece.size();
+        status = inflate(&stream, Z_NO_FLUSH);
+        piece.resize(piece.size() - stream.avail_out);
+        if (!piece.empty())
+        {
+            _push(std::move(piece));
+        }
+        if (status != Z_OK && status != Z_STREAM_END)
+        {
+            break;
+        }
+    }
+    inflateEnd(&stream);
+    return status == Z_STREAM_END;
+}
+
+/**
+ * decompresses a zstd text, made of one or more frames.
+ * @return true if the text is well formed.
+ */
+bool Decompressor::_unzstd()
+{
+#ifdef HAVE_ZSTD
+    ZSTD_DStream *stream = ZSTD_createDStream();
+    ZSTD_inBuffer in = {_data, _size, 0};
+    size_t status = 1;
+    bool pending = true; // input left, or output that didn't fit in the last piece.
+    while (pending && !ZSTD_isError(status))
+    {
+        std::string piece = _take();
+        if (piece.empty())
+        {
+            status = (size_t) -1;
+            break;
+        }
+        ZSTD_outBuffer out = {&piece[0], piece.size(), 0};
+        status = ZSTD_decompressStream(stream, &out, &in);
+        pending = in.pos < in.size || out.pos == out.size;
+        piece.resize(out.pos);
+        if (!piece.empty())
+        {
+            _push(std::move(piece));
+        }
+    }
+    ZSTD_freeDStream(stream);
+    return status == 0;
+#else
+    return false;
+#endif
+}
+
+/**
+ * decompresses the whole text (the producer thread).
+ */
+void Decompressor::_produce()
+{
+    const bool good = (detect(_data, _size) == Compression::ZSTD) ? _unzstd() : _inflate();
+    std::lock_guard<std::mutex> lock(_mutex);
+    _good = good;
+    _done = true;
+    _changed.notify_all();
+}
+
+//---------------------Methods:
+
+/**
+ * @param data: the bytes of a text.
+ * @param size: the number of bytes.
+ * @return the text's format (by its magic number).
+ */
+Compression Decompressor::detect(const char *data, const size_t size)
+{
+    const auto *bytes = reinterpret_cast<const unsigned char *>(data);
+    if (size >= 2 && bytes[0] == 0x1F && bytes[1] == 0x8B)
+    {
+        return Compression::GZIP;
+    }
+    if (size >= 4 && bytes[0] == 0x28 && bytes[1] == 0xB5 && bytes[2] == 0x2F && bytes[3] == 0xFD)
+    {
+        return Compression::ZSTD;
+    }
+    return Compression::NONE;
+}
+
+/**
+ * decompresses the text, and calls <onChunk> with every decompressed piece, in order, on the
+ * calling thread. if <onChunk> throws, the producer is stopped and joined before the exception
+ * propagates.
+ * @param onChunk: callable receiving a piece's bytes and their number.
+ * @return true if the whole text was decompressed.
+ */
+bool Decompressor::forEachChunk(const std::function<void(const char *, size_t)> &onChunk)
+{
+    /**
+     * stops (if still running) and joins the producer, however forEachChunk exits.
+     */
+    struct ProducerGuard
+    {
+        Decompressor &decompressor;
+        std::thread thread;
+        ~ProducerGuard()
+        {
+            {
+                std::lock_guard<std::mutex> lock(decompressor._mutex);
+                decompressor._cancelled = true;
+            }
+            decompressor._changed.notify_all();
+            thread.join();
+        }
+    } producer{*this, std::thread(&Decompressor::_produce, this)};
+    std::string piece;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            if (!piece.empty())
+            {
+                _pool.push_back(std::move(piece));
+            }
+            _changed.wait(lock, [this] { return !_ready.empty() || _done; });
+            if (_ready.empty())
+            {
+                break;
+            }
+            piece = std::move(_ready.front());
+            _ready.pop_front();
+            _changed.notify_all();
+        }
+        onChunk(piece.data(), piece.size());
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _good;
+}
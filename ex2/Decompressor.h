@@ -0,0 +1,134 @@
+//
+// Created by baraloni, ex2 cpp 2018-19 winter semester.
+// contains the streaming decompression of gzip and zstd texts.
+//
+
+#ifndef EX2_DECOMPRESSOR_H
+#define EX2_DECOMPRESSOR_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#define DECOMPRESS_ERR "Error: a compressed file is corrupt, or its format isn't supported."
+
+/** size of a decompressed piece, in bytes.*/
+#define DECOMPRESS_CHUNK (256 * 1024)
+/** number of decompressed pieces that may wait for the consumer.*/
+#define DECOMPRESS_QUEUE 4
+
+/**
+ * represents the formats of a text.
+ */
+enum class Compression
+{
+    NONE, GZIP, ZSTD
+};
+
+/**
+ * decompresses a gzip (or zstd, when built with HAVE_ZSTD) text in pieces, on a separate producer
+ * thread, while the calling thread consumes the pieces already decompressed. at most
+ * DECOMPRESS_QUEUE pieces wait at any time, so memory stays bounded whatever the text's size.
+ */
+class Decompressor
+{
+private:
+    /**
+     * points at the compressed bytes.
+     */
+    const char *_data;
+
+    /**
+     * represents the number of compressed bytes.
+     */
+    size_t _size;
+
+    /**
+     * holds the decompressed pieces not consumed yet (and _pool the consumed ones, for reuse).
+     */
+    std::deque<std::string> _ready, _pool;
+
+    /**
+     * true once the producer has pushed its last piece.
+     */
+    bool _done = false;
+
+    /**
+     * true if the producer decompressed the whole text.
+     */
+    bool _good = false;
+
+    /**
+     * true once the consumer stopped (its callback threw): the producer then stops at its next
+     * piece.
+     */
+    bool _cancelled = false;
+
+    /**
+     * guard the queues and the flags.
+     */
+    std::mutex _mutex;
+    std::condition_variable _changed;
+
+    /**
+     * @return an empty piece to decompress into (waits while DECOMPRESS_QUEUE pieces wait), or an
+     * empty string if the consumer stopped.
+     */
+    std::string _take();
+
+    /**
+     * hands a decompressed piece to the consumer.
+     * @param piece: the piece.
+     */
+    void _push(std::string &&piece);
+
+    /**
+     * decompresses the whole text (the producer thread).
+     */
+    void _produce();
+
+    /**
+     * decompresses a gzip (or zlib) text, made of one or more members.
+     * @return true if the text is well formed.
+     */
+    bool _inflate();
+
+    /**
+     * decompresses a zstd text, made of one or more frames.
+     * @return true if the text is well formed.
+     */
+    bool _unzstd();
+
+public:
+    /**
+     * constructs a decompressor of a compressed text.
+     * @param data: the compressed bytes (must outlive the decompressor).
+     * @param size: the number of bytes.
+     */
+    Decompressor(const char *data, size_t size): _data(data), _size(size) {}
+
+    Decompressor(const Decompressor &other) = delete;
+    Decompressor &operator=(const Decompressor &other) = delete;
+
+    /**
+     * @param data: the bytes of a text.
+     * @param size: the number of bytes.
+     * @return the text's format (by its magic number).
+     */
+    static Compression detect(const char *data, size_t size);
+
+    /**
+     * decompresses the text, and calls <onChunk> with every decompressed piece, in order, on the
+     * calling thread. if <onChunk> throws, the producer is stopped and joined before the exception
+     * propagates.
+     * @param onChunk: callable receiving a piece's bytes and their number.
+     * @return true if the whole text was decompressed.
+     */
+    bool forEachChunk(const std::function<void(const char *, size_t)> &onChunk);
+};
+
+#endif //EX2_DECOMPRESSOR_H
@@ -0,0 +1,79 @@
+//
+// Created by baraloni, ex2 cpp 2018-19 winter semester.
+// contains the one-pass feature extraction (frequent words and hashed n-grams) of a text.
+//
+
+#include "FeatureExtractor.h"
+#include <algorithm>
+
+/**
+ * constructs an extractor.
+ * @param words: the frequent words and their indexes (must outlive the extractor).
+ * @param config: the hashed features.
+ * @param separators: the characters that separate words.
+ */
+FeatureExtractor::FeatureExtractor(const Vocabulary &words, const FeatureConfig &config,
+                                   const char *separators):
+    _words(words), _config(config)
+{
+    _config.wordN = std::min(_config.wordN, (unsigned int) FEATURE_MAX_ORDER);
+    _config.charN = std::min(_config.charN, (unsigned int) FEATURE_MAX_ORDER);
+    _config.bits = std::max(1u, std::min(_config.bits, (unsigned int) FEATURE_MAX_BITS));
+    std::fill(_isSeparator, _isSeparator + 256, false);
+    if (!_config.unicode)
+    {
+        for (const char *c = separators; *c != '\0'; ++c)
+        {
+            _isSeparator[(unsigned char) *c] = true;
+        }
+    }
+    std::fill(_delimLow, _delimLow + 16, 0);
+    std::fill(_delimHigh, _delimHigh + 16, 0);
+    for (unsigned int c = 0; c < 0x80; ++c)
+    {
+        if (_config.unicode && (delimiterClass(c) & _config.delimiters))
+        {
+            _isSeparator[c] = true;
+            _delimLow[c & 15] |= (unsigned char) (1u << (c >> 4));
+        }
+    }
+    for (unsigned int h = 0; h < 8; ++h)
+    {
+        _delimHigh[h] = (unsigned char) (1u << h);
+    }
+    for (unsigned int i = 1; i < _config.charN; ++i)
+    {
+        _outFactor *= FNV_PRIME;
+    }
+}
+
+/**
+ * adds the features of <text> to <freq>.
+ * @param text: the text's bytes.
+ * @param length: the number of bytes.
+ * @param freq: vector of length size().
+ */
+void FeatureExtractor::extract(const char *text, const size_t length, std::vector<int> &freq) const
+{
+    forEachFeature(text, length, [&freq](size_t feature) { ++freq[feature]; });
+}
+
+/**
+ * @param text: the text's bytes.
+ * @param length: the number of bytes.
+ * @return the index of the last byte of <text> that surely ends a word (so the text can be
+ *         split there), or std::string::npos if there is none.
+ */
+size_t FeatureExtractor::lastBoundary(const char *text, const size_t length) const
+{
+    for (size_t i = length; i > 0; --i)
+    {
+        // with the unicode tokenizer only ascii delimiters are looked for: they never fall inside
+        // a utf-8 character.
+        if (_isSeparator[(unsigned char) text[i - 1]])
+        {
+            return i - 1;
+        }
+    }
+    return std::string::npos;
+}
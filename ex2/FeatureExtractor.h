@@ -0,0 +1,417 @@
+//
+// Created by baraloni, ex2 cpp 2018-19 winter semester.
+// contains the one-pass feature extraction (frequent words and hashed n-grams) of a text.
+//
+
+#ifndef EX2_FEATUREEXTRACTOR_H
+#define EX2_FEATUREEXTRACTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
+#include "Vocabulary.h"
+#include "Utf8.h"
+
+/** the highest word or character n-gram order.*/
+#define FEATURE_MAX_ORDER 8
+/** default log2 of the number of hashed features.*/
+#define FEATURE_DEFAULT_BITS 14
+/** the highest log2 of the number of hashed features.*/
+#define FEATURE_MAX_BITS 24
+
+/**
+ * represents which features are extracted from a text, besides the frequent words.
+ */
+struct FeatureConfig
+{
+    /** hash the word n-grams of orders 1 to wordN (0 for none).*/
+    unsigned int wordN = 0;
+    /** hash the character n-grams of order charN (0 for none).*/
+    unsigned int charN = 0;
+    /** log2 of the number of hashed features (the table's size is fixed, whatever the vocabulary).*/
+    unsigned int bits = FEATURE_DEFAULT_BITS;
+    /** true to split utf-8 text by delimiter classes and fold its case (unicode simple folding),
+     * rather than split it by the separator characters and lower-case its ascii letters.*/
+    bool unicode = false;
+    /** the unicode tokenizer's delimiter classes (DELIM_* flags).*/
+    unsigned int delimiters = DELIM_SPACE | DELIM_PUNCT;
+
+    /**
+     * @return true if any n-gram is hashed.
+     */
+    inline bool hashed() const {return wordN > 0 || charN > 0;}
+};
+
+/**
+ * turns a text into feature indexes, in a single pass over its bytes.
+ * the features are the frequent words (indexes 0 to words.size() - 1), followed by a fixed-size
+ * table of hashed features: word n-grams (hashes of consecutive words, combined) and character
+ * n-grams (a rolling hash over the text, with every run of separators read as one space).
+ * words are lower-cased (ascii), and separated by the supplied separator characters; or, with the
+ * unicode tokenizer, case folded and separated by the characters of the delimiter classes.
+ */
+class FeatureExtractor
+{
+private:
+    /**
+     * holds the frequent words, and their indexes.
+     */
+    const Vocabulary &_words;
+
+    /**
+     * represents the hashed features.
+     */
+    FeatureConfig _config;
+
+    /**
+     * true for the bytes that separate words (only ascii ones, with the unicode tokenizer).
+     */
+    bool _isSeparator[256];
+
+    /**
+     * the unicode tokenizer's ascii delimiters, as nibble tables: an ascii byte c is a delimiter
+     * iff _delimLow[c & 15] & _delimHigh[c >> 4] isn't 0 (_delimHigh[h] is bit h).
+     */
+    alignas(16) unsigned char _delimLow[16];
+    alignas(16) unsigned char _delimHigh[16];
+
+    /**
+     * represents B^(charN - 1), for removing the oldest character from the rolling hash.
+     */
+    uint64_t _outFactor = 1;
+
+    /**
+     * @param hash: hash of a feature.
+     * @param seed: the feature's kind.
+     * @return the feature's index in the hashed table (after the frequent words).
+     */
+    inline size_t _slot(uint64_t hash, uint64_t seed) const
+    {
+        hash = (hash ^ (seed * 0xC2B2AE3D27D4EB4FULL)) * 0x9E3779B97F4A7C15ULL;
+        return _words.size() + (size_t) (hash >> (64 - _config.bits));
+    }
+
+    /**
+     * splits <text> into lower-cased words, in one pass over its bytes.
+     * @param text: the text's bytes.
+     * @param length: the number of bytes.
+     * @param onChar: callable receiving every lower-cased character, and a single ' ' for every
+     *                run of separators between two words.
+     * @param onWord: callable receiving every word and its FNV-1a hash.
+     */
+    template <typename C, typename W>
+    void _scan(const char *text, size_t length, C onChar, W onWord) const;
+
+    /**
+     * splits utf-8 <text> into case folded words, like _scan. bytes that aren't valid utf-8 separate
+     * words. runs of 16 ascii bytes are classified and lower-cased at once (with ssse3).
+     * @param text: the text's bytes.
+     * @param length: the number of bytes.
+     * @param onChar: callable receiving every byte of the folded characters, and a single ' ' for
+     *                every run of delimiters between two words.
+     * @param onWord: callable receiving every word and its FNV-1a hash.
+     */
+    template <typename C, typename W>
+    void _scanUnicode(const char *text, size_t length, C onChar, W onWord) const;
+
+public:
+    /**
+     * constructs an extractor.
+     * @param words: the frequent words and their indexes (must outlive the extractor).
+     * @param config: the hashed features.
+     * @param separators: the characters that separate words.
+     */
+    FeatureExtractor(const Vocabulary &words, const FeatureConfig &config, const char *separators);
+
+    /**
+     * @return the number of features (the length of the frequency vectors).
+     */
+    inline size_t size() const
+    {
+        return _words.size() + (_config.hashed() ? (size_t(1) << _config.bits) : 0);
+    }
+
+    /**
+     * @param text: the text's bytes.
+     * @param length: the number of bytes.
+     * @return the index of the last byte of <text> that surely ends a word (so the text can be
+     *         split there), or std::string::npos if there is none.
+     */
+    size_t lastBoundary(const char *text, size_t length) const;
+
+    /**
+     * calls <onWord> with every lower-cased word in <text>.
+     * @param text: the text's bytes.
+     * @param length: the number of bytes.
+     * @param onWord: callable receiving a word (std::string const&).
+     */
+    template <typename F>
+    void forEachWord(const char *text, size_t length, F onWord) const;
+
+    /**
+     * calls <onFeature> with the index of every feature in <text>.
+     * n-grams don't span two calls (every call starts a new text).
+     * @param text: the text's bytes.
+     * @param length: the number of bytes.
+     * @param onFeature: callable receiving a feature index.
+     */
+    template <typename F>
+    void forEachFeature(const char *text, size_t length, F onFeature) const;
+
+    /**
+     * adds the features of <text> to <freq>.
+     * @param text: the text's bytes.
+     * @param length: the number of bytes.
+     * @param freq: vector of length size().
+     */
+    void extract(const char *text, size_t length, std::vector<int> &freq) const;
+};
+
+/**
+ * splits <text> into lower-cased words, in one pass over its bytes.
+ * @param text: the text's bytes.
+ * @param length: the number of bytes.
+ * @param onChar: callable receiving every lower-cased character, and a single ' ' for every run
+ *                of separators between two words.
+ * @param onWord: callable receiving every word and its FNV-1a hash.
+ */
+template <typename C, typename W>
+void FeatureExtractor::_scan(const char *text, const size_t length, C onChar, W onWord) const
+{
+    std::string word;
+    uint64_t wordHash = FNV_OFFSET;
+    bool afterSeparator = true;
+    for (size_t i = 0; i <= length; ++i)
+    {
+        const bool separator = (i == length) || _isSeparator[(unsigned char) text[i]];
+        if (!separator)
+        {
+            char c = text[i];
+            c = (c >= 'A' && c <= 'Z') ? (char) (c - 'A' + 'a') : c;
+            word.push_back(c);
+            wordHash = (wordHash ^ (unsigned char) c) * FNV_PRIME;
+            onChar((unsigned char) c);
+        }
+        else
+        {
+            if (!word.empty())
+            {
+                onWord(word, wordHash);
+                word.clear();
+                wordHash = FNV_OFFSET;
+            }
+            if (!afterSeparator && i < length)
+            {
+                onChar((unsigned char) ' ');
+            }
+        }
+        afterSeparator = separator;
+    }
+}
+
+/**
+ * splits utf-8 <text> into case folded words, like _scan. bytes that aren't valid utf-8 separate
+ * words. runs of 16 ascii bytes are classified and lower-cased at once (with ssse3).
+ * @param text: the text's bytes.
+ * @param length: the number of bytes.
+ * @param onChar: callable receiving every byte of the folded characters, and a single ' ' for
+ *                every run of delimiters between two words.
+ * @param onWord: callable receiving every word and its FNV-1a hash.
+ */
+template <typename C, typename W>
+void FeatureExtractor::_scanUnicode(const char *text, const size_t length, C onChar, W onWord) const
+{
+    const auto *bytes = reinterpret_cast<const unsigned char *>(text);
+    std::string word;
+    uint64_t wordHash = FNV_OFFSET;
+    bool afterSeparator = true;
+    auto append = [&](const unsigned char c)
+    {
+        word.push_back((char) c);
+        wordHash = (wordHash ^ c) * FNV_PRIME;
+        onChar(c);
+        afterSeparator = false;
+    };
+    auto separate = [&]()
+    {
+        if (!afterSeparator)
+        {
+            onWord(word, wordHash);
+            word.clear();
+            wordHash = FNV_OFFSET;
+            onChar((unsigned char) ' ');
+            afterSeparator = true;
+        }
+    };
+
+    size_t i = 0;
+#ifdef __SSSE3__
+    const __m128i low = _mm_load_si128(reinterpret_cast<const __m128i *>(_delimLow));
+    const __m128i high = _mm_load_si128(reinterpret_cast<const __m128i *>(_delimHigh));
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    alignas(16) unsigned char lowered[16];
+#endif
+    while (i < length)
+    {
+#ifdef __SSSE3__
+        if (i + 16 <= length)
+        {
+            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(bytes + i));
+            if (_mm_movemask_epi8(chunk) == 0) // all ascii.
+            {
+                const __m128i classes = _mm_and_si128(
+                        _mm_shuffle_epi8(low, _mm_and_si128(chunk, nibble)),
+                        _mm_shuffle_epi8(high, _mm_and_si128(_mm_srli_epi16(chunk, 4), nibble)));
+                const unsigned int delimiters =
+                        ~(unsigned int) _mm_movemask_epi8(_mm_cmpeq_epi8(classes, _mm_setzero_si128()));
+                const __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(chunk, _mm_set1_epi8('A' - 1)),
+                                                    _mm_cmplt_epi8(chunk, _mm_set1_epi8('Z' + 1)));
+                _mm_store_si128(reinterpret_cast<__m128i *>(lowered),
+                                _mm_add_epi8(chunk, _mm_and_si128(upper, _mm_set1_epi8(0x20))));
+                for (unsigned int k = 0; k < 16; ++k)
+                {
+                    if ((delimiters >> k) & 1u)
+                    {
+                        separate();
+                    }
+                    else
+                    {
+                        append(lowered[k]);
+                    }
+                }
+                i += 16;
+                continue;
+            }
+        }
+#endif
+        if (bytes[i] < 0x80)
+        {
+            if (_isSeparator[bytes[i]])
+            {
+                separate();
+            }
+            else
+            {
+                append((unsigned char) foldCase(bytes[i]));
+            }
+            ++i;
+            continue;
+        }
+        uint32_t codePoint;
+        const size_t size = utf8Decode(bytes + i, length - i, codePoint);
+        if (size == 0 || (delimiterClass(codePoint) & _config.delimiters))
+        {
+            separate();
+            i += (size == 0) ? 1 : size;
+            continue;
+        }
+        char folded[4];
+        const size_t foldedSize = utf8Encode(foldCase(codePoint), folded);
+        for (size_t k = 0; k < foldedSize; ++k)
+        {
+            append((unsigned char) folded[k]);
+        }
+        i += size;
+    }
+    if (!afterSeparator)
+    {
+        onWord(word, wordHash);
+    }
+}
+
+/**
+ * calls <onWord> with every lower-cased word in <text>.
+ * @param text: the text's bytes.
+ * @param length: the number of bytes.
+ * @param onWord: callable receiving a word (std::string const&).
+ */
+template <typename F>
+void FeatureExtractor::forEachWord(const char *text, const size_t length, F onWord) const
+{
+    auto onChar = [](unsigned char) {};
+    auto onHashedWord = [&onWord](const std::string &word, uint64_t) { onWord(word); };
+    if (_config.unicode)
+    {
+        _scanUnicode(text, length, onChar, onHashedWord);
+    }
+    else
+    {
+        _scan(text, length, onChar, onHashedWord);
+    }
+}
+
+/**
+ * calls <onFeature> with the index of every feature in <text>.
+ * n-grams don't span two calls (every call starts a new text).
+ * @param text: the text's bytes.
+ * @param length: the number of bytes.
+ * @param onFeature: callable receiving a feature index.
+ */
+template <typename F>
+void FeatureExtractor::forEachFeature(const char *text, const size_t length, F onFeature) const
+{
+    const unsigned int wordN = _config.wordN, charN = _config.charN;
+    uint64_t recentWords[FEATURE_MAX_ORDER];
+    unsigned long wordsSeen = 0;
+    unsigned char window[FEATURE_MAX_ORDER];
+    unsigned int filled = 0, oldest = 0;
+    uint64_t rolling = 0;
+
+    auto onChar = [&](unsigned char c)
+    {
+        if (charN == 0)
+        {
+            return;
+        }
+        if (filled == charN)
+        {
+            rolling -= window[oldest] * _outFactor;
+        }
+        else
+        {
+            ++filled;
+        }
+        rolling = rolling * FNV_PRIME + c;
+        window[oldest] = c;
+        oldest = (oldest + 1) % charN;
+        if (filled == charN)
+        {
+            onFeature(_slot(rolling, FEATURE_MAX_ORDER + charN));
+        }
+    };
+
+    auto onWord = [&](const std::string &word, uint64_t wordHash)
+    {
+        const unsigned long frequentWord = _words.find(word, wordHash);
+        if (frequentWord != VOCAB_MISSING)
+        {
+            onFeature(frequentWord);
+        }
+        if (wordN > 0)
+        {
+            recentWords[wordsSeen % wordN] = wordHash;
+            ++wordsSeen;
+            uint64_t gram = 0;
+            for (unsigned int order = 1; order <= wordN && order <= wordsSeen; ++order)
+            {
+                gram = gram * FNV_PRIME + recentWords[(wordsSeen - order) % wordN];
+                onFeature(_slot(gram, order));
+            }
+        }
+    };
+
+    if (_config.unicode)
+    {
+        _scanUnicode(text, length, onChar, onWord);
+    }
+    else
+    {
+        _scan(text, length, onChar, onWord);
+    }
+}
+
+#endif //EX2_FEATUREEXTRACTOR_H
@@ -0,0 +1,85 @@
+//
+// Created by baraloni, ex2 cpp 2018-19 winter semester.
+// contains the pipelined reading of a list of files.
+//
+
+#include "FilePrefetcher.h"
+
+/**
+ * reads files until the list ends (a reader thread).
+ */
+void FilePrefetcher::_read()
+{
+    while (true)
+    {
+        size_t index;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _changed.wait(lock, [this]
+            {
+                return _stop || _nextRead >= _paths.size() || _nextRead < _nextConsumed + _window;
+            });
+            if (_stop || _nextRead >= _paths.size())
+            {
+                return;
+            }
+            index = _nextRead++;
+        }
+        // populated, so the reading happens here rather than on the consumer's first touch.
+        std::unique_ptr<MappedFile> file(new MappedFile(_paths[index], true));
+        std::lock_guard<std::mutex> lock(_mutex);
+        _files[index] = std::move(file);
+        _changed.notify_all();
+    }
+}
+
+/**
+ * starts reading the files at <paths>.
+ * @param paths: the files' paths.
+ * @param readers: number of reader threads (0 to read every file on the consumer's thread).
+ */
+FilePrefetcher::FilePrefetcher(const std::vector<std::string> &paths, const unsigned int readers):
+    _paths(paths), _files(paths.size()), _window((size_t) readers * PREFETCH_WINDOW_PER_READER)
+{
+    for (unsigned int i = 0; i < readers && i < paths.size(); ++i)
+    {
+        _readers.emplace_back(&FilePrefetcher::_read, this);
+    }
+}
+
+/**
+ * stops the readers.
+ */
+FilePrefetcher::~FilePrefetcher()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+        _changed.notify_all();
+    }
+    for (std::thread &reader : _readers)
+    {
+        reader.join();
+    }
+}
+
+/**
+ * @return the next file in the list (waits until it is read), or null after the last one.
+ *         a file that can't be read is returned too, and tests false.
+ */
+std::unique_ptr<MappedFile> FilePrefetcher::next()
+{
+    if (_nextConsumed >= _paths.size())
+    {
+        return nullptr;
+    }
+    if (_readers.empty())
+    {
+        return std::unique_ptr<MappedFile>(new MappedFile(_paths[_nextConsumed++]));
+    }
+    std::unique_lock<std::mutex> lock(_mutex);
+    _changed.wait(lock, [this] { return _files[_nextConsumed] != nullptr; });
+    std::unique_ptr<MappedFile> file = std::move(_files[_nextConsumed++]);
+    _changed.notify_all();
+    return file;
+}
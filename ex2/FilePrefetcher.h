@@ -0,0 +1,96 @@
+//
+// Created by baraloni, ex2 cpp 2018-19 winter semester.
+// contains the pipelined reading of a list of files.
+//
+
+#ifndef EX2_FILEPREFETCHER_H
+#define EX2_FILEPREFETCHER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "MappedFile.h"
+
+/** default number of reader threads.*/
+#define PREFETCH_DEFAULT_READERS 4
+/** number of files read ahead of the consumer, per reader thread.*/
+#define PREFETCH_WINDOW_PER_READER 2
+
+/**
+ * reads a list of files on a pool of reader threads, while the caller consumes the files already
+ * read, in the list's order. the readers stay at most a window of files ahead of the consumer, so
+ * the memory held stays flat however long the list is.
+ */
+class FilePrefetcher
+{
+private:
+    /**
+     * holds the files' paths.
+     */
+    std::vector<std::string> _paths;
+
+    /**
+     * holds the files read and not consumed yet, by their index in _paths.
+     */
+    std::vector<std::unique_ptr<MappedFile>> _files;
+
+    /**
+     * represents the number of files read ahead of the consumer, at most.
+     */
+    size_t _window;
+
+    /**
+     * represent the index of the next file to read, and of the next file to consume.
+     */
+    size_t _nextRead = 0;
+    size_t _nextConsumed = 0;
+
+    /**
+     * true once the prefetcher is destroyed (the readers stop).
+     */
+    bool _stop = false;
+
+    /**
+     * guard the indexes and _files.
+     */
+    std::mutex _mutex;
+    std::condition_variable _changed;
+
+    /**
+     * holds the reader threads.
+     */
+    std::vector<std::thread> _readers;
+
+    /**
+     * reads files until the list ends (a reader thread).
+     */
+    void _read();
+
+public:
+    /**
+     * starts reading the files at <paths>.
+     * @param paths: the files' paths.
+     * @param readers: number of reader threads (0 to read every file on the consumer's thread).
+     */
+    FilePrefetcher(const std::vector<std::string> &paths, unsigned int readers);
+
+    /**
+     * stops the readers.
+     */
+    ~FilePrefetcher();
+
+    FilePrefetcher(const FilePrefetcher &other) = delete;
+    FilePrefetcher &operator=(const FilePrefetcher &other) = delete;
+
+    /**
+     * @return the next file in the list (waits until it is read), or null after the last one.
+     *         a file that can't be read is returned too, and tests false.
+     */
+    std::unique_ptr<MappedFile> next();
+};
+
+#endif //EX2_FILEPREFETCHER_H
@@ -0,0 +1,20 @@
+//
+// Created by baraloni, ex2 cpp 2018-19 winter semester.
+// prints foldCase over the basic multilingual plane, for FoldCheck.py to compare against python's
+// unicodedata.
+//
+
+#include "Utf8.h"
+#include <cstdio>
+
+/**
+ * prints every character of U+0000-FFFF and its fold, as "<hex code point> <hex fold>" lines.
+ */
+int main()
+{
+    for (uint32_t c = 0; c <= 0xFFFF; ++c)
+    {
+        printf("%x %x\n", c, foldCase(c));
+    }
+    return 0;
+}
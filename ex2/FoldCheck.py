@@ -0,0 +1,50 @@
+#
+# Created by baraloni, ex2 cpp 2018-19 winter semester.
+# compares foldCase (as printed by foldCheck) against python's unicodedata simple case folding:
+# ./foldCheck | python3 FoldCheck.py
+#
+
+import sys
+import unicodedata
+
+# the blocks foldCase covers (see Utf8.h): every other character must fold to itself.
+COVERED = [(0x0000, 0x024F), (0x0345, 0x0345), (0x0370, 0x03FF), (0x0400, 0x052F),
+           (0x0531, 0x0556), (0x1E00, 0x1EFF), (0xFF21, 0xFF3A)]
+
+# the simple folds (CaseFolding.txt's S entries) of covered characters whose full fold is longer.
+SIMPLE = {0x1E9E: 0xDF}
+
+
+def expected(c):
+    """
+    @param c: a code point.
+    @return the code point's simple case folding, where foldCase covers it, otherwise c.
+    """
+    if not any(first <= c <= last for first, last in COVERED):
+        return c
+    if c in SIMPLE:
+        return SIMPLE[c]
+    folded = chr(c).casefold()
+    return ord(folded) if len(folded) == 1 else c
+
+
+def main():
+    """
+    reads the "<code point> <fold>" lines, prints the first mismatches, and exits with failure
+    if there are any.
+    """
+    checked = failures = 0
+    for line in sys.stdin:
+        c, fold = (int(field, 16) for field in line.split())
+        checked += 1
+        if fold != expected(c):
+            failures += 1
+            if failures <= 10:
+                print("failed: U+%04X folds to U+%04X, not U+%04X" % (c, fold, expected(c)))
+    if failures > 0 or checked == 0:
+        print("%d of %d folds failed (unicode %s)" % (failures, checked, unicodedata.unidata_version))
+        sys.exit(1)
+    print("all %d folds match unicode %s" % (checked, unicodedata.unidata_version))
+
+
+main()
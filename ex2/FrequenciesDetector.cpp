@@ -0,0 +1,429 @@
+//
+// Created by baraloni, ex2 cpp 2018-19 winter semester.
+// contains the frequent-words author detector used by find_the_author.
+//
+
+#include "FrequenciesDetector.h"
+#include <algorithm>
+#include <cctype>
+#include <iostream>
+#include <iterator>
+
+//---------------------Helpers:
+
+/**
+ * reads the words in <inFile>, and stores them in a _fw without duplications.
+ * each word is associated to a unique, non-negative int.
+ * those ints are consistent (all int from 0 to (numberOfUniqueWords - 1) appear).
+ * assumption: the words in <inFile> are lowercased.
+ * @param inFile: the file containing the words.
+ */
+void FrequenciesDetector::_storeFrequentWords(std::istream &inFile)
+{
+    std::string currentWord;
+    if (inFile)
+    {
+        while (inFile >> currentWord)
+        {
+            _fw.insert(currentWord); //no-op for duplicates
+        }
+    }
+}
+
+/**
+ * stores the whitespace separated words in <text> in _fw, like _storeFrequentWords(istream&).
+ * @param text: the words' bytes.
+ * @param length: the number of bytes.
+ */
+void FrequenciesDetector::_storeFrequentWords(const char *text, const size_t length)
+{
+    size_t i = 0;
+    while (i < length)
+    {
+        while (i < length && std::isspace((unsigned char) text[i]))
+        {
+            ++i;
+        }
+        const size_t start = i;
+        while (i < length && !std::isspace((unsigned char) text[i]))
+        {
+            ++i;
+        }
+        if (i > start)
+        {
+            _fw.insert(std::string_view(text + start, i - start)); //no-op for duplicates
+        }
+    }
+}
+
+/**
+ * @param f: in-stream.
+ * @return a vector representing the frequencies in f, according to _fw keying.
+ */
+const std::vector<int> FrequenciesDetector::_getFrequency(std::istream &f) const
+{
+    const std::string text((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+    if (_stats)
+    {
+        _stats->lap(&FileStats::readMs);
+    }
+    return _getFrequency(text.data(), text.size());
+}
+
+/**
+ * adds the frequencies of an uncompressed text to <freqVec> (timing and counting them, if
+ * instrumented).
+ * @param text: the text's bytes.
+ * @param length: the number of bytes.
+ * @param freqVec: the frequencies.
+ */
+void FrequenciesDetector::_count(const char *text, const size_t length, std::vector<int> &freqVec) const
+{
+    if (!_stats)
+    {
+        _extractor.extract(text, length, freqVec);
+        return;
+    }
+    // tokenizing and looking up are a single pass: time a tokenize-only pass, and charge the rest
+    // of the full pass to the lookups.
+    FileStats &record = _stats->current();
+    const double tokenizeStart = record.tokenizeMs;
+    _extractor.forEachWord(text, length, [&record](const std::string &) { ++record.tokens; });
+    _stats->lap(&FileStats::tokenizeMs);
+    const double tokenizeMs = record.tokenizeMs - tokenizeStart, lookupStart = record.lookupMs;
+    const std::vector<int> before(freqVec.begin(), freqVec.begin() + _fw.size());
+    _extractor.extract(text, length, freqVec);
+    _stats->lap(&FileStats::lookupMs);
+    record.lookupMs = lookupStart + std::max(0.0, record.lookupMs - lookupStart - tokenizeMs);
+    for (size_t i = 0; i < _fw.size(); ++i)
+    {
+        record.matched += freqVec[i] - before[i];
+    }
+}
+
+/**
+ * @param text: the text's bytes (gzip and zstd texts are decompressed on the fly).
+ * @param length: the number of bytes.
+ * @return a vector representing the frequencies in the text, according to _fw keying
+ * (followed by the hashed n-grams, if any).
+ */
+const std::vector<int> FrequenciesDetector::_getFrequency(const char *text, const size_t length) const
+{
+    std::vector<int> freqVec(_extractor.size(), 0);
+    if (_stats)
+    {
+        _stats->current().bytes += length; // the bytes read (compressed, if the text is).
+    }
+    if (Decompressor::detect(text, length) == Compression::NONE)
+    {
+        _count(text, length, freqVec);
+        return freqVec;
+    }
+    // counts every decompressed piece up to its last separator, while the next one is decompressed
+    // (the rest may be the beginning of a word). like appendBase, n-grams don't span pieces.
+    std::string partial;
+    Decompressor decompressor(text, length);
+    const bool good = decompressor.forEachChunk([&](const char *chunk, size_t size)
+    {
+        if (_stats)
+        {
+            _stats->lap(&FileStats::readMs);
+        }
+        partial.append(chunk, size);
+        const size_t lastSeparator = _extractor.lastBoundary(partial.data(), partial.size());
+        if (lastSeparator != std::string::npos)
+        {
+            _count(partial.data(), lastSeparator, freqVec);
+            partial.erase(0, lastSeparator + 1);
+        }
+    });
+    _count(partial.data(), partial.size(), freqVec);
+    if (!good)
+    {
+        std::cerr << DECOMPRESS_ERR << std::endl;
+    }
+    return freqVec;
+}
+
+//---------------------Constructors:
+
+/**
+ * initializes a new FrequenciesDetector, that holds a map of frequent words given in <inFile>
+ * (and has no unknown text yet).
+ * @param inFile stream holding the frequent words.
+ * @param features the hashed n-grams counted besides the frequent words (none by default).
+ */
+FrequenciesDetector::FrequenciesDetector(std::istream &inFile, const FeatureConfig &features):
+    _extractor(_fw, features, SEPARATORS)
+{
+    _storeFrequentWords(inFile);
+    _base.setQuery(std::vector<int>(_extractor.size(), 0));
+    _authors = AuthorIndex(_extractor.size());
+}
+
+/**
+ * initializes a new FrequenciesDetector, that holds the frequent words in <wordsFile>: either
+ * a list of words, or a vocabulary serialized by words().save() (which is viewed in place).
+ * @param wordsFile the frequent words (kept mapped while the detector views it).
+ * @param features the hashed n-grams counted besides the frequent words (none by default).
+ */
+FrequenciesDetector::FrequenciesDetector(const std::shared_ptr<const MappedFile> &wordsFile,
+                                         const FeatureConfig &features):
+    _extractor(_fw, features, SEPARATORS)
+{
+    if (!Vocabulary::isSerialized(wordsFile->data(), wordsFile->size()))
+    {
+        _storeFrequentWords(wordsFile->data(), wordsFile->size());
+    }
+    else if (!_fw.load(wordsFile))
+    {
+        _good = false;
+    }
+    _base.setQuery(std::vector<int>(_extractor.size(), 0));
+    _authors = AuthorIndex(_extractor.size());
+}
+
+/**
+ * initializes a new FrequenciesDetector, that holds a map of frequent words given in <inFile>,
+ * and the unknown text given in <baseFile>.
+ * @param inFile stream holding the frequent words.
+ * @param baseFile stream holding the unknown text.
+ */
+FrequenciesDetector::FrequenciesDetector(std::istream &inFile, std::istream &baseFile):
+    FrequenciesDetector(inFile)
+{
+    setBase(baseFile);
+}
+
+//---------------------Methods:
+
+/**
+ * replaces the unknown text with the one in <baseFile>.
+ * @param baseFile stream holding the unknown text.
+ */
+void FrequenciesDetector::setBase(std::istream &baseFile)
+{
+    _base.setQuery(_getFrequency(baseFile));
+}
+
+/**
+ * replaces the unknown text with the one in <baseFile>.
+ * @param baseFile the unknown text.
+ */
+void FrequenciesDetector::setBase(const MappedFile &baseFile)
+{
+    _base.setQuery(_getFrequency(baseFile.data(), baseFile.size()));
+}
+
+/**
+ * stores the frequencies of <f> (without scoring or printing anything).
+ * @param f : in file stream.
+ * @param fName : f's name (as given to the program).
+ */
+void FrequenciesDetector::addAuthor(std::istream &f, const std::string &fName)
+{
+    _authors.add(fName, _getFrequency(f));
+}
+
+/**
+ * stores the frequencies of <f> (without scoring or printing anything).
+ * @param f : file.
+ * @param fName : f's name (as given to the program).
+ */
+void FrequenciesDetector::addAuthor(const MappedFile &f, const std::string &fName)
+{
+    _authors.add(fName, _getFrequency(f.data(), f.size()));
+}
+
+/**
+ * computes the distance between this file and the base file.
+ * prints it at the format: "<fName> <distance>\n".
+ * @param f : in file stream.
+ * @param fName : f's name (as given to the program).
+ */
+void FrequenciesDetector::processFile(std::istream &f, const std::string &fName)
+{
+    const std::vector<int> freq = _getFrequency(f);
+    double dist = _base.score(freq);
+    _authors.add(fName, freq);
+    if (_stats)
+    {
+        _stats->lap(&FileStats::scoreMs);
+    }
+
+    std::cout << fName << " " << dist << std::endl;
+}
+
+/**
+ * computes the distance between this file and the base file.
+ * prints it at the format: "<fName> <distance>\n".
+ * @param f : file.
+ * @param fName : f's name (as given to the program).
+ */
+void FrequenciesDetector::processFile(const MappedFile &f, const std::string &fName)
+{
+    const std::vector<int> freq = _getFrequency(f.data(), f.size());
+    double dist = _base.score(freq);
+    _authors.add(fName, freq);
+    if (_stats)
+    {
+        _stats->lap(&FileStats::scoreMs);
+    }
+
+    std::cout << fName << " " << dist << std::endl;
+}
+
+/**
+ * prints the greatest distanced file (among the files that has been entered up to this point)
+ * in the format: "Best matching author is <fName> score <distance>\n".
+ */
+void FrequenciesDetector::maxDistance() const
+{
+    const AuthorMatch best = _authors.topK(_base, 1).front();
+    // i assume frequent_words and unknown exists (so max element->first isn't " " like in school sol).
+    std::cout << "Best matching author is " << best.name <<
+         " score " << best.score << std::endl;
+}
+
+/**
+ * builds the approximate search tables over the files processed up to this point.
+ * @param tables: number of hash tables.
+ * @param bits: number of bits in a signature.
+ */
+void FrequenciesDetector::buildApproxIndex(const unsigned int tables, const unsigned int bits)
+{
+    _authors.buildLsh(tables, bits);
+}
+
+/**
+ * prints the <k> closest files (among the files that has been entered up to this point),
+ * one per line, at the format: "<rank> <fName> <distance>\n".
+ * @param k: number of files to print.
+ * @param approx: true to use the approximate search tables (if they were built).
+ * @param recall: true to also print the recall of the approximate search, at the format:
+ *                "Recall@<k> <recall>\n".
+ */
+void FrequenciesDetector::topDistances(const size_t k, const bool approx, const bool recall) const
+{
+    const std::vector<AuthorMatch> exact = _authors.topK(_base, k);
+    const std::vector<AuthorMatch> found = approx ? _authors.approxTopK(_base, k) : exact;
+    std::cout << "Top " << k << " matching authors:" << std::endl;
+    for (size_t i = 0; i < found.size(); ++i)
+    {
+        std::cout << i + 1 << " " << found[i].name << " " << found[i].score << std::endl;
+    }
+    if (recall)
+    {
+        std::cout << "Recall@" << k << " " << AuthorIndex::recall(exact, found) << std::endl;
+    }
+}
+
+/**
+ * ranks the processed files by their distance from the text in <f>, without touching the
+ * base file (safe to call concurrently).
+ * @param f: in-stream holding an unknown text.
+ * @param k: number of files to return.
+ * @param approx: true to use the approximate search tables (if they were built).
+ * @return the <k> closest files, closest first.
+ */
+std::vector<AuthorMatch> FrequenciesDetector::rank(std::istream &f, const size_t k,
+                                                   const bool approx) const
+{
+    const CosineKernel query(_getFrequency(f));
+    return approx ? _authors.approxTopK(query, k) : _authors.topK(query, k);
+}
+
+/**
+ * ranks the processed files by their distance from the text in <f>, without touching the
+ * base file (safe to call concurrently).
+ * @param f: file holding an unknown text.
+ * @param k: number of files to return.
+ * @param approx: true to use the approximate search tables (if they were built).
+ * @return the <k> closest files, closest first.
+ */
+std::vector<AuthorMatch> FrequenciesDetector::rank(const MappedFile &f, const size_t k,
+                                                   const bool approx) const
+{
+    const CosineKernel query(_getFrequency(f.data(), f.size()));
+    return approx ? _authors.approxTopK(query, k) : _authors.topK(query, k);
+}
+
+/**
+ * appends the frequencies of the unknown text in <f> to <queries>.
+ * @param f: file holding an unknown text.
+ * @param queries: a matrix returned by queryMatrix().
+ */
+void FrequenciesDetector::addQuery(const MappedFile &f, ProfileMatrix &queries) const
+{
+    queries.addRow(_getFrequency(f.data(), f.size()));
+}
+
+/**
+ * ranks the processed files by their distance from every text in <queries>, with all the
+ * distances computed as a single blocked matrix product (safe to call concurrently).
+ * @param queries: the unknown texts' frequencies.
+ * @param k: number of files to return per text.
+ * @return for every text (in order), its <k> closest files, closest first.
+ */
+std::vector<std::vector<AuthorMatch>> FrequenciesDetector::rankBatch(const ProfileMatrix &queries,
+                                                                     const size_t k) const
+{
+    std::vector<double> scores;
+    CosineKernel::scoreMatrix(queries, _authors.profiles(), scores);
+    const size_t n = _authors.size();
+    std::vector<std::vector<AuthorMatch>> ranks(queries.rows());
+    for (size_t i = 0; i < queries.rows(); ++i)
+    {
+        ranks[i] = _authors.topK(std::vector<double>(scores.begin() + i * n,
+                                                     scores.begin() + (i + 1) * n), k);
+    }
+    return ranks;
+}
+
+/**
+ * appends <text> to an unknown text that arrives in pieces, and updates its distance from
+ * every processed file (at a cost proportional to the words in <text>).
+ * a word split between two calls is counted once it is complete (n-grams don't span calls).
+ * @param text: the next piece of the unknown text.
+ */
+void FrequenciesDetector::appendBase(const std::string &text)
+{
+    if (!_stream)
+    {
+        _stream.reset(new StreamingScorer(_authors.profiles(), _fw.size()));
+    }
+    _partial += text;
+    size_t lastSeparator = _extractor.lastBoundary(_partial.data(), _partial.size());
+    if (lastSeparator == std::string::npos)
+    {
+        return;
+    }
+    StreamingScorer &stream = *_stream;
+    _extractor.forEachFeature(_partial.data(), lastSeparator,
+                              [&stream](size_t feature) { stream.count(feature); });
+    stream.commit();
+    _partial.erase(0, lastSeparator + 1);
+}
+
+/**
+ * counts the last word appended by appendBase (the unknown text has ended).
+ */
+void FrequenciesDetector::finishBase()
+{
+    appendBase(" ");
+}
+
+/**
+ * @param k: number of files to return.
+ * @return the <k> files closest to the text appended so far by appendBase, closest first.
+ */
+std::vector<AuthorMatch> FrequenciesDetector::streamingRank(const size_t k)
+{
+    if (!_stream)
+    {
+        appendBase("");
+    }
+    std::vector<double> scores;
+    _stream->scores(scores);
+    return _authors.topK(scores, k);
+}
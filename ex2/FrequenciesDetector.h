@@ -0,0 +1,314 @@
+//
+// Created by baraloni, ex2 cpp 2018-19 winter semester.
+// contains the frequent-words author detector used by find_the_author.
+//
+
+#ifndef EX2_FREQUENCIESDETECTOR_H
+#define EX2_FREQUENCIESDETECTOR_H
+
+//data structures:
+#include <memory>
+#include <string>
+#include <vector>
+//io:
+#include <istream>
+//other functionality:
+#include "CosineKernel.h"
+#include "AuthorIndex.h"
+#include "StreamingScorer.h"
+#include "FeatureExtractor.h"
+#include "MappedFile.h"
+#include "Instrumentation.h"
+#include "Decompressor.h"
+#include "Vocabulary.h"
+
+//constants:
+/**
+ * represents Os newline: in windows: \r\n. in linux: \n.
+ */
+#define OS_NL "\r\n"
+/**
+ * represents the characters that tell word bounds.
+ */
+#define SEPARATORS "\";:! ," OS_NL
+
+/**
+ * gets a stream containing a list of frequent words, a stream representing an anonymus text.
+ * can receive streams of authored texts, and compute their distance from the anonymus text
+ * in respect to the frequent words list.
+ * can output the closest author text.
+ */
+class FrequenciesDetector
+{
+private:
+    /**
+     * holds the frequent words as lower-cased, no duplications. each has a unique int
+     * (all int from 0 to numberOfUniqueWords - 1).
+     */
+    Vocabulary _fw; //interned flat table for more effective run
+
+    /**
+     * turns texts into frequency vectors (frequent words, and the configured hashed n-grams).
+     */
+    FeatureExtractor _extractor;
+
+    /**
+     * scores frequency vectors against the unknown author's frequencies (holds them and their norm).
+     */
+    CosineKernel _base;
+
+    /**
+     * holds the processed files' frequencies, by their names (duplicates are kept, and ties are
+     * broken by name, like the school solution does).
+     */
+    AuthorIndex _authors;
+
+    /**
+     * scores the unknown text read so far by appendBase (created by the first call).
+     */
+    std::unique_ptr<StreamingScorer> _stream;
+
+    /**
+     * holds the end of the text appended so far, that may be the beginning of a word.
+     */
+    std::string _partial;
+
+    /**
+     * records the stages of the file being processed (null when not instrumented).
+     */
+    Instrumentation *_stats = nullptr;
+
+    /**
+     * false if the frequent words file was a corrupt serialized vocabulary (no words are held).
+     */
+    bool _good = true;
+
+    /**
+     * reads the words in <inFile>, and stores them in a _fw without duplications.
+     * each word is associated to a unique, non-negative int.
+     * those ints are consistent (all int from 0 to (numberOfUniqueWords - 1) appear).
+     * assumption: the words in <inFile> are lowercased.
+     * @param inFile: the file containing the words.
+     */
+    void _storeFrequentWords(std::istream &inFile);
+
+    /**
+     * stores the whitespace separated words in <text> in _fw, like _storeFrequentWords(istream&).
+     * @param text: the words' bytes.
+     * @param length: the number of bytes.
+     */
+    void _storeFrequentWords(const char *text, size_t length);
+
+    /**
+     * @param f: in-stream.
+     * @return a vector representing the frequencies in f, according to _fw keying.
+     */
+    const std::vector<int> _getFrequency(std::istream &f) const;
+
+    /**
+     * adds the frequencies of an uncompressed text to <freqVec> (timing and counting them, if
+     * instrumented).
+     * @param text: the text's bytes.
+     * @param length: the number of bytes.
+     * @param freqVec: the frequencies.
+     */
+    void _count(const char *text, size_t length, std::vector<int> &freqVec) const;
+
+    /**
+     * @param text: the text's bytes (gzip and zstd texts are decompressed on the fly).
+     * @param length: the number of bytes.
+     * @return a vector representing the frequencies in the text, according to _fw keying
+     * (followed by the hashed n-grams, if any).
+     */
+    const std::vector<int> _getFrequency(const char *text, size_t length) const;
+
+public:
+
+    /**
+     * initializes a new FrequenciesDetector, that holds a map of frequent words given in <inFile>
+     * (and has no unknown text yet).
+     * @param inFile stream holding the frequent words.
+     * @param features the hashed n-grams counted besides the frequent words (none by default).
+     */
+    explicit FrequenciesDetector(std::istream &inFile, const FeatureConfig &features = FeatureConfig());
+
+    /**
+     * initializes a new FrequenciesDetector, that holds the frequent words in <wordsFile>: either
+     * a list of words, or a vocabulary serialized by words().save() (which is viewed in place).
+     * @param wordsFile the frequent words (kept mapped while the detector views it).
+     * @param features the hashed n-grams counted besides the frequent words (none by default).
+     */
+    explicit FrequenciesDetector(const std::shared_ptr<const MappedFile> &wordsFile,
+                                 const FeatureConfig &features = FeatureConfig());
+
+    /**
+     * initializes a new FrequenciesDetector, that holds a map of frequent words given in <inFile>,
+     * and the unknown text given in <baseFile>.
+     * @param inFile stream holding the frequent words.
+     * @param baseFile stream holding the unknown text.
+     */
+    FrequenciesDetector(std::istream &inFile, std::istream &baseFile);
+
+    /**
+     * @return false if the frequent words file was a corrupt serialized vocabulary (then every
+     * score would be 0, so the caller should report the error instead of using this detector).
+     */
+    inline bool good() const {return _good;}
+
+    /**
+     * records the cost of the files processed from now on into <stats> (the caller begins and ends
+     * every file's record; this detector times the stages it runs, and counts the words).
+     * counting costs an extra tokenization pass per file.
+     * @param stats: the instrumentation (null to stop recording).
+     */
+    inline void setStats(Instrumentation *stats) {_stats = (stats && stats->enabled()) ? stats : nullptr;}
+
+    /**
+     * replaces the unknown text with the one in <baseFile>.
+     * @param baseFile stream holding the unknown text.
+     */
+    void setBase(std::istream &baseFile);
+
+    /**
+     * replaces the unknown text with the one in <baseFile>.
+     * @param baseFile the unknown text.
+     */
+    void setBase(const MappedFile &baseFile);
+
+    /**
+     * @param f: in-stream.
+     * @return a vector representing the frequencies in f, according to the frequent words keying.
+     * (safe to call concurrently).
+     */
+    inline const std::vector<int> frequencies(std::istream &f) const {return _getFrequency(f);}
+
+    /**
+     * @return the frequent words.
+     */
+    inline const Vocabulary &words() const {return _fw;}
+
+    /**
+     * @return the processed files.
+     */
+    inline const AuthorIndex &authors() const {return _authors;}
+
+    /**
+     * stores the frequencies of <f> (without scoring or printing anything).
+     * @param f : in file stream.
+     * @param fName : f's name (as given to the program).
+     */
+    void addAuthor(std::istream &f, const std::string &fName);
+
+    /**
+     * stores the frequencies of <f> (without scoring or printing anything).
+     * @param f : file.
+     * @param fName : f's name (as given to the program).
+     */
+    void addAuthor(const MappedFile &f, const std::string &fName);
+
+    /**
+     * computes the distance between this file and the base file.
+     * prints it at the format: "<fName> <distance>\n".
+     * @param f : in file stream.
+     * @param fName : f's name (as given to the program).
+     */
+    void processFile(std::istream &f, const std::string &fName);
+
+    /**
+     * computes the distance between this file and the base file.
+     * prints it at the format: "<fName> <distance>\n".
+     * @param f : file.
+     * @param fName : f's name (as given to the program).
+     */
+    void processFile(const MappedFile &f, const std::string &fName);
+
+    /**
+     * prints the greatest distanced file (among the files that has been entered up to this point)
+     * in the format: "Best matching author is <fName> score <distance>\n".
+     */
+    void maxDistance() const;
+
+    /**
+     * builds the approximate search tables over the files processed up to this point.
+     * @param tables: number of hash tables.
+     * @param bits: number of bits in a signature.
+     */
+    void buildApproxIndex(unsigned int tables, unsigned int bits);
+
+    /**
+     * prints the <k> closest files (among the files that has been entered up to this point),
+     * one per line, at the format: "<rank> <fName> <distance>\n".
+     * @param k: number of files to print.
+     * @param approx: true to use the approximate search tables (if they were built).
+     * @param recall: true to also print the recall of the approximate search, at the format:
+     *                "Recall@<k> <recall>\n".
+     */
+    void topDistances(size_t k, bool approx, bool recall) const;
+
+    /**
+     * ranks the processed files by their distance from the text in <f>, without touching the
+     * base file (safe to call concurrently).
+     * @param f: in-stream holding an unknown text.
+     * @param k: number of files to return.
+     * @param approx: true to use the approximate search tables (if they were built).
+     * @return the <k> closest files, closest first.
+     */
+    std::vector<AuthorMatch> rank(std::istream &f, size_t k, bool approx) const;
+
+    /**
+     * ranks the processed files by their distance from the text in <f>, without touching the
+     * base file (safe to call concurrently).
+     * @param f: file holding an unknown text.
+     * @param k: number of files to return.
+     * @param approx: true to use the approximate search tables (if they were built).
+     * @return the <k> closest files, closest first.
+     */
+    std::vector<AuthorMatch> rank(const MappedFile &f, size_t k, bool approx) const;
+
+    /**
+     * @return an empty matrix of unknown texts' frequencies, for addQuery and rankBatch.
+     */
+    inline ProfileMatrix queryMatrix() const {return ProfileMatrix(_extractor.size());}
+
+    /**
+     * appends the frequencies of the unknown text in <f> to <queries>.
+     * @param f: file holding an unknown text.
+     * @param queries: a matrix returned by queryMatrix().
+     */
+    void addQuery(const MappedFile &f, ProfileMatrix &queries) const;
+
+    /**
+     * ranks the processed files by their distance from every text in <queries>, with all the
+     * distances computed as a single blocked matrix product (safe to call concurrently).
+     * @param queries: the unknown texts' frequencies.
+     * @param k: number of files to return per text.
+     * @return for every text (in order), its <k> closest files, closest first.
+     */
+    std::vector<std::vector<AuthorMatch>> rankBatch(const ProfileMatrix &queries, size_t k) const;
+
+    /**
+     * appends <text> to an unknown text that arrives in pieces, and updates its distance from
+     * every processed file (at a cost proportional to the words in <text>).
+     * a word split between two calls is counted once it is complete (n-grams don't span calls).
+     * @param text: the next piece of the unknown text.
+     */
+    void appendBase(const std::string &text);
+
+    /**
+     * counts the last word appended by appendBase (the unknown text has ended).
+     */
+    void finishBase();
+
+    /**
+     * @return the number of frequent words counted so far by appendBase.
+     */
+    inline unsigned long streamedWords() const {return _stream ? _stream->words() : 0;}
+
+    /**
+     * @param k: number of files to return.
+     * @return the <k> files closest to the text appended so far by appendBase, closest first.
+     */
+    std::vector<AuthorMatch> streamingRank(size_t k);
+};
+
+#endif //EX2_FREQUENCIESDETECTOR_H
@@ -0,0 +1,145 @@
+//
+// Created by baraloni, ex2 cpp 2018-19 winter semester.
+// contains the opt-in per-file timing and counters of find_the_author.
+//
+
+#include "Instrumentation.h"
+#include <cstdio>
+#include "AllocTracker.hpp"
+
+//---------------------Helpers:
+
+/**
+ * writes <text> as a JSON string (quoted and escaped).
+ * @param out: the stream.
+ * @param text: the text.
+ */
+static void writeJsonString(std::ostream &out, const std::string &text)
+{
+    out << '"';
+    for (const char c : text)
+    {
+        if (c == '"' || c == '\\')
+        {
+            out << '\\' << c;
+        }
+        else if ((unsigned char) c < 0x20)
+        {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", (unsigned int) c);
+            out << escaped;
+        }
+        else
+        {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+//---------------------Methods:
+
+/**
+ * constructs an instrumentation.
+ * @param out: receives the JSON lines.
+ * @param enabled: true to record.
+ */
+Instrumentation::Instrumentation(std::ostream &out, const bool enabled): _out(out), _enabled(enabled)
+{
+    if (_enabled && countsAllocations())
+    {
+        AllocTracker::setEnabled(true);
+    }
+}
+
+/**
+ * starts the record of a file, and its first stage.
+ * @param file: the file's name.
+ * @param role: the file's role.
+ */
+void Instrumentation::begin(const std::string &file, const std::string &role)
+{
+    if (!_enabled)
+    {
+        return;
+    }
+    _current = FileStats();
+    _current.file = file;
+    _current.role = role;
+    _allocationsMark = allocations();
+    _bytesMark = allocatedBytes();
+    _mark = std::chrono::steady_clock::now();
+}
+
+/**
+ * adds the wall time since the last stage ended to <stage>, and starts the next stage.
+ * @param stage: the record's field receiving the time, e.g. &FileStats::readMs.
+ */
+void Instrumentation::lap(double FileStats::*stage)
+{
+    if (!_enabled)
+    {
+        return;
+    }
+    const auto now = std::chrono::steady_clock::now();
+    _current.*stage += std::chrono::duration<double, std::milli>(now - _mark).count();
+    _mark = now;
+}
+
+/**
+ * finishes the record of the file, and writes it.
+ */
+void Instrumentation::end()
+{
+    if (!_enabled)
+    {
+        return;
+    }
+    _current.allocations = allocations() - _allocationsMark;
+    _current.allocatedBytes = allocatedBytes() - _bytesMark;
+    _out << "{\"file\":";
+    writeJsonString(_out, _current.file);
+    _out << ",\"role\":";
+    writeJsonString(_out, _current.role);
+    _out << ",\"read_ms\":" << _current.readMs
+         << ",\"tokenize_ms\":" << _current.tokenizeMs
+         << ",\"lookup_ms\":" << _current.lookupMs
+         << ",\"score_ms\":" << _current.scoreMs
+         << ",\"bytes\":" << _current.bytes
+         << ",\"tokens\":" << _current.tokens
+         << ",\"matched\":" << _current.matched;
+    if (countsAllocations())
+    {
+        _out << ",\"allocations\":" << _current.allocations
+             << ",\"allocated_bytes\":" << _current.allocatedBytes;
+    }
+    _out << "}" << std::endl;
+}
+
+/**
+ * @return true if the program was built to count its heap allocations (make TRACK=1).
+ */
+bool Instrumentation::countsAllocations()
+{
+#ifdef ALLOC_TRACKING
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @return the number of heap allocations made by the calling thread so far (0 unless counted).
+ */
+unsigned long Instrumentation::allocations()
+{
+    return AllocTracker::ofThisThread().count;
+}
+
+/**
+ * @return the number of bytes allocated by the calling thread so far (0 unless counted).
+ */
+size_t Instrumentation::allocatedBytes()
+{
+    return AllocTracker::ofThisThread().bytes;
+}
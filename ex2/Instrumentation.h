@@ -0,0 +1,132 @@
+//
+// Created by baraloni, ex2 cpp 2018-19 winter semester.
+// contains the opt-in per-file timing and counters of find_the_author.
+//
+
+#ifndef EX2_INSTRUMENTATION_H
+#define EX2_INSTRUMENTATION_H
+
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+/**
+ * represents what processing a single file cost.
+ */
+struct FileStats
+{
+    /** the file's name (as given to the program).*/
+    std::string file;
+    /** the file's role: "words", "unknown" or "author".*/
+    std::string role;
+    /** wall time spent opening and reading (or mapping) the file.*/
+    double readMs = 0;
+    /** wall time spent splitting the text into words.*/
+    double tokenizeMs = 0;
+    /** wall time spent looking the words up (and hashing the n-grams), on top of tokenizeMs.*/
+    double lookupMs = 0;
+    /** wall time spent scoring the file against the unknown text.*/
+    double scoreMs = 0;
+    /** number of bytes read from the file (compressed, for a compressed file).*/
+    size_t bytes = 0;
+    /** number of words in the file.*/
+    unsigned long tokens = 0;
+    /** number of words in the file that are frequent words.*/
+    unsigned long matched = 0;
+    /** number of heap allocations made by the recording thread while processing the file.*/
+    unsigned long allocations = 0;
+    /** number of bytes allocated by the recording thread while processing the file.*/
+    size_t allocatedBytes = 0;
+};
+
+/**
+ * records a FileStats per processed file, and writes each as a JSON line once it is done.
+ * a record spans begin() to end(); the stages in between are timed by lap().
+ * a disabled instrumentation records and writes nothing.
+ * the allocation counters are only written by builds that count allocations (make TRACK=1, see
+ * common/AllocTracker.hpp), and count the allocations of the thread that records (so the reader
+ * and decompression threads' allocations aren't charged to the current file).
+ */
+class Instrumentation
+{
+private:
+    /**
+     * receives the JSON lines.
+     */
+    std::ostream &_out;
+
+    /**
+     * true to record.
+     */
+    bool _enabled;
+
+    /**
+     * holds the record of the file being processed.
+     */
+    FileStats _current;
+
+    /**
+     * represents the end of the last timed stage.
+     */
+    std::chrono::steady_clock::time_point _mark;
+
+    /**
+     * represents the allocation counters when the record began.
+     */
+    unsigned long _allocationsMark = 0;
+    size_t _bytesMark = 0;
+
+public:
+    /**
+     * constructs an instrumentation.
+     * @param out: receives the JSON lines.
+     * @param enabled: true to record.
+     */
+    Instrumentation(std::ostream &out, bool enabled);
+
+    /**
+     * @return true if the instrumentation records.
+     */
+    inline bool enabled() const {return _enabled;}
+
+    /**
+     * starts the record of a file, and its first stage.
+     * @param file: the file's name.
+     * @param role: the file's role.
+     */
+    void begin(const std::string &file, const std::string &role);
+
+    /**
+     * adds the wall time since the last stage ended to <stage>, and starts the next stage.
+     * @param stage: the record's field receiving the time, e.g. &FileStats::readMs.
+     */
+    void lap(double FileStats::*stage);
+
+    /**
+     * @return the record of the file being processed (for its counters).
+     */
+    inline FileStats &current() {return _current;}
+
+    /**
+     * finishes the record of the file, and writes it.
+     */
+    void end();
+
+    /**
+     * @return true if the program was built to count its heap allocations (make TRACK=1).
+     */
+    static bool countsAllocations();
+
+    /**
+     * @return the number of heap allocations made by the calling thread so far (0 unless counted).
+     */
+    static unsigned long allocations();
+
+    /**
+     * @return the number of bytes allocated by the calling thread so far (0 unless counted).
+     */
+    static size_t allocatedBytes();
+};
+
+#endif //EX2_INSTRUMENTATION_H
@@ -0,0 +1,61 @@
+//
+// Created by baraloni, ex2 cpp 2018-19 winter semester.
+// contains a read-only view of a whole file's bytes.
+//
+
+#include "MappedFile.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * maps (or reads) the file at <path>.
+ * @param path: the file's path.
+ * @param populate: true to read the whole mapping in now (rather than on first touch).
+ */
+MappedFile::MappedFile(const std::string &path, const bool populate)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return;
+    }
+    struct stat info{};
+    if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0)
+    {
+        const int flags = MAP_PRIVATE | (populate ? MAP_POPULATE : 0);
+        void *mapping = mmap(nullptr, info.st_size, PROT_READ, flags, fd, 0);
+        if (mapping != MAP_FAILED)
+        {
+            madvise(mapping, info.st_size, MADV_SEQUENTIAL);
+            _data = static_cast<const char *>(mapping);
+            _size = info.st_size;
+            _mapped = true;
+            _good = true;
+            close(fd);
+            return;
+        }
+    }
+    char chunk[65536];
+    ssize_t n;
+    while ((n = read(fd, chunk, sizeof(chunk))) > 0)
+    {
+        _buffer.append(chunk, n);
+    }
+    _good = (n == 0);
+    _data = _buffer.data();
+    _size = _buffer.size();
+    close(fd);
+}
+
+/**
+ * unmaps the file.
+ */
+MappedFile::~MappedFile()
+{
+    if (_mapped)
+    {
+        munmap(const_cast<char *>(_data), _size);
+    }
+}
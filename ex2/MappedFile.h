@@ -0,0 +1,76 @@
+//
+// Created by baraloni, ex2 cpp 2018-19 winter semester.
+// contains a read-only view of a whole file's bytes.
+//
+
+#ifndef EX2_MAPPEDFILE_H
+#define EX2_MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+
+/**
+ * holds the bytes of a file: regular files are memory mapped (read only), other files
+ * (pipes, devices) are read into memory.
+ */
+class MappedFile
+{
+private:
+    /**
+     * points at the file's first byte (or at _buffer's).
+     */
+    const char *_data = nullptr;
+
+    /**
+     * represents the number of bytes in the file.
+     */
+    size_t _size = 0;
+
+    /**
+     * true if _data is mapped (and must be unmapped).
+     */
+    bool _mapped = false;
+
+    /**
+     * true if the file was opened and read.
+     */
+    bool _good = false;
+
+    /**
+     * holds the bytes of a file that could not be mapped.
+     */
+    std::string _buffer;
+
+public:
+    /**
+     * maps (or reads) the file at <path>.
+     * @param path: the file's path.
+     * @param populate: true to read the whole mapping in now (rather than on first touch).
+     */
+    explicit MappedFile(const std::string &path, bool populate = false);
+
+    /**
+     * unmaps the file.
+     */
+    ~MappedFile();
+
+    MappedFile(const MappedFile &other) = delete;
+    MappedFile &operator=(const MappedFile &other) = delete;
+
+    /**
+     * @return a pointer to the file's first byte.
+     */
+    inline const char *data() const {return _data;}
+
+    /**
+     * @return the number of bytes in the file.
+     */
+    inline size_t size() const {return _size;}
+
+    /**
+     * @return true if the file was opened and read.
+     */
+    inline explicit operator bool() const {return _good;}
+};
+
+#endif //EX2_MAPPEDFILE_H
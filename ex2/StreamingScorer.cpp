@@ -0,0 +1,74 @@
+//
+// Created by baraloni, ex2 cpp 2018-19 winter semester.
+// contains the incremental scorer of an unknown text that arrives in pieces.
+//
+
+#include "StreamingScorer.h"
+#include <cmath>
+
+/**
+ * constructs a scorer of an empty text.
+ * @param profiles: the authors' frequency vectors (must outlive the scorer).
+ * @param vocabulary: the number of frequent words (the first features of every vector).
+ */
+StreamingScorer::StreamingScorer(const ProfileMatrix &profiles, const size_t vocabulary):
+    _profiles(profiles), _counts(profiles.cols(), 0), _pending(profiles.cols(), 0),
+    _vocabulary(vocabulary)
+{
+}
+
+/**
+ * computes the dot products of the rows added to the matrix since the last call.
+ */
+void StreamingScorer::_syncRows()
+{
+    for (size_t r = _dots.size(); r < _profiles.rows(); ++r)
+    {
+        const double *row = _profiles.row(r);
+        double dot = 0;
+        for (size_t i = 0; i < _counts.size(); ++i)
+        {
+            dot += row[i] * _counts[i];
+        }
+        _dots.push_back(dot);
+    }
+}
+
+/**
+ * applies the pending batch to the frequencies, the norm and the dot products.
+ * (c + d)^2 = c^2 + d(2c + d), so the norm is updated by the touched words only.
+ */
+void StreamingScorer::commit()
+{
+    _syncRows();
+    for (size_t word : _touched)
+    {
+        const int delta = _pending[word];
+        _squaredNorm += (double) delta * (2.0 * _counts[word] + delta);
+        _counts[word] += delta;
+        if (word < _vocabulary)
+        {
+            _words += delta;
+        }
+        for (size_t r = 0; r < _dots.size(); ++r)
+        {
+            _dots[r] += _profiles.row(r)[word] * delta;
+        }
+        _pending[word] = 0;
+    }
+    _touched.clear();
+}
+
+/**
+ * @param out: receives the score of row i at out[i] (pending words are not included).
+ */
+void StreamingScorer::scores(std::vector<double> &out)
+{
+    _syncRows();
+    out.resize(_dots.size());
+    const double norm = sqrt(_squaredNorm);
+    for (size_t r = 0; r < _dots.size(); ++r)
+    {
+        out[r] = CosineKernel::cosine(_dots[r], norm, _profiles.norm(r));
+    }
+}
@@ -0,0 +1,109 @@
+//
+// Created by baraloni, ex2 cpp 2018-19 winter semester.
+// contains the incremental scorer of an unknown text that arrives in pieces.
+//
+
+#ifndef EX2_STREAMINGSCORER_H
+#define EX2_STREAMINGSCORER_H
+
+#include <cstddef>
+#include <vector>
+#include "CosineKernel.h"
+
+/**
+ * keeps the cosine similarity between a growing frequency vector (the unknown text read so far)
+ * and every row of a profile matrix up to date.
+ * it caches the vector's squared norm and its dot product with every row, so counting a batch of
+ * words costs O(distinct words in the batch) per row, regardless of how much text was read.
+ */
+class StreamingScorer
+{
+private:
+    /**
+     * the authors' frequency vectors (rows may be added at any time).
+     */
+    const ProfileMatrix &_profiles;
+
+    /**
+     * holds the frequencies of the text read so far.
+     */
+    std::vector<int> _counts;
+
+    /**
+     * holds the squared norm of _counts (exact, as long as it is below 2^53).
+     */
+    double _squaredNorm = 0;
+
+    /**
+     * holds the dot product of _counts with every row scored so far.
+     */
+    std::vector<double> _dots;
+
+    /**
+     * holds the counts of the pending batch, by word index.
+     */
+    std::vector<int> _pending;
+
+    /**
+     * holds the word indexes that have a nonzero count in _pending.
+     */
+    std::vector<size_t> _touched;
+
+    /**
+     * represents the number of frequent words: the feature indexes below it are words, the rest
+     * are hashed n-grams.
+     */
+    size_t _vocabulary;
+
+    /**
+     * represents the number of frequent words counted so far (n-grams aren't counted).
+     */
+    unsigned long _words = 0;
+
+    /**
+     * computes the dot products of the rows added to the matrix since the last call.
+     */
+    void _syncRows();
+
+public:
+    /**
+     * constructs a scorer of an empty text.
+     * @param profiles: the authors' frequency vectors (must outlive the scorer).
+     * @param vocabulary: the number of frequent words (the first features of every vector).
+     */
+    StreamingScorer(const ProfileMatrix &profiles, size_t vocabulary);
+
+    /**
+     * counts one occurrence of a word in the pending batch.
+     * @param word: the word's index.
+     */
+    inline void count(size_t word)
+    {
+        if (_pending[word]++ == 0)
+        {
+            _touched.push_back(word);
+        }
+    }
+
+    /**
+     * applies the pending batch to the frequencies, the norm and the dot products.
+     */
+    void commit();
+
+    /**
+     * @param out: receives the score of row i at out[i] (pending words are not included).
+     */
+    void scores(std::vector<double> &out);
+
+    /**
+     * @return the frequencies of the text read so far.
+     */
+    inline const std::vector<int> &counts() const {return _counts;}
+
+    /**
+     * @return the number of frequent words counted so far (n-grams aren't counted).
+     */
+    inline unsigned long words() const {return _words;}
+};
+
+#endif //EX2_STREAMINGSCORER_H
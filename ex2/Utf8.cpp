@@ -0,0 +1,294 @@
+//
+// Created by baraloni, ex2 cpp 2018-19 winter semester.
+// contains the utf-8 decoding, case folding and character classes of the unicode tokenizer.
+//
+
+#include "Utf8.h"
+#include <cstring>
+
+//---------------------Helpers:
+
+/**
+ * @param c: a character.
+ * @param first: a range's first character.
+ * @param last: the range's last character.
+ * @return true if <c> is in the range.
+ */
+static inline bool in(const uint32_t c, const uint32_t first, const uint32_t last)
+{
+    return c >= first && c <= last;
+}
+
+/**
+ * @param c: a character of a range whose capitals are at even code points, each followed by its
+ *           small letter.
+ * @return the small letter.
+ */
+static inline uint32_t evenPair(const uint32_t c)
+{
+    return c | 1u;
+}
+
+/**
+ * @param c: a character of a range whose capitals are at odd code points, each followed by its
+ *           small letter.
+ * @return the small letter.
+ */
+static inline uint32_t oddPair(const uint32_t c)
+{
+    return (c & 1u) ? c + 1 : c;
+}
+
+//---------------------Functions:
+
+/**
+ * @param codePoint: a character.
+ * @return the character's unicode simple case folding (covers latin-1, latin extended-a, -b and
+ *         additional, greek, cyrillic, armenian and fullwidth latin; other characters fold to
+ *         themselves).
+ */
+uint32_t foldCase(const uint32_t codePoint)
+{
+    const uint32_t c = codePoint;
+    if (c < 0x80)
+    {
+        return in(c, 'A', 'Z') ? c + 0x20 : c;
+    }
+    if (c < 0x100) // latin-1.
+    {
+        if (c == 0xB5)
+        {
+            return 0x3BC; // micro sign -> greek mu.
+        }
+        return (in(c, 0xC0, 0xDE) && c != 0xD7) ? c + 0x20 : c;
+    }
+    if (c < 0x180) // latin extended-a.
+    {
+        if (c == 0x178)
+        {
+            return 0xFF;
+        }
+        if (c == 0x17F)
+        {
+            return 's'; // long s.
+        }
+        if (in(c, 0x100, 0x12F) || in(c, 0x132, 0x137) || in(c, 0x14A, 0x177))
+        {
+            return evenPair(c);
+        }
+        if (in(c, 0x139, 0x148) || in(c, 0x179, 0x17E))
+        {
+            return oddPair(c);
+        }
+        return c; // U+0130 only folds in full (or turkic) folding.
+    }
+    if (c < 0x250) // latin extended-b.
+    {
+        if (in(c, 0x1C4, 0x1CC))
+        {
+            return c - (c - 0x1C4) % 3 + 2; // the digraphs' capital and title case -> small.
+        }
+        if (in(c, 0x182, 0x185) || in(c, 0x1A0, 0x1A5) || in(c, 0x1DE, 0x1EF) ||
+            in(c, 0x1F8, 0x21F) || in(c, 0x222, 0x233) || in(c, 0x246, 0x24F))
+        {
+            return evenPair(c);
+        }
+        if (in(c, 0x1CD, 0x1DC))
+        {
+            return oddPair(c);
+        }
+        switch (c)
+        {
+            case 0x181: return 0x253; // the african and ipa capitals fold to ipa letters.
+            case 0x186: return 0x254;
+            case 0x187: return 0x188;
+            case 0x189: return 0x256;
+            case 0x18A: return 0x257;
+            case 0x18B: return 0x18C;
+            case 0x18E: return 0x1DD;
+            case 0x18F: return 0x259;
+            case 0x190: return 0x25B;
+            case 0x191: return 0x192;
+            case 0x193: return 0x260;
+            case 0x194: return 0x263;
+            case 0x196: return 0x269;
+            case 0x197: return 0x268;
+            case 0x198: return 0x199;
+            case 0x19C: return 0x26F;
+            case 0x19D: return 0x272;
+            case 0x19F: return 0x275;
+            case 0x1A6: return 0x280;
+            case 0x1A7: return 0x1A8;
+            case 0x1A9: return 0x283;
+            case 0x1AC: return 0x1AD;
+            case 0x1AE: return 0x288;
+            case 0x1AF: return 0x1B0;
+            case 0x1B1: return 0x28A;
+            case 0x1B2: return 0x28B;
+            case 0x1B3: return 0x1B4;
+            case 0x1B5: return 0x1B6;
+            case 0x1B7: return 0x292;
+            case 0x1B8: return 0x1B9;
+            case 0x1BC: return 0x1BD;
+            case 0x1F1: return 0x1F3; // dz.
+            case 0x1F2: return 0x1F3;
+            case 0x1F4: return 0x1F5;
+            case 0x1F6: return 0x195;
+            case 0x1F7: return 0x1BF;
+            case 0x220: return 0x19E;
+            case 0x23A: return 0x2C65;
+            case 0x23B: return 0x23C;
+            case 0x23D: return 0x19A;
+            case 0x23E: return 0x2C66;
+            case 0x241: return 0x242;
+            case 0x243: return 0x180;
+            case 0x244: return 0x289;
+            case 0x245: return 0x28C;
+            default: return c;
+        }
+    }
+    if (c == 0x345)
+    {
+        return 0x3B9; // combining ypogegrammeni -> greek iota.
+    }
+    if (in(c, 0x370, 0x3FF)) // greek and coptic.
+    {
+        if (in(c, 0x370, 0x373) || c == 0x376 || in(c, 0x3D8, 0x3EF))
+        {
+            return evenPair(c);
+        }
+        if (in(c, 0x391, 0x3AB) && c != 0x3A2)
+        {
+            return c + 0x20;
+        }
+        if (in(c, 0x388, 0x38A))
+        {
+            return c + 0x25;
+        }
+        if (in(c, 0x38E, 0x38F))
+        {
+            return c + 0x3F;
+        }
+        if (in(c, 0x3FD, 0x3FF))
+        {
+            return c - 0x82;
+        }
+        switch (c)
+        {
+            case 0x37F: return 0x3F3;
+            case 0x386: return 0x3AC;
+            case 0x38C: return 0x3CC;
+            case 0x3C2: return 0x3C3; // final sigma.
+            case 0x3CF: return 0x3D7;
+            case 0x3D0: return 0x3B2; // the symbol variants fold to their letters.
+            case 0x3D1: return 0x3B8;
+            case 0x3D5: return 0x3C6;
+            case 0x3D6: return 0x3C0;
+            case 0x3F0: return 0x3BA;
+            case 0x3F1: return 0x3C1;
+            case 0x3F4: return 0x3B8;
+            case 0x3F5: return 0x3B5;
+            case 0x3F7: return 0x3F8;
+            case 0x3F9: return 0x3F2;
+            case 0x3FA: return 0x3FB;
+            default: return c;
+        }
+    }
+    if (in(c, 0x400, 0x52F)) // cyrillic.
+    {
+        if (in(c, 0x400, 0x40F))
+        {
+            return c + 0x50;
+        }
+        if (in(c, 0x410, 0x42F))
+        {
+            return c + 0x20;
+        }
+        if (in(c, 0x460, 0x481) || in(c, 0x48A, 0x4BF) || in(c, 0x4D0, 0x52F))
+        {
+            return evenPair(c);
+        }
+        if (c == 0x4C0)
+        {
+            return 0x4CF;
+        }
+        return in(c, 0x4C1, 0x4CE) ? oddPair(c) : c;
+    }
+    if (in(c, 0x531, 0x556)) // armenian.
+    {
+        return c + 0x30;
+    }
+    if (in(c, 0x1E00, 0x1EFF)) // latin extended additional.
+    {
+        if (c == 0x1E9E)
+        {
+            return 0xDF; // capital sharp s.
+        }
+        if (c == 0x1E9B)
+        {
+            return 0x1E61; // long s with dot above.
+        }
+        return (in(c, 0x1E00, 0x1E95) || in(c, 0x1EA0, 0x1EFF)) ? evenPair(c) : c;
+    }
+    if (in(c, 0xFF21, 0xFF3A)) // fullwidth latin.
+    {
+        return c + 0x20;
+    }
+    return c;
+}
+
+/**
+ * @param codePoint: a character.
+ * @return the character's delimiter class (a DELIM_* flag), or 0 for a word character.
+ */
+unsigned int delimiterClass(const uint32_t codePoint)
+{
+    uint32_t c = codePoint;
+    if (in(c, 0xFF01, 0xFF5E))
+    {
+        c -= 0xFEE0; // fullwidth ascii is classed like ascii.
+    }
+    if (c < 0x80)
+    {
+        if (c <= 0x20 || c == 0x7F)
+        {
+            return DELIM_SPACE;
+        }
+        if (in(c, '0', '9'))
+        {
+            return DELIM_DIGIT;
+        }
+        if (in(c, 'a', 'z') || in(c, 'A', 'Z'))
+        {
+            return 0;
+        }
+        return std::strchr("$+<=>^`|~", (int) c) ? DELIM_SYMBOL : DELIM_PUNCT;
+    }
+    if (in(c, 0x80, 0xA0) || c == 0x1680 || in(c, 0x2000, 0x200B) || in(c, 0x2028, 0x2029) ||
+        c == 0x202F || c == 0x205F || c == 0x3000 || c == 0xFEFF)
+    {
+        return DELIM_SPACE;
+    }
+    if (c == 0xA1 || c == 0xA7 || c == 0xAB || in(c, 0xB6, 0xB7) || c == 0xBB || c == 0xBF ||
+        c == 0x37E || c == 0x387 || in(c, 0x55A, 0x55F) || c == 0x589 || c == 0x5BE ||
+        c == 0x5C0 || c == 0x5C3 || c == 0x5C6 || in(c, 0x5F3, 0x5F4) || c == 0x60C ||
+        c == 0x61B || c == 0x61F || in(c, 0x66A, 0x66D) || c == 0x6D4 || in(c, 0x964, 0x965) ||
+        in(c, 0x2010, 0x2027) || in(c, 0x2030, 0x205E) || in(c, 0x3001, 0x3003) ||
+        in(c, 0x3008, 0x3011) || in(c, 0x3014, 0x301F) || in(c, 0xFF5F, 0xFF65))
+    {
+        return DELIM_PUNCT;
+    }
+    if (in(c, 0xB2, 0xB3) || c == 0xB9 || in(c, 0xBC, 0xBE) || in(c, 0x660, 0x669) ||
+        in(c, 0x6F0, 0x6F9) || in(c, 0x966, 0x96F) || c == 0x2070 || in(c, 0x2074, 0x2079) ||
+        in(c, 0x2080, 0x2089))
+    {
+        return DELIM_DIGIT;
+    }
+    if (in(c, 0xA2, 0xA6) || in(c, 0xA8, 0xA9) || c == 0xAC || in(c, 0xAE, 0xB1) || c == 0xB4 ||
+        c == 0xB8 || c == 0xD7 || c == 0xF7 || in(c, 0x20A0, 0x20CF) || in(c, 0x2190, 0x23FF) ||
+        in(c, 0x2500, 0x27BF) || in(c, 0x1F000, 0x1FAFF))
+    {
+        return DELIM_SYMBOL;
+    }
+    return 0;
+}
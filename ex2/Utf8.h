@@ -0,0 +1,118 @@
+//
+// Created by baraloni, ex2 cpp 2018-19 winter semester.
+// contains the utf-8 decoding, case folding and character classes of the unicode tokenizer.
+//
+
+#ifndef EX2_UTF8_H
+#define EX2_UTF8_H
+
+#include <cstddef>
+#include <cstdint>
+
+/** delimiter classes of the unicode tokenizer (combined with |).*/
+#define DELIM_SPACE 1u
+#define DELIM_PUNCT 2u
+#define DELIM_DIGIT 4u
+#define DELIM_SYMBOL 8u
+
+/**
+ * decodes the utf-8 character at the beginning of <text>. overlong forms, surrogates and code
+ * points past U+10FFFF are invalid.
+ * @param text: the bytes.
+ * @param length: the number of bytes (at least 1).
+ * @param codePoint: receives the character.
+ * @return the number of bytes of the character, or 0 if they aren't valid utf-8.
+ */
+inline size_t utf8Decode(const unsigned char *text, const size_t length, uint32_t &codePoint)
+{
+    const unsigned char lead = text[0];
+    size_t size;
+    uint32_t min;
+    if (lead < 0x80)
+    {
+        codePoint = lead;
+        return 1;
+    }
+    else if (lead >= 0xC2 && lead <= 0xDF)
+    {
+        size = 2, min = 0x80, codePoint = lead & 0x1Fu;
+    }
+    else if (lead >= 0xE0 && lead <= 0xEF)
+    {
+        size = 3, min = 0x800, codePoint = lead & 0x0Fu;
+    }
+    else if (lead >= 0xF0 && lead <= 0xF4)
+    {
+        size = 4, min = 0x10000, codePoint = lead & 0x07u;
+    }
+    else
+    {
+        return 0;
+    }
+    if (length < size)
+    {
+        return 0;
+    }
+    for (size_t i = 1; i < size; ++i)
+    {
+        if ((text[i] & 0xC0) != 0x80)
+        {
+            return 0;
+        }
+        codePoint = (codePoint << 6) | (text[i] & 0x3Fu);
+    }
+    if (codePoint < min || codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF))
+    {
+        return 0;
+    }
+    return size;
+}
+
+/**
+ * encodes a character as utf-8.
+ * @param codePoint: the character (a valid code point).
+ * @param out: receives 1 to 4 bytes.
+ * @return the number of bytes.
+ */
+inline size_t utf8Encode(const uint32_t codePoint, char *out)
+{
+    if (codePoint < 0x80)
+    {
+        out[0] = (char) codePoint;
+        return 1;
+    }
+    if (codePoint < 0x800)
+    {
+        out[0] = (char) (0xC0 | (codePoint >> 6));
+        out[1] = (char) (0x80 | (codePoint & 0x3F));
+        return 2;
+    }
+    if (codePoint < 0x10000)
+    {
+        out[0] = (char) (0xE0 | (codePoint >> 12));
+        out[1] = (char) (0x80 | ((codePoint >> 6) & 0x3F));
+        out[2] = (char) (0x80 | (codePoint & 0x3F));
+        return 3;
+    }
+    out[0] = (char) (0xF0 | (codePoint >> 18));
+    out[1] = (char) (0x80 | ((codePoint >> 12) & 0x3F));
+    out[2] = (char) (0x80 | ((codePoint >> 6) & 0x3F));
+    out[3] = (char) (0x80 | (codePoint & 0x3F));
+    return 4;
+}
+
+/**
+ * @param codePoint: a character.
+ * @return the character's unicode simple case folding (covers latin-1, latin extended-a, -b and
+ *         additional, greek and coptic, cyrillic, armenian and fullwidth latin; other characters
+ *         fold to themselves).
+ */
+uint32_t foldCase(uint32_t codePoint);
+
+/**
+ * @param codePoint: a character.
+ * @return the character's delimiter class (a DELIM_* flag), or 0 for a word character.
+ */
+unsigned int delimiterClass(uint32_t codePoint);
+
+#endif //EX2_UTF8_H
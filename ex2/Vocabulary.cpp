@@ -0,0 +1,239 @@
+//
+// Created by baraloni, ex2 cpp 2018-19 winter semester.
+// contains the interned frequent-word vocabulary (an arena and a flat hash table).
+//
+
+#include "Vocabulary.h"
+#include <cstring>
+
+/** the capacity of an empty vocabulary's table.*/
+#define VOCAB_INITIAL_CAPACITY 64
+
+//---------------------Helpers:
+
+/**
+ * @param hash: a word's hash.
+ * @return the tag stored in the word's slot.
+ */
+static inline uint32_t tagOf(const uint64_t hash)
+{
+    return (uint32_t) (hash >> 32);
+}
+
+/**
+ * @param hash: a word's hash.
+ * @param capacity: the table's capacity.
+ * @return the first slot probed for the word.
+ */
+static inline size_t homeOf(const uint64_t hash, const uint32_t capacity)
+{
+    return (size_t) ((hash * 0x9E3779B97F4A7C15ULL) >> 32) & (capacity - 1);
+}
+
+/**
+ * @param word: a word.
+ * @param slotBytes: the bytes of a word of the same length, in the arena.
+ * @return true if the slot holds <word>.
+ */
+static inline bool same(const std::string_view word, const char *slotBytes)
+{
+    return std::memcmp(word.data(), slotBytes, word.size()) == 0;
+}
+
+/**
+ * @param word: a word.
+ * @param hash: the word's hash.
+ * @return the index of the word's slot, or of the free slot where it would be inserted.
+ */
+size_t Vocabulary::_probe(const std::string_view word, const uint64_t hash) const
+{
+    const uint32_t tag = tagOf(hash);
+    size_t i = homeOf(hash, _capacity);
+    while (true)
+    {
+        const Slot &slot = _slots[i];
+        if (slot.length == UINT32_MAX ||
+            (slot.tag == tag && slot.length == word.size() && same(word, _arena + slot.offset)))
+        {
+            return i;
+        }
+        i = (i + 1) & (_capacity - 1);
+    }
+}
+
+/**
+ * points the views at the owned storage.
+ */
+void Vocabulary::_point()
+{
+    _slots = _ownedSlots.data();
+    _order = _ownedOrder.data();
+    _arena = _ownedArena.data();
+    _capacity = (uint32_t) _ownedSlots.size();
+}
+
+/**
+ * copies a viewed vocabulary into owned storage (before it is changed).
+ */
+void Vocabulary::_own()
+{
+    if (!_file)
+    {
+        return;
+    }
+    _ownedSlots.assign(_slots, _slots + _capacity);
+    _ownedOrder.assign(_order, _order + _count);
+    _ownedArena.assign(_arena, _arena + (_file->size() - (_arena - _file->data())));
+    _file.reset();
+    _point();
+}
+
+/**
+ * doubles the table's capacity, and reinserts every word.
+ */
+void Vocabulary::_grow()
+{
+    std::vector<Slot> old;
+    old.swap(_ownedSlots);
+    _ownedSlots.assign(old.size() * 2, Slot{0, UINT32_MAX, 0, 0});
+    _point();
+    for (const Slot &slot : old)
+    {
+        if (slot.length != UINT32_MAX)
+        {
+            const std::string_view word(_arena + slot.offset, slot.length);
+            const size_t i = _probe(word, hash(word));
+            _ownedSlots[i] = slot;
+            _ownedOrder[slot.id] = (uint32_t) i;
+        }
+    }
+}
+
+//---------------------Constructors:
+
+/**
+ * constructs an empty vocabulary.
+ */
+Vocabulary::Vocabulary(): _ownedSlots(VOCAB_INITIAL_CAPACITY, Slot{0, UINT32_MAX, 0, 0})
+{
+    _point();
+}
+
+//---------------------Methods:
+
+/**
+ * adds <word> (a no-op if it's already in).
+ * @param word: the word.
+ * @return the word's id.
+ */
+unsigned long Vocabulary::insert(const std::string_view word)
+{
+    const uint64_t h = hash(word);
+    const unsigned long existing = find(word, h);
+    if (existing != VOCAB_MISSING)
+    {
+        return existing;
+    }
+    _own();
+    if (2 * (_count + 1) > _capacity) // keeps the load factor at most 1/2.
+    {
+        _grow();
+    }
+    const size_t i = _probe(word, h);
+    _ownedSlots[i] = Slot{(uint32_t) _ownedArena.size(), (uint32_t) word.size(), _count, tagOf(h)};
+    _ownedOrder.push_back((uint32_t) i);
+    _ownedArena.append(word.data(), word.size());
+    _point();
+    return _count++;
+}
+
+/**
+ * @param id: a word's id.
+ * @return the word.
+ */
+std::string_view Vocabulary::word(const unsigned long id) const
+{
+    const Slot &slot = _slots[_order[id]];
+    return std::string_view(_arena + slot.offset, slot.length);
+}
+
+/**
+ * writes the vocabulary in its serialized layout.
+ * @param out: the stream.
+ */
+void Vocabulary::save(std::ostream &out) const
+{
+    const uint32_t arenaSize = _file ? (uint32_t) (_file->size() - (_arena - _file->data()))
+                                     : (uint32_t) _ownedArena.size();
+    Header header{};
+    std::memcpy(header.magic, VOCAB_MAGIC, sizeof(header.magic));
+    header.version = VOCAB_VERSION;
+    header.count = _count;
+    header.capacity = _capacity;
+    header.arenaSize = arenaSize;
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(_slots), sizeof(Slot) * _capacity);
+    out.write(reinterpret_cast<const char *>(_order), sizeof(uint32_t) * _count);
+    out.write(_arena, arenaSize);
+}
+
+/**
+ * @param data: the bytes of a file.
+ * @param size: the number of bytes.
+ * @return true if the file holds a serialized vocabulary.
+ */
+bool Vocabulary::isSerialized(const char *data, const size_t size)
+{
+    return size >= sizeof(Header) && std::memcmp(data, VOCAB_MAGIC, 8) == 0;
+}
+
+/**
+ * replaces the vocabulary with a view of the serialized one in <file> (nothing is copied).
+ * @param file: the file (kept mapped while the vocabulary views it).
+ * @return false if the file isn't a well formed serialized vocabulary (the vocabulary is then
+ *         left as it was).
+ */
+bool Vocabulary::load(const std::shared_ptr<const MappedFile> &file)
+{
+    if (!isSerialized(file->data(), file->size()))
+    {
+        return false;
+    }
+    Header header{};
+    std::memcpy(&header, file->data(), sizeof(header));
+    const size_t expected = sizeof(Header) + sizeof(Slot) * (size_t) header.capacity +
+                            sizeof(uint32_t) * (size_t) header.count + header.arenaSize;
+    const bool powerOf2 = header.capacity > 0 && (header.capacity & (header.capacity - 1)) == 0;
+    if (header.version != VOCAB_VERSION || !powerOf2 || 2 * (size_t) header.count > header.capacity ||
+        expected != file->size())
+    {
+        return false;
+    }
+    const auto *slots = reinterpret_cast<const Slot *>(file->data() + sizeof(Header));
+    const auto *order = reinterpret_cast<const uint32_t *>(slots + header.capacity);
+    uint32_t used = 0;
+    for (uint32_t i = 0; i < header.capacity; ++i)
+    {
+        const Slot &slot = slots[i];
+        if (slot.length != UINT32_MAX)
+        {
+            if (slot.id >= header.count || order[slot.id] != i ||
+                (size_t) slot.offset + slot.length > header.arenaSize)
+            {
+                return false;
+            }
+            ++used;
+        }
+    }
+    if (used != header.count)
+    {
+        return false;
+    }
+    _file = file;
+    _slots = slots;
+    _order = order;
+    _arena = reinterpret_cast<const char *>(order + header.count);
+    _count = header.count;
+    _capacity = header.capacity;
+    return true;
+}
@@ -0,0 +1,198 @@
+//
+// Created by baraloni, ex2 cpp 2018-19 winter semester.
+// contains the interned frequent-word vocabulary (an arena and a flat hash table).
+//
+
+#ifndef EX2_VOCABULARY_H
+#define EX2_VOCABULARY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "MappedFile.h"
+
+/** FNV-1a offset basis (also the start of every word hash).*/
+#define FNV_OFFSET 0xCBF29CE484222325ULL
+/** FNV-1a prime (also the base of the rolling and n-gram hashes).*/
+#define FNV_PRIME 0x100000001B3ULL
+
+/** returned by find for a word that isn't in the vocabulary.*/
+#define VOCAB_MISSING ((unsigned long) -1)
+/** the first bytes of a serialized vocabulary.*/
+#define VOCAB_MAGIC "EX2VOCAB"
+/** the version of the serialized layout.*/
+#define VOCAB_VERSION 1
+
+#define VOCAB_ERR "Error: the frequent words file is a corrupt serialized vocabulary."
+
+/**
+ * holds a set of distinct words, each with an id (0 to size() - 1, in insertion order).
+ * the words' bytes are interned back to back in a single arena, and looked up through an
+ * open-addressing (linear probing) table of 16 byte slots, 4 to a cache line, so a lookup touches a
+ * slot or two and the word's bytes.
+ * the whole vocabulary serializes to a flat layout (header, slots, ids, arena) that load() views
+ * in place, straight from a mapped file.
+ */
+class Vocabulary
+{
+private:
+    /**
+     * represents a word in the table.
+     */
+    struct Slot
+    {
+        /** the word's first byte, in the arena.*/
+        uint32_t offset;
+        /** the word's number of bytes (UINT32_MAX for a free slot).*/
+        uint32_t length;
+        /** the word's id.*/
+        uint32_t id;
+        /** the top bits of the word's hash (compared before the bytes).*/
+        uint32_t tag;
+    };
+
+    /**
+     * represents the beginning of a serialized vocabulary.
+     */
+    struct Header
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t count;
+        uint32_t capacity;
+        uint32_t arenaSize;
+    };
+
+    /**
+     * hold the vocabulary's storage, unless it views a mapped file.
+     */
+    std::vector<Slot> _ownedSlots;
+    std::vector<uint32_t> _ownedOrder;
+    std::string _ownedArena;
+
+    /**
+     * keeps the viewed file mapped (null if the storage is owned).
+     */
+    std::shared_ptr<const MappedFile> _file;
+
+    /**
+     * point at the table (capacity slots, a power of 2), at every id's slot index, and at the
+     * words' bytes.
+     */
+    const Slot *_slots = nullptr;
+    const uint32_t *_order = nullptr;
+    const char *_arena = nullptr;
+
+    /**
+     * represent the number of words, and of slots.
+     */
+    uint32_t _count = 0;
+    uint32_t _capacity = 0;
+
+    /**
+     * @param word: a word.
+     * @param hash: the word's hash.
+     * @return the index of the word's slot, or of the free slot where it would be inserted.
+     */
+    size_t _probe(std::string_view word, uint64_t hash) const;
+
+    /**
+     * copies a viewed vocabulary into owned storage (before it is changed).
+     */
+    void _own();
+
+    /**
+     * doubles the table's capacity, and reinserts every word.
+     */
+    void _grow();
+
+    /**
+     * points the views at the owned storage.
+     */
+    void _point();
+
+public:
+    /**
+     * constructs an empty vocabulary.
+     */
+    Vocabulary();
+
+    Vocabulary(const Vocabulary &other) = delete;
+    Vocabulary &operator=(const Vocabulary &other) = delete;
+
+    /**
+     * @param word: a word.
+     * @return the word's FNV-1a hash.
+     */
+    static inline uint64_t hash(std::string_view word)
+    {
+        uint64_t h = FNV_OFFSET;
+        for (const char c : word)
+        {
+            h = (h ^ (unsigned char) c) * FNV_PRIME;
+        }
+        return h;
+    }
+
+    /**
+     * @return the number of words.
+     */
+    inline size_t size() const {return _count;}
+
+    /**
+     * adds <word> (a no-op if it's already in).
+     * @param word: the word.
+     * @return the word's id.
+     */
+    unsigned long insert(std::string_view word);
+
+    /**
+     * @param word: a word.
+     * @param hash: the word's hash (as returned by hash()).
+     * @return the word's id, or VOCAB_MISSING if it isn't in.
+     */
+    inline unsigned long find(std::string_view word, uint64_t hash) const
+    {
+        const Slot &slot = _slots[_probe(word, hash)];
+        return slot.length == UINT32_MAX ? VOCAB_MISSING : slot.id;
+    }
+
+    /**
+     * @param word: a word.
+     * @return the word's id, or VOCAB_MISSING if it isn't in.
+     */
+    inline unsigned long find(std::string_view word) const {return find(word, hash(word));}
+
+    /**
+     * @param id: a word's id.
+     * @return the word.
+     */
+    std::string_view word(unsigned long id) const;
+
+    /**
+     * writes the vocabulary in its serialized layout.
+     * @param out: the stream.
+     */
+    void save(std::ostream &out) const;
+
+    /**
+     * @param data: the bytes of a file.
+     * @param size: the number of bytes.
+     * @return true if the file holds a serialized vocabulary.
+     */
+    static bool isSerialized(const char *data, size_t size);
+
+    /**
+     * replaces the vocabulary with a view of the serialized one in <file> (nothing is copied).
+     * @param file: the file (kept mapped while the vocabulary views it).
+     * @return false if the file isn't a well formed serialized vocabulary (the vocabulary is then
+     *         left as it was).
+     */
+    bool load(const std::shared_ptr<const MappedFile> &file);
+};
+
+#endif //EX2_VOCABULARY_H
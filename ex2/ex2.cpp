@@ -1,173 +1,514 @@
 
-//data structures:
-#include <unordered_map>
-#include <map>
-#include <iterator>
 //io:
 #include <iostream>
 #include <fstream>
 //other functionality:
-#include <cmath>
-#include <numeric>
-#include <boost/tokenizer.hpp>
-#include <boost/algorithm/string.hpp>
-//namespaces:
-typedef boost::tokenizer<boost::char_separator<char>> tokenizer;
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+#include "FrequenciesDetector.h"
+#include "AttributionServer.h"
+#include "Instrumentation.h"
+// with make TRACK=1, --stats counts every heap allocation (through the tracker's operator new).
+#define ALLOC_TRACK_GLOBAL_NEW
+#include "AllocTracker.hpp"
+#include "FilePrefetcher.h"
 
 //constants:
+#define USAGE_ERR "Usage: [--top=<k>] [--approx[=<tables>,<bits>]] [--recall] " \
+                  "[--features=word:<n>,char:<n>,bits:<b>] [--stats] [--readers=<n>] " \
+                  "[--tokenizer=unicode[:space,punct,digit,symbol]] " \
+                  "<frequent_words.txt> <unknown.txt> <author1.txt> .. <authorN.txt>\n" \
+                  "       --serve[=<socket>] [--top=<k>] [--approx[=<tables>,<bits>]] " \
+                  "<frequent_words.txt> <author1.txt> .. <authorN.txt>\n" \
+                  "       --follow [--top=<k>] <frequent_words.txt> <unknown.txt|-> " \
+                  "<author1.txt> .. <authorN.txt>\n" \
+                  "       --batch=<unknowns.txt> [--top=<k>] <frequent_words.txt> " \
+                  "<author1.txt> .. <authorN.txt>\n" \
+                  "       --compile-words <frequent_words.txt> <frequent_words.vocab>"
+#define FIO_ERR "Error: could not open or read one oor more of the files."
+/** how long --follow waits for a file to grow, in milliseconds.*/
+#define FOLLOW_POLL_MS 200
+/** size of the pieces --follow reads, in bytes.*/
+#define FOLLOW_CHUNK 65536
+
 /**
- * represents Os newline: in windows: \r\n. in linux: \n.
+ * holds the program's optional flags.
  */
-#define OS_NL "\r\n"
-#define USAGE_ERR "Usage: <frequent_words.txt> <unknown.txt> <author1.txt> .. <authorN.txt>"
-#define FIO_ERR "Error: could not open or read one oor more of the files."
+struct Options
+{
+    /** number of closest files to list (0 to list none).*/
+    size_t top = 0;
+    /** true to list them using the approximate search.*/
+    bool approx = false;
+    /** number of approximate search hash tables.*/
+    unsigned int tables = LSH_DEFAULT_TABLES;
+    /** number of bits in an approximate search signature.*/
+    unsigned int bits = LSH_DEFAULT_BITS;
+    /** true to measure the approximate search against the exact one.*/
+    bool recall = false;
+    /** true to run as a long-running server.*/
+    bool serve = false;
+    /** path of the server's unix socket (empty to serve stdin).*/
+    std::string socket;
+    /** true to score the unknown text incrementally, as it grows.*/
+    bool follow = false;
+    /** the hashed n-grams counted besides the frequent words.*/
+    FeatureConfig features;
+    /** true to write every file's timings and counters to stderr, as JSON lines.*/
+    bool stats = false;
+    /** true to serialize the frequent words, for loading them by mapping.*/
+    bool compile = false;
+    /** number of threads reading the author files ahead of the counting (0 to read in turn).*/
+    unsigned int readers = PREFETCH_DEFAULT_READERS;
+    /** path of a list of unknown texts to attribute at once (empty for a single unknown text).*/
+    std::string batch;
+};
 
 /**
- * gets a ifstream containing a list of frequent words, a ifstream representing an anonymus text.
- * can receive ifstreams of authored texts, and compute their distance from the anonymus text
- * in respect to the frequent words list.
- * can output the closest author text.
+ * reads a features flag value, at the format: "<kind>:<n>[,<kind>:<n>..]" (kind is word, char
+ * or bits) into <features>.
+ * @param value: the flag's value.
+ * @param features: receives the features.
+ * @return true if the value is well formed.
  */
-class FrequenciesDetector
+bool parseFeatures(const std::string &value, FeatureConfig &features)
 {
-private:
-    /**
-     * represents a separator(to tell word bounds).
-     */
-    const boost::char_separator<char> _sep{"\";:! ," OS_NL};
-
-    /**
-     * holds the frequent words as lower-cased, no duplications. each has a unique int
-     * (all int from 0 to numberOfUniqueWords - 1).
-     */
-    std::unordered_map<std::string, unsigned long> _fw; //unordered_map for more effective run
-
-    /**
-     * holds the vector representing the frequencies in regard to the unknown author.
-     */
-    std::vector<int> _base;
-
-    /**
-    * holds the names of the files and their distance from _base.
-    */
-    //Iv'e used multimap for finding the first of greatest elements, and maintain duplicaties
-    // (according to school solution)
-    std::multimap<std::string, double> _distances;
-
-    /**
-     * reads the words in <inFile>, and stores them in a _fw without duplications.
-     * each word is associated to a unique, non-negative int.
-     * those ints are consistent (all int from 0 to (numberOfUniqueWords - 1) appear).
-     * assumption: the words in <inFile> are lowercased.
-     * @param inFile: the file containing the words.
-     */
-    void _storeFrequentWords(std::ifstream &inFile)
-    {
-        std::string currentWord;
-        if (inFile)
-        {
-            while (inFile >> currentWord)
-            {
-                if (_fw.end() == _fw.find(currentWord)) //not an error: https://youtrack.jetbrains.com/issue/CPP-11511
-                {
-                    _fw[currentWord] = _fw.size();
-                }
-            }
+    size_t start = 0;
+    while (start < value.size())
+    {
+        size_t end = value.find(',', start);
+        end = (end == std::string::npos) ? value.size() : end;
+        const std::string item = value.substr(start, end - start);
+        unsigned int n;
+        if (std::sscanf(item.c_str(), "word:%u", &n) == 1)
+        {
+            features.wordN = n;
+        }
+        else if (std::sscanf(item.c_str(), "char:%u", &n) == 1)
+        {
+            features.charN = n;
+        }
+        else if (std::sscanf(item.c_str(), "bits:%u", &n) == 1)
+        {
+            features.bits = n;
+        }
+        else
+        {
+            return false;
+        }
+        start = end + 1;
+    }
+    return true;
+}
+
+/**
+ * reads a tokenizer flag value, at the format: "unicode[:<class>[,<class>..]]" (class is space,
+ * punct, digit or symbol; space and punct by default) into <features>.
+ * @param value: the flag's value.
+ * @param features: receives the tokenizer.
+ * @return true if the value is well formed.
+ */
+bool parseTokenizer(const std::string &value, FeatureConfig &features)
+{
+    if (value.compare(0, 7, "unicode") != 0 || (value.size() > 7 && value[7] != ':'))
+    {
+        return false;
+    }
+    features.unicode = true;
+    if (value.size() <= 8)
+    {
+        return value.size() == 7;
+    }
+    features.delimiters = 0;
+    size_t start = 8;
+    while (start <= value.size())
+    {
+        size_t end = value.find(',', start);
+        end = (end == std::string::npos) ? value.size() : end;
+        const std::string item = value.substr(start, end - start);
+        if (item == "space")
+        {
+            features.delimiters |= DELIM_SPACE;
+        }
+        else if (item == "punct")
+        {
+            features.delimiters |= DELIM_PUNCT;
+        }
+        else if (item == "digit")
+        {
+            features.delimiters |= DELIM_DIGIT;
+        }
+        else if (item == "symbol")
+        {
+            features.delimiters |= DELIM_SYMBOL;
+        }
+        else
+        {
+            return false;
         }
+        start = end + 1;
     }
+    return true;
+}
 
-    /**
-     * @param f: in-stream.
-     * @return a vector representing the frequencies in f, according to _fw keying.
-     */
-    const std::vector<int> _getFrequency(std::ifstream &f)
+/**
+ * reads the flags at the beginning of argv into <options>.
+ * @param argc: number of program arguments
+ * @param argv: list of program's argument (argv[0] = the name of the program).
+ * @param options: receives the flags.
+ * @return the index of the first non-flag argument, or 0 if a flag is malformed.
+ */
+int parseOptions(int argc, char* argv[], Options &options)
+{
+    int i = 1;
+    for (; i < argc && std::string(argv[i]).compare(0, 2, "--") == 0; ++i)
     {
-        std::vector<int> freqVec(_fw.size(), 0);
-        std::string sentence;
-        while (getline(f, sentence))
+        const std::string flag(argv[i]);
+        if (flag.compare(0, 6, "--top=") == 0)
         {
-            tokenizer wordsInSentence(sentence, _sep);
-            for (const std::string &word : wordsInSentence)
+            if (!parseCount(flag.c_str() + 6, options.top))
             {
-                std::string lowerWord = boost::algorithm::to_lower_copy(word);
-                for (const auto &frequentWord : _fw)
-                {
-                    if (lowerWord == frequentWord.first)
-                    {
-                        ++freqVec[frequentWord.second - 1];
-                    }
-                }
+                return 0;
             }
         }
-        return freqVec;
+        else if (flag == "--approx")
+        {
+            options.approx = true;
+        }
+        else if (flag.compare(0, 9, "--approx=") == 0)
+        {
+            options.approx = true;
+            int used = 0;
+            if (std::sscanf(flag.c_str() + 9, "%u,%u%n", &options.tables, &options.bits, &used) != 2
+                || flag.c_str()[9 + used] != '\0' || options.tables == 0)
+            {
+                return 0;
+            }
+        }
+        else if (flag == "--recall")
+        {
+            options.recall = true;
+        }
+        else if (flag == "--serve")
+        {
+            options.serve = true;
+        }
+        else if (flag == "--follow")
+        {
+            options.follow = true;
+        }
+        else if (flag == "--stats")
+        {
+            options.stats = true;
+        }
+        else if (flag == "--compile-words")
+        {
+            options.compile = true;
+        }
+        else if (flag.compare(0, 12, "--tokenizer=") == 0)
+        {
+            if (!parseTokenizer(flag.substr(12), options.features))
+            {
+                return 0;
+            }
+        }
+        else if (flag.compare(0, 10, "--readers=") == 0)
+        {
+            size_t readers = 0;
+            if (!parseCount(flag.c_str() + 10, readers) || readers > UINT_MAX)
+            {
+                return 0;
+            }
+            options.readers = (unsigned int) readers;
+        }
+        else if (flag.compare(0, 11, "--features=") == 0)
+        {
+            if (!parseFeatures(flag.substr(11), options.features))
+            {
+                return 0;
+            }
+        }
+        else if (flag.compare(0, 8, "--batch=") == 0)
+        {
+            options.batch = flag.substr(8);
+        }
+        else if (flag.compare(0, 8, "--serve=") == 0)
+        {
+            options.serve = true;
+            options.socket = flag.substr(8);
+        }
+        else
+        {
+            return 0;
+        }
+    }
+    if (options.stats && (options.serve || options.follow || options.compile || !options.batch.empty()))
+    {
+        // the per-file records only cover the single-unknown mode.
+        return 0;
+    }
+    if ((options.approx || options.recall || options.serve || options.follow || !options.batch.empty())
+        && options.top == 0)
+    {
+        options.top = 1;
+    }
+    return i;
+}
+
+/**
+ * exits with failure (after an informative error msg) if <fd>'s frequent words file was a corrupt
+ * serialized vocabulary.
+ * @param fd: the detector, just initialized.
+ */
+void checkWords(const FrequenciesDetector &fd)
+{
+    if (!fd.good())
+    {
+        std::cerr << VOCAB_ERR << std::endl;
+        exit(EXIT_FAILURE);
+    }
+}
+
+/**
+ * serializes the frequent words in <wordsPath> to <vocabPath>, so that any mode can load them (in
+ * place of the words' list) by mapping instead of parsing.
+ * @param wordsPath: the frequent words' list.
+ * @param vocabPath: receives the serialized vocabulary.
+ * @return 0 if succeed, prints informative error msg and exits with failure otherwise.
+ */
+int compileWords(const char *wordsPath, const char *vocabPath)
+{
+    auto frequentWordsFile = std::make_shared<const MappedFile>(wordsPath);
+    std::ofstream vocabFile(vocabPath, std::ios::binary);
+    if (!*frequentWordsFile || !vocabFile)
+    {
+        std::cerr << FIO_ERR << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    FrequenciesDetector fd(frequentWordsFile);
+    checkWords(fd);
+    fd.words().save(vocabFile);
+    if (!vocabFile.flush())
+    {
+        std::cerr << FIO_ERR << std::endl;
+        exit(EXIT_FAILURE);
     }
+    return 0;
+}
+
+/**
+ * @param argc: number of program arguments
+ * @param argv: list of program's argument (argv[0] = the name of the program).
+ * @param first: the index of the first author file in argv.
+ * @return the author files' paths.
+ */
+std::vector<std::string> authorPaths(int argc, char* argv[], int first)
+{
+    return std::vector<std::string>(argv + first, argv + argc);
+}
 
-    /**
-     * @param begin1: iterator that points at the first element in vec1.
-     * @param end1: iterator that points at the end of vec1 (after last element).
-     * @param begin2:  iterator that points at the first element in vec2.
-     * @param end2: iterator that points at the end of vec2 (after last element).
-     * @return: the distance between vec1 and vec2 in radians.
-     */
-    static const double _distBetweenVectors(std::vector<int> const& v1,
-                                            std::vector<int> const& v2)
+/**
+ * loads the frequent words and the authors once, and answers attribution queries until the input
+ * (stdin, or the socket) ends.
+ * @param argc: number of program arguments
+ * @param argv: list of program's argument (argv[0] = the name of the program).
+ * @param first: the index of <frequent_words.txt> in argv.
+ * @param options: the program's flags.
+ * @return 0 if succeed, prints informative error msg and exits with failure otherwise.
+ */
+int serve(int argc, char* argv[], int first, const Options &options)
+{
+    auto frequentWordsFile = std::make_shared<const MappedFile>(argv[first]);
+    if (!*frequentWordsFile)
+    {
+        std::cerr << FIO_ERR << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    FrequenciesDetector fd(frequentWordsFile, options.features);
+    checkWords(fd);
+    FilePrefetcher authorFiles(authorPaths(argc, argv, first + 1), options.readers);
+    for (int i = first + 1; i < argc; ++i)
     {
-        double innerProduct = std::inner_product(v1.begin(), v1.end(), v2.begin(), 0.0);
-        double norm1 = sqrt(std::inner_product(v1.begin(), v1.end(), v1.begin(), 0.0));
-        double norm2 = sqrt(std::inner_product( v2.begin(), v2.end(), v2.begin(), 0.0));
-        return (norm1 * norm2 == 0) ? 0 : innerProduct / (norm1 * norm2);
+        std::unique_ptr<MappedFile> authorFile = authorFiles.next();
+        if (!*authorFile)
+        {
+            std::cerr << FIO_ERR << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        fd.addAuthor(*authorFile, argv[i]);
+    }
+    if (options.approx)
+    {
+        fd.buildApproxIndex(options.tables, options.bits);
     }
 
-    /**
-     * comparator to compare the values of pairs of the form: <key, value>.
-     * @param p1: pair<std::string, double>.
-     * @param p2: pair<std::string, double>.
-     * @return true if the value of p2 is grater than the value of p1. false otherwise.
-     */
-    static const bool _valueComparator(const std::pair<std::string, double>& p1,
-                                       const std::pair<std::string, double>& p2)
+    AttributionServer server(fd, options.top, options.approx);
+    std::cerr << "Ready: " << fd.authors().size() << " authors loaded" << std::endl;
+    if (options.socket.empty())
     {
-        return p1.second < p2.second;
+        server.serve(std::cin, std::cout);
+        return 0;
     }
+    server.serveSocket(options.socket);
+    std::cerr << SOCKET_ERR << std::endl;
+    exit(EXIT_FAILURE);
+}
 
-public:
+/**
+ * loads the frequent words, the authors, and every unknown text listed (one path per line) in the
+ * batch file, then scores all the unknown texts against all the authors at once. prints, for every
+ * unknown text in turn: "Best matching author for <unknown> is <fName> score <distance>\n", or
+ * with --top=<k> (k > 1): "Top <k> matching authors for <unknown>:\n" and a
+ * "<rank> <fName> <distance>\n" line per file.
+ * like the school solution, an unknown text that can't be read scores 0.
+ * @param argc: number of program arguments
+ * @param argv: list of program's argument (argv[0] = the name of the program).
+ * @param first: the index of <frequent_words.txt> in argv.
+ * @param options: the program's flags.
+ * @return 0 if succeed, prints informative error msg and exits with failure otherwise.
+ */
+int batch(int argc, char* argv[], int first, const Options &options)
+{
+    auto frequentWordsFile = std::make_shared<const MappedFile>(argv[first]);
+    std::ifstream batchFile(options.batch);
+    if (!*frequentWordsFile || !batchFile)
+    {
+        std::cerr << FIO_ERR << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    std::vector<std::string> unknownPaths;
+    std::string line;
+    while (std::getline(batchFile, line))
+    {
+        if (!line.empty() && line.back() == '\r')
+        {
+            line.pop_back();
+        }
+        if (!line.empty())
+        {
+            unknownPaths.push_back(line);
+        }
+    }
+    FrequenciesDetector fd(frequentWordsFile, options.features);
+    checkWords(fd);
+    FilePrefetcher authorFiles(authorPaths(argc, argv, first + 1), options.readers);
+    for (int i = first + 1; i < argc; ++i)
+    {
+        std::unique_ptr<MappedFile> authorFile = authorFiles.next();
+        if (!*authorFile)
+        {
+            std::cerr << FIO_ERR << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        fd.addAuthor(*authorFile, argv[i]);
+    }
 
-    /**
-     * initializes a new FrequenciesDetector, that holds a map of frequent words given in <inFile>.
-     * @param inFile stream holding the frequent words.
-     */
-    FrequenciesDetector(std::ifstream &inFile, std::ifstream &baseFile)
+    ProfileMatrix queries = fd.queryMatrix();
+    FilePrefetcher unknownFiles(unknownPaths, options.readers);
+    for (size_t i = 0; i < unknownPaths.size(); ++i)
+    {
+        fd.addQuery(*unknownFiles.next(), queries);
+    }
+    const std::vector<std::vector<AuthorMatch>> ranks = fd.rankBatch(queries, options.top);
+    for (size_t i = 0; i < ranks.size(); ++i)
     {
-        _storeFrequentWords(inFile);
-        _base = _getFrequency(baseFile);
+        if (options.top == 1)
+        {
+            std::cout << "Best matching author for " << unknownPaths[i] << " is " << ranks[i][0].name
+                      << " score " << ranks[i][0].score << std::endl;
+            continue;
+        }
+        std::cout << "Top " << options.top << " matching authors for " << unknownPaths[i] << ":"
+                  << std::endl;
+        for (size_t r = 0; r < ranks[i].size(); ++r)
+        {
+            std::cout << r + 1 << " " << ranks[i][r].name << " " << ranks[i][r].score << std::endl;
+        }
     }
+    return 0;
+}
 
-    /**
-     * computes the distance between this file and the base file.
-     * prints it at the format: "<fName> <distance>\n".
-     * @param f : in file stream.
-     * @param fName : f's name (as given to the program).
-     */
-    void processFile(std::ifstream &f, const std::string &fName)
+/**
+ * prints the files closest to the unknown text read so far, at the format:
+ * "Top <k> matching authors after <n> words:\n" and a "<rank> <fName> <distance>\n" line per file.
+ * @param fd: detector reading the unknown text incrementally.
+ * @param k: number of files to print.
+ */
+void printStreamingRank(FrequenciesDetector &fd, size_t k)
+{
+    const std::vector<AuthorMatch> matches = fd.streamingRank(k);
+    std::cout << "Top " << k << " matching authors after " << fd.streamedWords() << " words:" << std::endl;
+    for (size_t i = 0; i < matches.size(); ++i)
     {
-        double dist = _distBetweenVectors(_base, _getFrequency(f));
-        _distances.insert({fName, dist});
+        std::cout << i + 1 << " " << matches[i].name << " " << matches[i].score << std::endl;
+    }
+}
 
-        std::cout << fName << " " << dist << std::endl;
+/**
+ * loads the frequent words and the authors, then reads the unknown text piece by piece as it
+ * arrives (from stdin until it ends, or from a file that is followed like tail -f), and prints
+ * the updated ranking after every piece.
+ * @param argc: number of program arguments
+ * @param argv: list of program's argument (argv[0] = the name of the program).
+ * @param first: the index of <frequent_words.txt> in argv.
+ * @param options: the program's flags.
+ * @return 0 if succeed, prints informative error msg and exits with failure otherwise.
+ */
+int follow(int argc, char* argv[], int first, const Options &options)
+{
+    auto frequentWordsFile = std::make_shared<const MappedFile>(argv[first]);
+    const std::string unknownName(argv[first + 1]);
+    int unknownFile = (unknownName == "-") ? STDIN_FILENO : open(unknownName.c_str(), O_RDONLY);
+    if (!*frequentWordsFile || unknownFile < 0)
+    {
+        std::cerr << FIO_ERR << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    FrequenciesDetector fd(frequentWordsFile, options.features);
+    checkWords(fd);
+    FilePrefetcher authorFiles(authorPaths(argc, argv, first + 2), options.readers);
+    for (int i = first + 2; i < argc; ++i)
+    {
+        std::unique_ptr<MappedFile> authorFile = authorFiles.next();
+        if (!*authorFile)
+        {
+            std::cerr << FIO_ERR << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        fd.addAuthor(*authorFile, argv[i]);
     }
 
-    /**
-     * prints the greatest distanced file (among the files that has been entered up to this point)
-     * in the format: "Best matching author is <fName> score <distance>\n".
-     */
-    void maxDistance() const
+    char buffer[FOLLOW_CHUNK];
+    ssize_t n;
+    while ((n = read(unknownFile, buffer, sizeof(buffer))) >= 0)
     {
-        auto maxElement = std::max_element(_distances.begin(), _distances.end(), _valueComparator);
-        // i assume frequent_words and unknown exists (so max element->first isn't " " like in school sol).
-        std::cout << "Best matching author is " << maxElement->first <<
-             " score " << maxElement->second << std::endl;
+        if (n > 0)
+        {
+            fd.appendBase(std::string(buffer, n));
+            printStreamingRank(fd, options.top);
+        }
+        else if (unknownFile == STDIN_FILENO)
+        {
+            fd.finishBase();
+            printStreamingRank(fd, options.top);
+            return 0;
+        }
+        else
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(FOLLOW_POLL_MS));
+        }
     }
-};
+    std::cerr << FIO_ERR << std::endl;
+    exit(EXIT_FAILURE);
+}
 
 /**
  * runs the find_the_author program
@@ -177,31 +518,60 @@ public:
  */
 int main(int argc, char* argv[])
 {
-    if (argc > 3)
+    Options options;
+    int first = parseOptions(argc, argv, options);
+    if (first > 0 && options.compile && argc - first == 2)
     {
-        std::ifstream frequentWordsFile(argv[1]);
-        std::ifstream unknownFile(argv[2]);
-        if (unknownFile && frequentWordsFile)
+        return compileWords(argv[first], argv[first + 1]);
+    }
+    if (first > 0 && !options.batch.empty() && argc - first > 1)
+    {
+        return batch(argc, argv, first, options);
+    }
+    if (first > 0 && options.serve && argc - first > 1)
+    {
+        return serve(argc, argv, first, options);
+    }
+    if (first > 0 && options.follow && argc - first > 2)
+    {
+        return follow(argc, argv, first, options);
+    }
+    if (first > 0 && !options.serve && !options.compile && argc - first > 2)
+    {
+        Instrumentation stats(std::cerr, options.stats);
+        MappedFile unknownFile(argv[first + 1]);
+        stats.begin(argv[first], "words");
+        auto frequentWordsFile = std::make_shared<const MappedFile>(argv[first]);
+        if (unknownFile && *frequentWordsFile)
         {
-            FrequenciesDetector fd(frequentWordsFile , unknownFile);
-            unknownFile.close();
-            frequentWordsFile.close();
-            std::ifstream tmpFile;
-            for (unsigned int i = 3; i < argc; ++i)
+            FrequenciesDetector fd(frequentWordsFile, options.features);
+            checkWords(fd);
+            stats.lap(&FileStats::readMs);
+            stats.current().bytes = frequentWordsFile->size();
+            stats.end();
+            fd.setStats(&stats);
+            stats.begin(argv[first + 1], "unknown");
+            fd.setBase(unknownFile);
+            stats.end();
+            FilePrefetcher authorFiles(authorPaths(argc, argv, first + 2), options.readers);
+            for (int i = first + 2; i < argc; ++i)
             {
-                tmpFile.open(argv[i]);
-                fd.processFile(tmpFile, argv[i]);
-                if (tmpfile)
-                {
-                    tmpFile.close();
-                }
-                else
+                // like the school solution, a file that can't be read scores 0.
+                stats.begin(argv[i], "author");
+                std::unique_ptr<MappedFile> authorFile = authorFiles.next();
+                stats.lap(&FileStats::readMs);
+                fd.processFile(*authorFile, argv[i]);
+                stats.end();
+            }
+            fd.maxDistance();
+            if (options.top > 0)
+            {
+                if (options.approx)
                 {
-                    std::cerr << FIO_ERR << std::endl;
-                    exit(EXIT_FAILURE);
+                    fd.buildApproxIndex(options.tables, options.bits);
                 }
+                fd.topDistances(options.top, options.approx, options.recall);
             }
-            fd.maxDistance();
             return 0;
         }
         std::cerr << FIO_ERR << std::endl;
@@ -0,0 +1,302 @@
+//
+// Created by baraloni, ex3 cpp 2018-19 winter semester.
+// contains the accumulation policies of the matrix product.
+//
+
+#ifndef EX3_ACCUMULATION_HPP
+#define EX3_ACCUMULATION_HPP
+#include <cstddef>
+#include <vector>
+#include <type_traits>
+#include "HalfFloat.hpp"
+#include "MatrixView.hpp"
+
+/** length of the runs a pairwise sum adds up in order (longer runs are split in halves).*/
+#define PAIRWISE_BLOCK 16
+
+
+//*********************************************Accumulators****************************************
+
+/**
+ * names the type a product of T cells is accumulated in by default: T itself, but float for the
+ * 16-bit storage types (which have too few bits to accumulate in).
+ * @tparam T: the cells' type.
+ */
+template <typename T>
+struct AccumulatorOf
+{
+    typedef T type;
+};
+
+template <typename Bits>
+struct AccumulatorOf<Float16<Bits>>
+{
+    typedef float type;
+};
+
+/**
+ * names a type that holds the sums of T products without overflow (integers) or with less
+ * rounding (floating point): int64 for the ints, double for float, float for the 16-bit types.
+ * @tparam T: the cells' type.
+ */
+template <typename T>
+struct WiderType
+{
+    typedef typename AccumulatorOf<T>::type type;
+};
+
+template <> struct WiderType<signed char> {typedef long long type;};
+template <> struct WiderType<unsigned char> {typedef unsigned long long type;};
+template <> struct WiderType<short> {typedef long long type;};
+template <> struct WiderType<unsigned short> {typedef unsigned long long type;};
+template <> struct WiderType<int> {typedef long long type;};
+template <> struct WiderType<unsigned int> {typedef unsigned long long type;};
+template <> struct WiderType<float> {typedef double type;};
+
+/**
+ * @tparam R the product's cells' type
+ * @param sum an accumulated cell
+ * @return the cell, as R (exactly, for integers: a sum R can't hold throws AccumulationOverflow)
+ */
+template <typename R, typename Acc>
+inline R narrowCell(Acc const& sum, std::true_type /*integers*/)
+{
+    const R cell = static_cast<R>(sum);
+    if (static_cast<Acc>(cell) != sum)
+    {
+        throw AccumulationOverflow{};
+    }
+    return cell;
+}
+
+/**
+ * @tparam R the product's cells' type
+ * @param sum an accumulated cell
+ * @return the cell, as R (rounded)
+ */
+template <typename R, typename Acc>
+inline R narrowCell(Acc const& sum, std::false_type /*integers*/)
+{
+    return static_cast<R>(sum);
+}
+
+/**
+ * @tparam R the product's cells' type
+ * @param sum an accumulated cell
+ * @return the cell, as R
+ */
+template <typename R, typename Acc>
+inline R narrowCell(Acc const& sum)
+{
+    return narrowCell<R>(sum, std::integral_constant<bool, std::is_integral<R>::value &&
+                                                         std::is_integral<Acc>::value &&
+                                                         !std::is_same<R, Acc>::value>());
+}
+
+
+//*********************************************Kernels*********************************************
+
+/**
+ * writes the product a * b into out, accumulating row by row (so both matrices are read in
+ * order): out's row i is the sum over k of a[i,k] * b's row k, in Acc, optionally compensated
+ * (Kahan: the rounding error of every addition is carried into the next one).
+ * @tparam Acc the accumulator's type
+ * @param a left matrix
+ * @param b right matrix
+ * @param out receives the product (must not overlap a or b)
+ * @param compensated true for Kahan summation
+ */
+template <typename Acc, typename T, typename R>
+void accumulateRows(MatrixView<const T> const& a, MatrixView<const T> const& b,
+                    MatrixView<R> const& out, const bool compensated)
+{
+    const unsigned int cols = b.cols();
+    std::vector<Acc> sums(cols), errors(compensated ? cols : 0);
+    for (unsigned int i = 0; i < a.rows(); ++i)
+    {
+        for (unsigned int j = 0; j < cols; ++j)
+        {
+            sums[j] = Acc(0);
+        }
+        for (unsigned int j = 0; j < errors.size(); ++j)
+        {
+            errors[j] = Acc(0);
+        }
+        const T *left = a.data() + (size_t) i * a.stride();
+        for (unsigned int k = 0; k < a.cols(); ++k)
+        {
+            const Acc factor = static_cast<Acc>(left[k]);
+            const T *right = b.data() + (size_t) k * b.stride();
+            if (compensated)
+            {
+                for (unsigned int j = 0; j < cols; ++j)
+                {
+                    const Acc term = factor * static_cast<Acc>(right[j]) - errors[j];
+                    const Acc sum = sums[j] + term;
+                    errors[j] = (sum - sums[j]) - term;
+                    sums[j] = sum;
+                }
+                continue;
+            }
+            for (unsigned int j = 0; j < cols; ++j)
+            {
+                sums[j] += factor * static_cast<Acc>(right[j]);
+            }
+        }
+        R *row = out.data() + (size_t) i * out.stride();
+        for (unsigned int j = 0; j < cols; ++j)
+        {
+            row[j] = narrowCell<R>(sums[j]);
+        }
+    }
+}
+
+/**
+ * @param terms points to the terms
+ * @param n num of terms
+ * @return the terms' sum, added up pairwise: halves are summed separately, down to runs of
+ * PAIRWISE_BLOCK terms (so the rounding error grows with log(n) rather than n)
+ */
+template <typename Acc>
+Acc pairwiseSum(const Acc *terms, const size_t n)
+{
+    if (n <= PAIRWISE_BLOCK)
+    {
+        Acc sum = Acc(0);
+        for (size_t k = 0; k < n; ++k)
+        {
+            sum += terms[k];
+        }
+        return sum;
+    }
+    const size_t half = n / 2;
+    return pairwiseSum(terms, half) + pairwiseSum(terms + half, n - half);
+}
+
+/**
+ * writes the product a * b into out, every cell a pairwise sum (see pairwiseSum) of its terms.
+ * @tparam Acc the accumulator's type
+ * @param a left matrix
+ * @param b right matrix
+ * @param out receives the product (must not overlap a or b)
+ */
+template <typename Acc, typename T, typename R>
+void accumulatePairwise(MatrixView<const T> const& a, MatrixView<const T> const& b,
+                        MatrixView<R> const& out)
+{
+    const unsigned int inner = a.cols();
+    // b's columns, as contiguous rows of accumulators:
+    std::vector<Acc> columns((size_t) b.cols() * inner), left(inner), terms(inner);
+    for (unsigned int k = 0; k < inner; ++k)
+    {
+        for (unsigned int j = 0; j < b.cols(); ++j)
+        {
+            columns[(size_t) j * inner + k] = static_cast<Acc>(b.data()[(size_t) k * b.stride() + j]);
+        }
+    }
+    for (unsigned int i = 0; i < a.rows(); ++i)
+    {
+        for (unsigned int k = 0; k < inner; ++k)
+        {
+            left[k] = static_cast<Acc>(a.data()[(size_t) i * a.stride() + k]);
+        }
+        R *row = out.data() + (size_t) i * out.stride();
+        for (unsigned int j = 0; j < b.cols(); ++j)
+        {
+            const Acc *column = columns.data() + (size_t) j * inner;
+            for (unsigned int k = 0; k < inner; ++k)
+            {
+                terms[k] = left[k] * column[k];
+            }
+            row[j] = narrowCell<R>(pairwiseSum(terms.data(), inner));
+        }
+    }
+}
+
+
+//*********************************************Policies********************************************
+
+// a policy's multiply(a, b, out) writes the product a * b into out (of the same dimensions).
+// the policies go to Matrix<T>::multiply<Policy, R>(other), e.g.
+//     Matrix<long long> exact = ints.multiply<WideAccumulation, long long>(ints);
+//     Matrix<float> accurate = floats.multiply<KahanAccumulation>(floats);
+// a product of integers narrowed back into a narrower type throws AccumulationOverflow if a cell
+// doesn't fit; every other conversion rounds.
+
+/**
+ * accumulates in AccumulatorOf<T> (T, or float for the 16-bit types), in order. a product in T's
+ * own arithmetic goes through multiply(a, b, out) of MatrixView.hpp, so 2X2, 3X3 and 4X4 products
+ * run the fixed-size kernel.
+ */
+struct PlainAccumulation
+{
+    template <typename T, typename R>
+    static void multiply(MatrixView<const T> const& a, MatrixView<const T> const& b,
+                         MatrixView<R> const& out)
+    {
+        multiply(a, b, out, std::integral_constant<bool, std::is_same<T, R>::value &&
+                            std::is_same<typename AccumulatorOf<T>::type, T>::value>());
+    }
+
+    template <typename T>
+    static void multiply(MatrixView<const T> const& a, MatrixView<const T> const& b,
+                         MatrixView<T> const& out, std::true_type /*T's own arithmetic*/)
+    {
+        ::multiply(a, b, out);
+    }
+
+    template <typename T, typename R>
+    static void multiply(MatrixView<const T> const& a, MatrixView<const T> const& b,
+                         MatrixView<R> const& out, std::false_type /*T's own arithmetic*/)
+    {
+        accumulateRows<typename AccumulatorOf<T>::type>(a, b, out, false);
+    }
+};
+
+/**
+ * accumulates in WiderType<T> (int64 for int, double for float), in order.
+ */
+struct WideAccumulation
+{
+    template <typename T, typename R>
+    static void multiply(MatrixView<const T> const& a, MatrixView<const T> const& b,
+                         MatrixView<R> const& out)
+    {
+        accumulateRows<typename WiderType<T>::type>(a, b, out, false);
+    }
+};
+
+/**
+ * accumulates in AccumulatorOf<T>, in order, with Kahan (compensated) summation.
+ */
+struct KahanAccumulation
+{
+    template <typename T, typename R>
+    static void multiply(MatrixView<const T> const& a, MatrixView<const T> const& b,
+                         MatrixView<R> const& out)
+    {
+        accumulateRows<typename AccumulatorOf<T>::type>(a, b, out, true);
+    }
+};
+
+/**
+ * accumulates in AccumulatorOf<T>, pairwise.
+ */
+struct PairwiseAccumulation
+{
+    template <typename T, typename R>
+    static void multiply(MatrixView<const T> const& a, MatrixView<const T> const& b,
+                         MatrixView<R> const& out)
+    {
+        accumulatePairwise<typename AccumulatorOf<T>::type>(a, b, out);
+    }
+};
+
+/**
+ * names the policy of Matrix<T>::operator* (T's own arithmetic, as always; float for the 16-bit
+ * storage types).
+ */
+typedef PlainAccumulation DefaultAccumulation;
+
+
+#endif //EX3_ACCUMULATION_HPP
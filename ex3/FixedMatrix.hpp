@@ -0,0 +1,220 @@
+//
+// Created by baraloni, ex3 cpp 2018-19 winter semester.
+// contains a generic matrix class whose dimensions are known at compile time.
+//
+
+#ifndef EX3_FIXEDMATRIX_HPP
+#define EX3_FIXEDMATRIX_HPP
+#include "MatrixView.hpp"
+
+
+//*********************************************FixedMatrix*****************************************
+
+/**
+ * represents a R X C matrix held inline (no heap allocation), in row-major order, so arrays of
+ * fixed matrices are contiguous cells the batched kernels go over.
+ * @tparam T: must implement the operators: +, -, -=, +=, *, ==, =.
+ *            and copy-constructor, and zero-constructor.
+ * @tparam R: num of rows (positive).
+ * @tparam C: num of cols (positive).
+ */
+template <typename T, unsigned int R, unsigned int C>
+class FixedMatrix
+{
+    static_assert(R > 0 && C > 0, "a fixed matrix needs positive dimensions");
+
+private:
+    //fields:
+    /**
+     * holds the matrix cells
+     */
+    T _cells[R * C];
+
+public:
+    //Constructors:
+    /**
+     * constructs a new matrix of (T)0
+     */
+    FixedMatrix()
+    {
+        for (unsigned int i = 0; i < R * C; ++i)
+        {
+            _cells[i] = T(0);
+        }
+    }
+
+    /**
+     * constructs a new matrix, filled in values from cells
+     * @param cells points to R * C cells, in row-major order
+     */
+    explicit FixedMatrix(const T *cells)
+    {
+        for (unsigned int i = 0; i < R * C; ++i)
+        {
+            _cells[i] = cells[i];
+        }
+    }
+
+    /**
+     * constructs a new matrix, filled in values from the cells a view sees
+     * @param view a R X C view
+     */
+    explicit FixedMatrix(MatrixView<const T> const& view)
+    {
+        if (view.rows() != R || view.cols() != C)
+        {
+            throw ViewDimensions{};
+        }
+        for (unsigned int r = 0; r < R; ++r)
+        {
+            for (unsigned int c = 0; c < C; ++c)
+            {
+                _cells[r * C + c] = view.data()[(size_t) r * view.stride() + c];
+            }
+        }
+    }
+
+    //Operators:
+    /**
+     * @param other matrix
+     * @return new matrix that represents the sum of adding this matrix and the other matrix
+     */
+    FixedMatrix operator+(FixedMatrix const& other) const
+    {
+        FixedMatrix tmp(*this);
+        for (unsigned int i = 0; i < R * C; ++i)
+        {
+            tmp._cells[i] += other._cells[i];
+        }
+        return tmp;
+    }
+
+    /**
+     * @param other matrix
+     * @return new matrix that represents the difference of subtracting other matrix from this
+     */
+    FixedMatrix operator-(FixedMatrix const& other) const
+    {
+        FixedMatrix tmp(*this);
+        for (unsigned int i = 0; i < R * C; ++i)
+        {
+            tmp._cells[i] -= other._cells[i];
+        }
+        return tmp;
+    }
+
+    /**
+     * @tparam K the other matrix's num of cols
+     * @param other matrix
+     * @return new matrix that represents the product of multiplying this matrix and the other
+     */
+    template <unsigned int K>
+    FixedMatrix<T, R, K> operator*(FixedMatrix<T, C, K> const& other) const
+    {
+        FixedMatrix<T, R, K> product;
+        fixedMultiply<T, R, C, K>(_cells, other.data(), product.data());
+        return product;
+    }
+
+    /**
+     * @param other matrix
+     * @return true it the other matrix and this are equal, false otherwise
+     */
+    bool operator==(FixedMatrix const& other) const
+    {
+        for (unsigned int i = 0; i < R * C; ++i)
+        {
+            if (_cells[i] != other._cells[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @param other matrix
+     * @return false it the other matrix and this are equal, true otherwise
+     */
+    bool operator!=(FixedMatrix const& other) const
+    {
+        return !(*this == other);
+    }
+
+    /**
+     * @param r row num
+     * @param c col num
+     * @return the value of the matrix's cell[r,c]
+     */
+    T& operator()(const unsigned int r, const unsigned int c)
+    {
+        if (r < R && c < C)
+        {
+            return _cells[r * C + c];
+        }
+        throw MatrixOutOfBounds{};
+    }
+
+    /**
+     * @param r row num
+     * @param c col num
+     * @return the value of the matrix's cell[r,c]
+     */
+    T const& operator()(const unsigned int r, const unsigned int c) const
+    {
+        if (r < R && c < C)
+        {
+            return _cells[r * C + c];
+        }
+        throw MatrixOutOfBounds{};
+    }
+
+    //General functionality:
+    /**
+     * @return the num of rows of this matrix
+     */
+    static constexpr unsigned int rows() {return R;}
+
+    /**
+     * @return the num of cols of this matrix
+     */
+    static constexpr unsigned int cols() {return C;}
+
+    /**
+     * @return a pointer to the matrix's R * C cells, in row-major order
+     */
+    inline T *data() {return _cells;}
+
+    /**
+     * @return a pointer to the matrix's R * C cells, in row-major order
+     */
+    inline const T *data() const {return _cells;}
+
+    /**
+     * @return a view of this matrix's cells
+     */
+    inline MatrixView<T> view() {return MatrixView<T>(_cells, R, C);}
+
+    /**
+     * @return a read-only view of this matrix's cells
+     */
+    inline MatrixView<const T> view() const {return MatrixView<const T>(_cells, R, C);}
+
+    /**
+     * names a const iterator of the fixed matrix class
+     */
+    typedef const T *const_iterator;
+
+    /**
+     * @return constant iterator to the beggining of the matrix (first element)
+     */
+    inline const_iterator begin() const {return _cells;}
+
+    /**
+     * @return constant iterator to the end of the matrix (after last element)
+     */
+    inline const_iterator end() const {return _cells + R * C;}
+};
+
+
+#endif //EX3_FIXEDMATRIX_HPP
@@ -0,0 +1,271 @@
+//
+// Created by baraloni, ex3 cpp 2018-19 winter semester.
+// contains 16-bit floating-point storage types (IEEE half precision, and bfloat16).
+//
+
+#ifndef EX3_HALFFLOAT_HPP
+#define EX3_HALFFLOAT_HPP
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+
+
+//*********************************************Conversions*****************************************
+
+/**
+ * @param f float
+ * @return f's bits
+ */
+inline uint32_t floatBits(const float f)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &f, sizeof(bits));
+    return bits;
+}
+
+/**
+ * @param bits a float's bits
+ * @return the float
+ */
+inline float bitsFloat(const uint32_t bits)
+{
+    float f;
+    std::memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+/**
+ * @param f float
+ * @return the nearest IEEE half-precision value's bits (ties to even; overflow to infinity), the
+ * same bits F16C's conversion gives.
+ */
+inline uint16_t floatToHalfBits(const float f)
+{
+    const uint32_t bits = floatBits(f);
+    const uint16_t sign = (uint16_t) ((bits >> 16) & 0x8000u);
+    const uint32_t magnitude = bits & 0x7FFFFFFFu;
+    if (magnitude > 0x7F800000u) // NaN: quieted, keeping the payload's top bits (as F16C does)
+    {
+        return (uint16_t) (sign | 0x7E00u | ((magnitude >> 13) & 0x03FFu));
+    }
+    if (magnitude == 0x7F800000u)
+    {
+        return (uint16_t) (sign | 0x7C00u);
+    }
+    if (magnitude >= 0x477FF000u) // rounds past the largest half
+    {
+        return (uint16_t) (sign | 0x7C00u);
+    }
+    if (magnitude < 0x38800000u) // below the smallest normal half: a subnormal, or zero
+    {
+        if (magnitude < 0x33000000u)
+        {
+            return sign;
+        }
+        // the value is mantissa * 2^(exponent - 150), and the half's is its bits * 2^-24.
+        const uint32_t mantissa = (magnitude & 0x007FFFFFu) | 0x00800000u;
+        const unsigned int shift = 126 - (magnitude >> 23);
+        uint32_t half = mantissa >> shift;
+        const uint32_t rest = mantissa & ((1u << shift) - 1);
+        const uint32_t midpoint = 1u << (shift - 1);
+        if (rest > midpoint || (rest == midpoint && (half & 1u)))
+        {
+            ++half;
+        }
+        return (uint16_t) (sign | half);
+    }
+    // a normal half: rebias the exponent, and round the mantissa's 13 dropped bits.
+    uint32_t half = ((magnitude >> 13) - (112u << 10));
+    const uint32_t rest = magnitude & 0x1FFFu;
+    if (rest > 0x1000u || (rest == 0x1000u && (half & 1u)))
+    {
+        ++half;
+    }
+    return (uint16_t) (sign | half);
+}
+
+/**
+ * @param half an IEEE half-precision value's bits
+ * @return the value, as a float (exactly, but for a NaN's quiet bit)
+ */
+inline float halfBitsToFloat(const uint16_t half)
+{
+    const uint32_t sign = (uint32_t) (half & 0x8000u) << 16;
+    const uint32_t exponent = (half >> 10) & 0x1Fu;
+    const uint32_t mantissa = half & 0x3FFu;
+    if (exponent == 0x1Fu) // infinity, or NaN (quieted, as F16C does)
+    {
+        return bitsFloat(sign | 0x7F800000u | (mantissa ? 0x00400000u | (mantissa << 13) : 0u));
+    }
+    if (exponent == 0)
+    {
+        // zero, or a subnormal: mantissa * 2^-24.
+        const float value = (float) mantissa * (1.0f / 16777216.0f);
+        return sign ? -value : value;
+    }
+    return bitsFloat(sign | ((exponent + 112u) << 23) | (mantissa << 13));
+}
+
+/**
+ * @param f float
+ * @return the nearest bfloat16 value's bits (ties to even).
+ */
+inline uint16_t floatToBFloat16Bits(const float f)
+{
+    const uint32_t bits = floatBits(f);
+    if ((bits & 0x7FFFFFFFu) > 0x7F800000u) // NaN (kept quiet)
+    {
+        return (uint16_t) ((bits >> 16) | 0x0040u);
+    }
+    return (uint16_t) ((bits + 0x7FFFu + ((bits >> 16) & 1u)) >> 16);
+}
+
+/**
+ * @param bfloat a bfloat16 value's bits
+ * @return the value, as a float (exactly)
+ */
+inline float bfloat16BitsToFloat(const uint16_t bfloat)
+{
+    return bitsFloat((uint32_t) bfloat << 16);
+}
+
+
+//*******************************************Float16***********************************************
+
+/**
+ * represents a 16-bit floating-point storage type: Bits::fromFloat and Bits::toFloat convert its
+ * bits from and to a float. the arithmetic is done in float and rounded back, so the matrices of
+ * 16-bit cells (half the memory traffic of float) should accumulate their products in float
+ * (see Accumulation.hpp).
+ * @tparam Bits: the conversions (HalfBits or BFloat16Bits).
+ */
+template <typename Bits>
+class Float16
+{
+private:
+    /**
+     * holds the value's bits
+     */
+    uint16_t _bits;
+
+public:
+    //Constructors:
+    /**
+     * constructs a zero
+     */
+    Float16():_bits(0){}
+
+    /**
+     * constructs the value nearest to f
+     * @param f float
+     */
+    Float16(const float f):_bits(Bits::fromFloat(f)){}
+
+    //Operators:
+    /**
+     * @return the value, as a float
+     */
+    explicit operator float() const {return Bits::toFloat(_bits);}
+
+    /**
+     * @return the value's bits
+     */
+    inline uint16_t bits() const {return _bits;}
+
+    /**
+     * @param other value
+     * @return the sum, rounded
+     */
+    Float16 operator+(Float16 const& other) const {return Float16((float) *this + (float) other);}
+
+    /**
+     * @param other value
+     * @return the difference, rounded
+     */
+    Float16 operator-(Float16 const& other) const {return Float16((float) *this - (float) other);}
+
+    /**
+     * @param other value
+     * @return the product, rounded
+     */
+    Float16 operator*(Float16 const& other) const {return Float16((float) *this * (float) other);}
+
+    /**
+     * @param other value
+     * @return this value, after adding other (rounded)
+     */
+    Float16& operator+=(Float16 const& other) {return *this = *this + other;}
+
+    /**
+     * @param other value
+     * @return this value, after subtracting other (rounded)
+     */
+    Float16& operator-=(Float16 const& other) {return *this = *this - other;}
+
+    /**
+     * @param other value
+     * @return true if the values are equal (as floats: zeros are equal, NaNs aren't)
+     */
+    bool operator==(Float16 const& other) const {return (float) *this == (float) other;}
+
+    /**
+     * @param other value
+     * @return false if the values are equal, true otherwise
+     */
+    bool operator!=(Float16 const& other) const {return !(*this == other);}
+
+    /**
+     * @param other value
+     * @return true if this value is smaller (as floats: false if either is a NaN)
+     */
+    bool operator<(Float16 const& other) const {return (float) *this < (float) other;}
+
+    /**
+     * @param other value
+     * @return true if this value is larger (as floats: false if either is a NaN)
+     */
+    bool operator>(Float16 const& other) const {return other < *this;}
+};
+
+/**
+ * prints the value (as a float) to the supplied stream
+ * @param os out stream
+ * @param value a 16-bit value
+ * @return the stream
+ */
+template <typename Bits>
+std::ostream& operator<<(std::ostream& os, Float16<Bits> const& value)
+{
+    return os << (float) value;
+}
+
+/**
+ * the conversions of IEEE half precision (5 exponent bits, 10 mantissa bits).
+ */
+struct HalfBits
+{
+    static uint16_t fromFloat(const float f) {return floatToHalfBits(f);}
+    static float toFloat(const uint16_t bits) {return halfBitsToFloat(bits);}
+};
+
+/**
+ * the conversions of bfloat16 (float's 8 exponent bits, 7 mantissa bits).
+ */
+struct BFloat16Bits
+{
+    static uint16_t fromFloat(const float f) {return floatToBFloat16Bits(f);}
+    static float toFloat(const uint16_t bits) {return bfloat16BitsToFloat(bits);}
+};
+
+/**
+ * names the IEEE half-precision storage type
+ */
+typedef Float16<HalfBits> Half;
+
+/**
+ * names the bfloat16 storage type
+ */
+typedef Float16<BFloat16Bits> BFloat16;
+
+
+#endif //EX3_HALFFLOAT_HPP
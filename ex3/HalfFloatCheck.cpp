@@ -0,0 +1,68 @@
+//
+// Created by baraloni, ex3 cpp 2018-19 winter semester.
+// checks the half-precision conversions of HalfFloat.hpp against the processor's (F16C).
+//
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <immintrin.h>
+#include "HalfFloat.hpp"
+
+/**
+ * @param f float
+ * @return F16C's half-precision bits of f (rounded to nearest, ties to even)
+ */
+static uint16_t f16cHalfBits(const float f)
+{
+    return (uint16_t) _mm_extract_epi16(_mm_cvtps_ph(_mm_set_ss(f), _MM_FROUND_TO_NEAREST_INT), 0);
+}
+
+/**
+ * @param half a half-precision value's bits
+ * @return F16C's float of the half
+ */
+static float f16cHalfToFloat(const uint16_t half)
+{
+    return _mm_cvtss_f32(_mm_cvtph_ps(_mm_cvtsi32_si128(half)));
+}
+
+/**
+ * converts every float to half precision, and every half back to float, and compares the bits
+ * with F16C's. prints the first few mismatches and exits with failure if there are any,
+ * otherwise prints the number of checked values and exits successfully.
+ */
+int main()
+{
+    unsigned long mismatches = 0;
+    uint32_t bits = 0;
+    do
+    {
+        const float f = bitsFloat(bits);
+        const uint16_t expected = f16cHalfBits(f);
+        const uint16_t actual = floatToHalfBits(f);
+        if (expected != actual && mismatches++ < 10)
+        {
+            std::cerr << std::hex << "float 0x" << bits << ": 0x" << actual << " instead of 0x"
+                      << expected << std::dec << std::endl;
+        }
+    }
+    while (++bits != 0);
+    for (uint32_t half = 0; half <= 0xFFFFu; ++half)
+    {
+        const uint32_t expected = floatBits(f16cHalfToFloat((uint16_t) half));
+        const uint32_t actual = floatBits(halfBitsToFloat((uint16_t) half));
+        if (expected != actual && mismatches++ < 10)
+        {
+            std::cerr << std::hex << "half 0x" << half << ": 0x" << actual << " instead of 0x"
+                      << expected << std::dec << std::endl;
+        }
+    }
+    if (mismatches > 0)
+    {
+        std::cerr << mismatches << " conversions differ from F16C" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    std::cout << "every float and every half converts as F16C does" << std::endl;
+    return 0;
+}
@@ -5,143 +5,17 @@
 
 #ifndef EX3_MATRIX_HPP
 #define EX3_MATRIX_HPP
-#include <exception>
 #include <vector>
 #include "Complex.h"
+#include "FixedMatrix.hpp"
+#include "Accumulation.hpp"
+#include "Reductions.hpp"
+#include "AllocTracker.hpp"
 
+ALLOC_TYPE_NAME(Complex, "Complex")
+ALLOC_TYPE_NAME(Half, "Half")
+ALLOC_TYPE_NAME(BFloat16, "BFloat16")
 
-//***********************************Exceptions***************************************************
-
-/**
- * defines the type of objects thrown as exceptions to report a out of bound access to matrix error.
- */
-struct MatrixOutOfBounds: public std::exception
-{
-    /**
-     * holds the error info.
-     * @return error informative msg
-     */
-    const char* what() const noexcept override
-    {
-        return "Matrix indexes out of bounds.";
-    }
-};
-
-/**
- * defines the type of objects thrown as exceptions to report matrix dimension error.
- */
-struct DimensionException: public std::exception
-{
-    /**
-     * constructs new exception
-     * */
-    DimensionException():_msg("Dimensions Error"){};
-
-    /**
-     * holds the error info.
-     * @return error informative msg
-     */
-    const char* what() const noexcept override
-    {
-        return (_msg+".\n").c_str();
-    }
-protected:
-    /**the informative msg*/
-    std::string _msg;
-};
-
-/**
- * defines the type of objects thrown as exceptions to report matrix dimension initialization error.
- */
-struct InitDimension: public DimensionException
-
-{
-    /**
-     * constructs new exception
-     * */
-    InitDimension():DimensionException()
-    {
-        _msg += ":\nMatrix initiation requires both zero dimensions, or both positive dimensions";
-    };
-};
-
-/**
- * defines the type of objects thrown as exceptions to report matrix initialization error:
- * vector size and matrix dimensions are incompatible.
- */
-struct InitVectorDimension: public DimensionException
-
-{
-    /**
-     * constructs new exception
-     * */
-    InitVectorDimension():DimensionException()
-    {
-        _msg += ":\nMatrix initiation requires equality between "
-                "product of dimensions and number of elements in the supplied vector";
-    };
-};
-
-/**
- * defines the type of objects thrown as exceptions to report matrix dimension are
- * inconsiderate of operator.
- */
-struct InconsiderateOfOperation: public DimensionException
-{
-    /**
-     * constructs new exception
-     * */
-    InconsiderateOfOperation():DimensionException()
-    {
-        _msg += ":\ndoes not comply to operation";
-    }
-
-};
-
-/**
- * defines the type of objects thrown as exceptions to report matrix dimension are
- * inconsiderate of operators '+', '-'
- */
-struct addSubDimensions: public InconsiderateOfOperation
-{
-    /**
-     * constructs new exception
-     * */
-    addSubDimensions():InconsiderateOfOperation()
-    {
-        _msg += ".\nadd and subtract requires equality on the matrices dimensions";
-    }
-};
-
-/**
- * defines the type of objects thrown as exceptions to report matrix dimension are
- * inconsiderate of operator '*'.
- */
-struct MulDimensions: public InconsiderateOfOperation
-{
-    /**
-     * constructs new exception
-     * */
-    MulDimensions():InconsiderateOfOperation()
-    {
-        _msg += ".\nmultiply AB requires equality on the number of columns in A and the number of rows in B";
-    }
-};
-
-/**
- * defines the type of objects thrown as exceptions to report matrix dimension are
- * inconsiderate of operator transpose.
- */
-struct TransDimensions: public InconsiderateOfOperation
-{
-    /**
-     * constructs new exception
-     * */
-    TransDimensions():InconsiderateOfOperation()
-    {
-        _msg += ".\ntranspose requires a squared matrix";
-    }
-};
 
 //*********************************************Matrix**********************************************
 
@@ -156,9 +30,9 @@ class Matrix
 private:
     //fields:
     /**
-     * holds the matrix cells
+     * holds the matrix cells (allocated through the tracker when built with ALLOC_TRACKING)
      */
-    std::vector<T> _matrix;
+    std::vector<T, TrackedAllocator<T>> _matrix;
     /**
      * represents the matrix rows num
      */
@@ -210,7 +84,7 @@ public:
      * @param cells holds the matrix entries
      */
     Matrix(const unsigned int rows, const unsigned int cols, const std::vector<T>& cells)
-    :_matrix(cells), _rows(rows), _cols(cols){
+    :_matrix(cells.begin(), cells.end()), _rows(rows), _cols(cols){
         if ((rows > 0 && cols == 0) || (cols > 0 && rows == 0))
         {
             throw InitDimension{};
@@ -221,6 +95,27 @@ public:
         }
     }
 
+    /**
+     * constructs a new matrix, filled in values from the cells a view sees
+     * @param view matrix view (e.g. of a FixedMatrix, or of a libalg Matrix3D)
+     */
+    explicit Matrix(MatrixView<const T> const& view)
+    :_matrix(), _rows(view.rows()), _cols(view.cols()){
+        _matrix.reserve((size_t) _rows * _cols);
+        for (unsigned int r = 0; r < _rows; ++r)
+        {
+            const T *row = view.data() + (size_t) r * view.stride();
+            _matrix.insert(_matrix.end(), row, row + _cols);
+        }
+    }
+
+    /**
+     * constructs a new matrix, filled in values from a fixed-size matrix
+     * @param fixed matrix
+     */
+    template <unsigned int R, unsigned int C>
+    explicit Matrix(FixedMatrix<T, R, C> const& fixed):Matrix(fixed.view()){}
+
     //Destructor:
     /**
      * destructor
@@ -252,10 +147,20 @@ public:
         /**
          * @param other matrix
          * @return new matrix that represents the product of multiplying this
-         * matrix and the other matrix
+         * matrix and the other matrix (accumulated as DefaultAccumulation says)
          */
         Matrix operator*(Matrix const& other) const;
 
+        /**
+         * @tparam Policy accumulation policy (see Accumulation.hpp)
+         * @tparam R the product's cells' type
+         * @param other matrix
+         * @return new matrix that represents the product of multiplying this
+         * matrix and the other matrix, its sums accumulated as Policy says
+         */
+        template <typename Policy, typename R = T>
+        Matrix<R> multiply(Matrix const& other) const;
+
         /**
          * @param other matrix
          * @return true it the other matrix and this are equal, false otherwise
@@ -303,12 +208,26 @@ public:
          */
         Matrix trans() const;
 
+        /**
+         * @return a view of this matrix's cells (valid until the matrix is assigned or destroyed)
+         */
+        inline MatrixView<T> view() {return MatrixView<T>(_matrix.data(), _rows, _cols);}
+
+        /**
+         * @return a read-only view of this matrix's cells (valid until the matrix is assigned or
+         * destroyed)
+         */
+        inline MatrixView<const T> view() const
+        {
+            return MatrixView<const T>(_matrix.data(), _rows, _cols);
+        }
+
         /**
         * names a const iterator of the matrix class
         * @tparam T: must implement the operators: +, -, -=, +=, *, ==, =, <<.
         *            and copy-constructor, and zero-constructor.
         */
-        typedef typename std::vector<T>::const_iterator const_iterator;
+        typedef typename std::vector<T, TrackedAllocator<T>>::const_iterator const_iterator;
 
         /**
          * @return constant iterator to the beggining of the matrix (first element)
@@ -319,6 +238,61 @@ public:
          * @return constant iterator to the end of the matrix (after last element)
          */
         inline const_iterator end() const {return _matrix.cend();}
+
+    //Reductions and element-wise functions:
+    //(split between the matrix threads, see Reductions.hpp: the functions a reduction or a
+    // transform is given are called concurrently, on disjoint cells)
+        /**
+         * @param mode the order the cells are added up in (see Reduction)
+         * @return the sum of the matrix's cells, accumulated in WiderType<T>
+         */
+        typename WiderType<T>::type sum(Reduction mode = Reduction::Fast) const;
+
+        /**
+         * @param kind which norm (see Norm)
+         * @param mode the order the cells are added up in (see Reduction)
+         * @return the matrix's norm, accumulated in double
+         */
+        double norm(Norm kind = Norm::Frobenius, Reduction mode = Reduction::Fast) const;
+
+        /**
+         * @return the sum of the matrix's diagonal, accumulated in WiderType<T>
+         */
+        typename WiderType<T>::type trace() const;
+
+        /**
+         * @return the matrix's smallest cell (the first one, in row-major order), and where it is
+         */
+        Extremum<T> minCell() const;
+
+        /**
+         * @return the matrix's largest cell (the first one, in row-major order), and where it is
+         */
+        Extremum<T> maxCell() const;
+
+        /**
+         * @param pred callable as pred(cell), returns bool
+         * @return the num of cells pred is true for
+         */
+        template <typename Pred>
+        size_t countIf(Pred pred) const;
+
+        /**
+         * replaces every cell x of this matrix with f(x)
+         * @param f callable as f(cell), returns T
+         * @return this matrix after the transform
+         */
+        template <typename F>
+        Matrix& transform(F f);
+
+        /**
+         * replaces every cell x of this matrix with f(x, y), y the other matrix's cell[r,c]
+         * @param other matrix
+         * @param f callable as f(cell, other cell), returns T
+         * @return this matrix after the transform
+         */
+        template <typename F>
+        Matrix& transform(Matrix const& other, F f);
 };
 
 
@@ -429,6 +403,7 @@ const bool Matrix<T>::operator!=(Matrix const& other) const
 template <typename T>
 Matrix<T> Matrix<T>::operator+(Matrix const& other) const
 {
+    ALLOC_SCOPE("Matrix::operator+");
     if (_cols == other.cols() && _rows == other.rows())
     {
         Matrix<T> tmp(*this);
@@ -448,6 +423,7 @@ Matrix<T> Matrix<T>::operator+(Matrix const& other) const
 template <typename T>
 Matrix<T>  Matrix<T>::operator-(Matrix const& other) const
 {
+    ALLOC_SCOPE("Matrix::operator-");
     if (_cols == other.cols() && _rows == other.rows())
     {
         Matrix<T> tmp(*this);
@@ -462,27 +438,33 @@ Matrix<T>  Matrix<T>::operator-(Matrix const& other) const
  *        and copy-constructor, and zero-constructor.
  * @param other matrix
  * @return new matrix that represents the product of multiplying this
- * matrix and the other matrix
+ * matrix and the other matrix (accumulated as DefaultAccumulation says)
  */
 template <typename T>
 Matrix<T> Matrix<T>::operator*(Matrix const& other) const
 {
+    return multiply<DefaultAccumulation>(other);
+}
+
+/**
+ *@tparam T matrix item's type. must implement the operators: +, -, -=, +=, *, ==, =, <<.
+ *        and copy-constructor, and zero-constructor.
+ * @tparam Policy accumulation policy (see Accumulation.hpp)
+ * @tparam R the product's cells' type
+ * @param other matrix
+ * @return new matrix that represents the product of multiplying this
+ * matrix and the other matrix, its sums accumulated as Policy says
+ */
+template <typename T>
+template <typename Policy, typename R>
+Matrix<R> Matrix<T>::multiply(Matrix const& other) const
+{
+    ALLOC_SCOPE("Matrix::operator*");
     if(_cols == other.rows())
     {
-        std::vector<T> cells;
-        for (unsigned int i = 0; i < _rows; ++i)
-        {
-            for (unsigned int j = 0; j < other.cols(); ++j)
-            {
-                T sum = 0;
-                for (unsigned int k = 0; k < _cols; ++k)
-                {
-                    sum += ((*this)(i, k) * other(k, j));
-                }
-                cells.push_back(sum);
-            }
-        }
-        return Matrix(_rows, other.cols(), cells);
+        Matrix<R> product(_rows, other.cols());
+        Policy::multiply(view(), other.view(), product.view());
+        return product;
     }
     throw MulDimensions{};
 }
@@ -549,6 +531,7 @@ Matrix<T>& Matrix<T>::addOrSubtract(Matrix const& other,  void op(T&, T const&))
 template <typename T>
 Matrix<T> Matrix<T>::trans() const
 {
+    ALLOC_SCOPE("Matrix::trans");
     if (this->isSquareMatrix())
     {
         std::vector<T> cells;
@@ -570,6 +553,7 @@ Matrix<T> Matrix<T>::trans() const
 template <>
 Matrix<Complex> Matrix<Complex>::trans() const
 {
+    ALLOC_SCOPE("Matrix::trans");
     if (this->isSquareMatrix())
     {
         std::vector<Complex> cells;
@@ -586,4 +570,188 @@ Matrix<Complex> Matrix<Complex>::trans() const
 }
 
 
+//--------------------Reductions and element-wise functions:
+
+/**
+ * @tparam T matrix item's type. must implement the operators: +, -, -=, +=, *, ==, =, <<.
+ *        and copy-constructor, and zero-constructor.
+ * @param mode the order the cells are added up in (see Reduction)
+ * @return the sum of the matrix's cells, accumulated in WiderType<T>
+ */
+template <typename T>
+typename WiderType<T>::type Matrix<T>::sum(const Reduction mode) const
+{
+    typedef typename WiderType<T>::type Acc;
+    const T *cells = _matrix.data();
+    return reduceCells<Acc>(_matrix.size(), mode, [=](const size_t begin, const size_t end)
+    {
+        return sumRun<Acc>(cells, begin, end, [](T const& cell) {return static_cast<Acc>(cell);});
+    }, [](Acc const& left, Acc const& right) {return left + right;});
+}
+
+/**
+ * @tparam T matrix item's type. must implement the operators: +, -, -=, +=, *, ==, =, <<.
+ *        and copy-constructor, and zero-constructor.
+ * @param kind which norm (see Norm)
+ * @param mode the order the cells are added up in (see Reduction)
+ * @return the matrix's norm, accumulated in double
+ */
+template <typename T>
+double Matrix<T>::norm(const Norm kind, const Reduction mode) const
+{
+    const T *cells = _matrix.data();
+    auto add = [](const double left, const double right) {return left + right;};
+    if (kind == Norm::L1)
+    {
+        return reduceCells<double>(_matrix.size(), mode, [=](const size_t begin, const size_t end)
+        {
+            return sumRun<double>(cells, begin, end, [](T const& cell) {return magnitude(cell);});
+        }, add);
+    }
+    if (kind == Norm::Frobenius)
+    {
+        return std::sqrt(reduceCells<double>(_matrix.size(), mode, [=](const size_t begin, const size_t end)
+        {
+            return sumRun<double>(cells, begin, end, [](T const& cell)
+            {
+                const double m = magnitude(cell);
+                return m * m;
+            });
+        }, add));
+    }
+    // the largest magnitude is exact: no order to choose.
+    return reduceCells<double>(_matrix.size(), Reduction::Fast, [=](const size_t begin, const size_t end)
+    {
+        double largest = 0;
+        for (size_t i = begin; i < end; ++i)
+        {
+            largest = std::max(largest, magnitude(cells[i]));
+        }
+        return largest;
+    }, [](const double left, const double right) {return std::max(left, right);});
+}
+
+/**
+ * @tparam T matrix item's type. must implement the operators: +, -, -=, +=, *, ==, =, <<.
+ *        and copy-constructor, and zero-constructor.
+ * @return the sum of the matrix's diagonal, accumulated in WiderType<T>
+ */
+template <typename T>
+typename WiderType<T>::type Matrix<T>::trace() const
+{
+    if (this->isSquareMatrix())
+    {
+        typename WiderType<T>::type diagonal(0);
+        for (unsigned int i = 0; i < _rows; ++i)
+        {
+            diagonal += static_cast<typename WiderType<T>::type>(_matrix[(size_t) i * _cols + i]);
+        }
+        return diagonal;
+    }
+    throw TraceDimensions{};
+}
+
+/**
+ * @tparam T matrix item's type. must implement the operators: +, -, -=, +=, *, ==, =, <<.
+ *        and copy-constructor, and zero-constructor (and <).
+ * @return the matrix's smallest cell (the first one, in row-major order), and where it is
+ */
+template <typename T>
+Extremum<T> Matrix<T>::minCell() const
+{
+    if (_matrix.empty())
+    {
+        throw EmptyReduction{};
+    }
+    return findExtremum(_matrix.data(), _matrix.size(), _cols,
+                        [](T const& cell, T const& best) {return cell < best;});
+}
+
+/**
+ * @tparam T matrix item's type. must implement the operators: +, -, -=, +=, *, ==, =, <<.
+ *        and copy-constructor, and zero-constructor (and <).
+ * @return the matrix's largest cell (the first one, in row-major order), and where it is
+ */
+template <typename T>
+Extremum<T> Matrix<T>::maxCell() const
+{
+    if (_matrix.empty())
+    {
+        throw EmptyReduction{};
+    }
+    return findExtremum(_matrix.data(), _matrix.size(), _cols,
+                        [](T const& cell, T const& best) {return best < cell;});
+}
+
+/**
+ * @tparam T matrix item's type. must implement the operators: +, -, -=, +=, *, ==, =, <<.
+ *        and copy-constructor, and zero-constructor.
+ * @param pred callable as pred(cell), returns bool
+ * @return the num of cells pred is true for
+ */
+template <typename T>
+template <typename Pred>
+size_t Matrix<T>::countIf(Pred pred) const
+{
+    const T *cells = _matrix.data();
+    return reduceCells<size_t>(_matrix.size(), Reduction::Fast, [&](const size_t begin, const size_t end)
+    {
+        size_t count = 0;
+        for (size_t i = begin; i < end; ++i)
+        {
+            count += pred(cells[i]) ? 1 : 0;
+        }
+        return count;
+    }, [](const size_t left, const size_t right) {return left + right;});
+}
+
+/**
+ * @tparam T matrix item's type. must implement the operators: +, -, -=, +=, *, ==, =, <<.
+ *        and copy-constructor, and zero-constructor.
+ * @param f callable as f(cell), returns T
+ * @return this matrix after the transform
+ */
+template <typename T>
+template <typename F>
+Matrix<T>& Matrix<T>::transform(F f)
+{
+    T *cells = _matrix.data();
+    matrixParallelFor(_matrix.size(), 1, [&](const size_t begin, const size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            cells[i] = f(cells[i]);
+        }
+    });
+    return *this;
+}
+
+/**
+ * @tparam T matrix item's type. must implement the operators: +, -, -=, +=, *, ==, =, <<.
+ *        and copy-constructor, and zero-constructor.
+ * @param other matrix
+ * @param f callable as f(cell, other cell), returns T
+ * @return this matrix after the transform
+ */
+template <typename T>
+template <typename F>
+Matrix<T>& Matrix<T>::transform(Matrix const& other, F f)
+{
+    if (_cols == other.cols() && _rows == other.rows())
+    {
+        T *cells = _matrix.data();
+        const T *others = other._matrix.data();
+        matrixParallelFor(_matrix.size(), 1, [&](const size_t begin, const size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                cells[i] = f(cells[i], others[i]);
+            }
+        });
+        return *this;
+    }
+    throw addSubDimensions{};
+}
+
+
 #endif //EX3_MATRIX_HPP
@@ -0,0 +1,222 @@
+//
+// Created by baraloni, ex3 cpp 2018-19 winter semester.
+// contains the exceptions thrown by the matrix classes.
+//
+
+#ifndef EX3_MATRIXEXCEPTIONS_HPP
+#define EX3_MATRIXEXCEPTIONS_HPP
+#include <exception>
+#include <string>
+
+
+//***********************************Exceptions***************************************************
+
+/**
+ * defines the type of objects thrown as exceptions to report a out of bound access to matrix error.
+ */
+struct MatrixOutOfBounds: public std::exception
+{
+    /**
+     * holds the error info.
+     * @return error informative msg
+     */
+    const char* what() const noexcept override
+    {
+        return "Matrix indexes out of bounds.";
+    }
+};
+
+/**
+ * defines the type of objects thrown as exceptions to report a product whose cell doesn't fit
+ * the type it is narrowed into.
+ */
+struct AccumulationOverflow: public std::exception
+{
+    /**
+     * holds the error info.
+     * @return error informative msg
+     */
+    const char* what() const noexcept override
+    {
+        return "Matrix product overflows the cells' type.";
+    }
+};
+
+/**
+ * defines the type of objects thrown as exceptions to report matrix dimension error.
+ */
+struct DimensionException: public std::exception
+{
+    /**
+     * constructs new exception
+     * @param detail what the derived exception adds to the msg
+     * */
+    explicit DimensionException(const std::string &detail = ""):
+        _msg("Dimensions Error" + detail + ".\n"){};
+
+    /**
+     * holds the error info.
+     * @return error informative msg
+     */
+    const char* what() const noexcept override
+    {
+        return _msg.c_str();
+    }
+protected:
+    /**the informative msg (complete, as it is built by the constructors)*/
+    std::string _msg;
+};
+
+/**
+ * defines the type of objects thrown as exceptions to report matrix dimension initialization error.
+ */
+struct InitDimension: public DimensionException
+
+{
+    /**
+     * constructs new exception
+     * */
+    InitDimension():
+        DimensionException(":\nMatrix initiation requires both zero dimensions, or both "
+                           "positive dimensions"){}
+};
+
+/**
+ * defines the type of objects thrown as exceptions to report matrix initialization error:
+ * vector size and matrix dimensions are incompatible.
+ */
+struct InitVectorDimension: public DimensionException
+
+{
+    /**
+     * constructs new exception
+     * */
+    InitVectorDimension():
+        DimensionException(":\nMatrix initiation requires equality between product of "
+                           "dimensions and number of elements in the supplied vector"){}
+};
+
+/**
+ * defines the type of objects thrown as exceptions to report matrix dimension are
+ * inconsiderate of operator.
+ */
+struct InconsiderateOfOperation: public DimensionException
+{
+    /**
+     * constructs new exception
+     * */
+    explicit InconsiderateOfOperation(const std::string &detail = ""):
+        DimensionException(":\ndoes not comply to operation" + detail){}
+
+};
+
+/**
+ * defines the type of objects thrown as exceptions to report matrix dimension are
+ * inconsiderate of operators '+', '-'
+ */
+struct addSubDimensions: public InconsiderateOfOperation
+{
+    /**
+     * constructs new exception
+     * */
+    addSubDimensions():
+        InconsiderateOfOperation(".\nadd and subtract requires equality on the matrices "
+                                 "dimensions"){}
+};
+
+/**
+ * defines the type of objects thrown as exceptions to report matrix dimension are
+ * inconsiderate of operator '*'.
+ */
+struct MulDimensions: public InconsiderateOfOperation
+{
+    /**
+     * constructs new exception
+     * */
+    MulDimensions():
+        InconsiderateOfOperation(".\nmultiply AB requires equality on the number of columns in "
+                                 "A and the number of rows in B"){}
+};
+
+/**
+ * defines the type of objects thrown as exceptions to report matrix dimension are
+ * inconsiderate of operator transpose.
+ */
+struct TransDimensions: public InconsiderateOfOperation
+{
+    /**
+     * constructs new exception
+     * */
+    TransDimensions():
+        InconsiderateOfOperation(".\ntranspose requires a squared matrix"){}
+};
+
+/**
+ * defines the type of objects thrown as exceptions to report matrix dimension are
+ * inconsiderate of trace.
+ */
+struct TraceDimensions: public InconsiderateOfOperation
+{
+    /**
+     * constructs new exception
+     * */
+    TraceDimensions():
+        InconsiderateOfOperation(".\ntrace requires a squared matrix"){}
+};
+
+/**
+ * defines the type of objects thrown as exceptions to report the smallest or largest cell of a
+ * matrix with no cells.
+ */
+struct EmptyReduction: public DimensionException
+{
+    /**
+     * constructs new exception
+     * */
+    EmptyReduction():
+        DimensionException(":\nmin and max require a matrix with cells"){}
+};
+
+/**
+ * defines the type of objects thrown as exceptions to report a symmetric or triangular matrix
+ * read from a matrix that isn't square.
+ */
+struct StructureDimensions: public InconsiderateOfOperation
+{
+    /**
+     * constructs new exception
+     * */
+    StructureDimensions():
+        InconsiderateOfOperation(".\nsymmetric and triangular matrices require a squared matrix"){}
+};
+
+/**
+ * defines the type of objects thrown as exceptions to report a triangular solve of a matrix with
+ * a zero diagonal cell.
+ */
+struct SingularMatrix: public std::exception
+{
+    /**
+     * holds the error info.
+     * @return error informative msg
+     */
+    const char* what() const noexcept override
+    {
+        return "Matrix is singular: a diagonal cell is zero.";
+    }
+};
+
+/**
+ * defines the type of objects thrown as exceptions to report a view whose dimensions do not
+ * fit the fixed-size matrix it is read into.
+ */
+struct ViewDimensions: public DimensionException
+{
+    /**
+     * constructs new exception
+     * */
+    ViewDimensions():
+        DimensionException(":\nthe view's dimensions do not match the matrix's dimensions"){}
+};
+
+#endif //EX3_MATRIXEXCEPTIONS_HPP
@@ -0,0 +1,241 @@
+//
+// Created by baraloni, ex3 cpp 2018-19 winter semester.
+// contains a non-owning view of a row-major matrix, and the multiply kernels the matrix types share.
+//
+
+#ifndef EX3_MATRIXVIEW_HPP
+#define EX3_MATRIXVIEW_HPP
+#include <cstddef>
+#include <type_traits>
+#include "MatrixExceptions.hpp"
+
+
+//*********************************************MatrixView******************************************
+
+/**
+ * represents a view of a rows X cols matrix held elsewhere, in row-major order: cell[r,c] is
+ * data[r * stride + c]. the view doesn't own (or copy) the cells, which must outlive it.
+ * @tparam T: the cells' type (const T for a read-only view).
+ */
+template <typename T>
+class MatrixView
+{
+private:
+    //fields:
+    /**
+     * points to cell[0,0]
+     */
+    T *_data;
+    /**
+     * represents the view rows num
+     */
+    unsigned int _rows;
+    /**
+     * represents the view cols num
+     */
+    unsigned int _cols;
+    /**
+     * represents the distance between the beginnings of consecutive rows
+     */
+    unsigned int _stride;
+
+public:
+    //Constructors:
+    /**
+     * constructs a view of a rows X cols matrix whose rows follow one another.
+     * @param data points to cell[0,0]
+     * @param rows view num of rows
+     * @param cols view num of cols
+     */
+    MatrixView(T *data, const unsigned int rows, const unsigned int cols):
+               MatrixView(data, rows, cols, cols){}
+
+    /**
+     * constructs a view of a rows X cols matrix whose rows are stride cells apart.
+     * @param data points to cell[0,0]
+     * @param rows view num of rows
+     * @param cols view num of cols
+     * @param stride distance between the beginnings of consecutive rows (at least cols)
+     */
+    MatrixView(T *data, const unsigned int rows, const unsigned int cols, const unsigned int stride)
+    :_data(data), _rows(rows), _cols(cols), _stride(stride){
+        if ((rows > 0 && cols == 0) || (cols > 0 && rows == 0))
+        {
+            throw InitDimension{};
+        }
+        if (stride < cols)
+        {
+            throw ViewDimensions{};
+        }
+    }
+
+    /**
+     * constructs a read-only view of the cells another view sees.
+     * @param other view
+     */
+    template <typename U, typename = typename std::enable_if<std::is_same<const U, T>::value>::type>
+    MatrixView(MatrixView<U> const& other):
+               MatrixView(other.data(), other.rows(), other.cols(), other.stride()){}
+
+    //General functionality:
+    /**
+     * @return the num of rows of this view
+     */
+    inline unsigned int rows() const {return _rows;}
+
+    /**
+     * @return the num of cols of this view
+     */
+    inline unsigned int cols() const {return _cols;}
+
+    /**
+     * @return the distance between the beginnings of consecutive rows
+     */
+    inline unsigned int stride() const {return _stride;}
+
+    /**
+     * @return a pointer to cell[0,0]
+     */
+    inline T *data() const {return _data;}
+
+    /**
+     * @return true if the rows follow one another (so the cells are rows * cols contiguous cells)
+     */
+    inline bool isContiguous() const {return _stride == _cols || _rows <= 1;}
+
+    /**
+     * @param r row num
+     * @param c col num
+     * @return the view's cell[r,c]
+     */
+    T& operator()(const unsigned int r, const unsigned int c) const
+    {
+        if (r < _rows && c < _cols)
+        {
+            return _data[(size_t) r * _stride + c];
+        }
+        throw MatrixOutOfBounds{};
+    }
+
+    /**
+     * @param r first row num
+     * @param c first col num
+     * @param rows block num of rows
+     * @param cols block num of cols
+     * @return a view of the rows X cols block whose cell[0,0] is this view's cell[r,c]
+     */
+    MatrixView block(const unsigned int r, const unsigned int c, const unsigned int rows,
+                     const unsigned int cols) const
+    {
+        if (r + rows > _rows || c + cols > _cols)
+        {
+            throw MatrixOutOfBounds{};
+        }
+        return MatrixView(_data + (size_t) r * _stride + c, rows, cols, _stride);
+    }
+};
+
+
+//*********************************************Kernels*********************************************
+
+/**
+ * multiplies a R X K matrix by a K X C matrix, both (and the product) held as contiguous
+ * row-major cells. the bounds are known at compile time, so the loops are fully unrolled.
+ * @tparam T cells' type. must implement the operators: +=, *, and zero-constructor.
+ * @param a points to the left matrix's cells
+ * @param b points to the right matrix's cells
+ * @param out points to the product's cells (must not overlap a or b)
+ */
+template <typename T, unsigned int R, unsigned int K, unsigned int C>
+inline void fixedMultiply(const T *a, const T *b, T *out)
+{
+    for (unsigned int i = 0; i < R; ++i)
+    {
+        for (unsigned int j = 0; j < C; ++j)
+        {
+            out[i * C + j] = a[i * K] * b[j];
+        }
+        for (unsigned int k = 1; k < K; ++k)
+        {
+            for (unsigned int j = 0; j < C; ++j)
+            {
+                out[i * C + j] += a[i * K + k] * b[k * C + j];
+            }
+        }
+    }
+}
+
+/**
+ * multiplies n pairs of fixed-size matrices: out[m] = a[m] * b[m], where every array holds its
+ * matrices back to back (R * K, K * C and R * C cells apart).
+ * @tparam T cells' type. must implement the operators: +=, *, and zero-constructor.
+ * @param a points to the left matrices' cells
+ * @param b points to the right matrices' cells
+ * @param out points to the products' cells (must not overlap a or b)
+ * @param n num of products
+ */
+template <typename T, unsigned int R, unsigned int K, unsigned int C>
+void batchFixedMultiply(const T *a, const T *b, T *out, const size_t n)
+{
+    for (size_t m = 0; m < n; ++m)
+    {
+        fixedMultiply<T, R, K, C>(a + m * R * K, b + m * K * C, out + m * R * C);
+    }
+}
+
+/**
+ * writes the product a * b into out. 2X2, 3X3 and 4X4 contiguous products go through the
+ * fixed-size kernel, other ones through a row-by-row loop (Matrix<T>'s operator* runs it, through
+ * PlainAccumulation).
+ * @tparam T cells' type. must implement the operators: +=, *, and zero-constructor.
+ * @param a left matrix
+ * @param b right matrix
+ * @param out receives the product (must not overlap a or b)
+ */
+template <typename T>
+void multiply(MatrixView<const T> const& a, MatrixView<const T> const& b, MatrixView<T> const& out)
+{
+    if (a.cols() != b.rows() || out.rows() != a.rows() || out.cols() != b.cols())
+    {
+        throw MulDimensions{};
+    }
+    const unsigned int n = a.rows();
+    if (n == a.cols() && n == b.cols() && a.isContiguous() && b.isContiguous() &&
+        out.isContiguous())
+    {
+        switch (n)
+        {
+            case 2:
+                fixedMultiply<T, 2, 2, 2>(a.data(), b.data(), out.data());
+                return;
+            case 3:
+                fixedMultiply<T, 3, 3, 3>(a.data(), b.data(), out.data());
+                return;
+            case 4:
+                fixedMultiply<T, 4, 4, 4>(a.data(), b.data(), out.data());
+                return;
+            default:
+                break;
+        }
+    }
+    for (unsigned int i = 0; i < a.rows(); ++i)
+    {
+        T *row = out.data() + (size_t) i * out.stride();
+        for (unsigned int j = 0; j < b.cols(); ++j)
+        {
+            row[j] = T(0);
+        }
+        for (unsigned int k = 0; k < a.cols(); ++k)
+        {
+            const T left = a.data()[(size_t) i * a.stride() + k];
+            const T *right = b.data() + (size_t) k * b.stride();
+            for (unsigned int j = 0; j < b.cols(); ++j)
+            {
+                row[j] += left * right[j];
+            }
+        }
+    }
+}
+
+
+#endif //EX3_MATRIXVIEW_HPP
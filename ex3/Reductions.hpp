@@ -0,0 +1,251 @@
+//
+// Created by baraloni, ex3 cpp 2018-19 winter semester.
+// contains the parallel reductions and element-wise kernels of the matrix classes.
+//
+
+#ifndef EX3_REDUCTIONS_HPP
+#define EX3_REDUCTIONS_HPP
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "Accumulation.hpp"
+#include "ParallelFor.hpp"
+
+/** number of cells a deterministic reduction sums up in one run (the runs are then combined).*/
+#define MATRIX_REDUCE_CHUNK 16384
+
+
+//*********************************************Threads*********************************************
+
+/**
+ * names the order a floating-point reduction adds its cells up in: Fast gives every thread one
+ * run of cells (so the rounding depends on the number of threads), Deterministic always splits
+ * the cells into runs of MATRIX_REDUCE_CHUNK cells, combined in order (so the result is the same,
+ * to the bit, for any number of threads).
+ */
+enum class Reduction
+{
+    Fast,
+    Deterministic
+};
+
+/**
+ * names the norms of a matrix: the sum of the cells' magnitudes, the square root of the sum of
+ * their squares, and the largest one.
+ */
+enum class Norm
+{
+    L1,
+    Frobenius,
+    Max
+};
+
+/**
+ * @return the number of threads requested by setMatrixThreads (0 for the number of cores).
+ */
+inline std::atomic<unsigned int>& requestedMatrixThreads()
+{
+    static std::atomic<unsigned int> threads(0);
+    return threads;
+}
+
+/**
+ * sets the number of threads the matrix kernels split a matrix between.
+ * @param threads num of threads (0 for the number of cores)
+ */
+inline void setMatrixThreads(const unsigned int threads)
+{
+    requestedMatrixThreads().store(threads);
+}
+
+/**
+ * @return the number of threads the matrix kernels split a matrix between.
+ */
+inline unsigned int matrixThreads()
+{
+    const unsigned int threads = requestedMatrixThreads().load();
+    if (threads > 0)
+    {
+        return threads;
+    }
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+/**
+ * runs kernel over [0, n), split into contiguous ranges between the matrix threads (see
+ * parallelFor: the caller's thread runs the first one, and an exception thrown by the kernel is
+ * rethrown on the caller's thread, once every range is done).
+ * @param n num of items
+ * @param cellsPerItem num of cells an item covers (how much work it is)
+ * @param kernel callable as kernel(begin, end)
+ */
+template <typename Kernel>
+void matrixParallelFor(const size_t n, const size_t cellsPerItem, Kernel kernel)
+{
+    parallelFor(n, parallelChunks(n * cellsPerItem, matrixThreads()), 1, kernel);
+}
+
+/**
+ * reduces n cells: splits them into runs (as mode says), reduces every run (in parallel), and
+ * combines the runs' results in order.
+ * @param n num of cells
+ * @param mode the runs' order (see Reduction)
+ * @param reduceRun callable as reduceRun(begin, end), returns the run's result (n > 0)
+ * @param combine callable as combine(left, right), returns the result of both runs
+ * @return the result of all the cells
+ */
+template <typename Result, typename ReduceRun, typename Combine>
+Result reduceCells(const size_t n, const Reduction mode, ReduceRun reduceRun, Combine combine)
+{
+    const bool chunked = mode == Reduction::Deterministic;
+    const size_t runs = chunked ? (n + MATRIX_REDUCE_CHUNK - 1) / MATRIX_REDUCE_CHUNK
+                                : parallelChunks(n, matrixThreads());
+    if (runs <= 1)
+    {
+        return reduceRun((size_t) 0, n);
+    }
+    auto bound = [=](const size_t run)
+    {
+        return chunked ? std::min(n, run * MATRIX_REDUCE_CHUNK) : n * run / runs;
+    };
+    std::vector<Result> results(runs, reduceRun((size_t) 0, (size_t) 0)); // the empty run's result
+    matrixParallelFor(runs, n / runs, [&](const size_t first, const size_t last)
+    {
+        for (size_t run = first; run < last; ++run)
+        {
+            results[run] = reduceRun(bound(run), bound(run + 1));
+        }
+    });
+    Result result = results[0];
+    for (size_t run = 1; run < runs; ++run)
+    {
+        result = combine(result, results[run]);
+    }
+    return result;
+}
+
+
+//*********************************************Kernels*********************************************
+
+/**
+ * @param cell an arithmetic cell
+ * @return the cell's magnitude
+ */
+template <typename T>
+inline double magnitude(T const& cell, std::true_type /*arithmetic*/)
+{
+    return std::fabs(static_cast<double>(cell));
+}
+
+/**
+ * @param cell a cell of a class type (found by its abs)
+ * @return the cell's magnitude
+ */
+template <typename T>
+inline double magnitude(T const& cell, std::false_type /*arithmetic*/)
+{
+    using std::abs;
+    return static_cast<double>(abs(cell));
+}
+
+/**
+ * @param cell a cell
+ * @return the cell's magnitude
+ */
+template <typename T>
+inline double magnitude(T const& cell)
+{
+    return magnitude(cell, std::is_arithmetic<T>());
+}
+
+/**
+ * @param cell a 16-bit cell
+ * @return the cell's magnitude
+ */
+template <typename Bits>
+inline double magnitude(Float16<Bits> const& cell)
+{
+    return std::fabs(static_cast<float>(cell));
+}
+
+/**
+ * @param cells points to the cells
+ * @param begin first cell
+ * @param end after the last cell
+ * @param term callable as term(cell), returns the cell's term, of type Acc
+ * @return the sum of the terms of cells [begin, end), in 4 interleaved sums (so the loop
+ * vectorizes) that are added up in a fixed order
+ */
+template <typename Acc, typename T, typename Term>
+Acc sumRun(const T *cells, const size_t begin, const size_t end, Term term)
+{
+    Acc sums[4] = {Acc(0), Acc(0), Acc(0), Acc(0)};
+    size_t i = begin;
+    for (; i + 4 <= end; i += 4)
+    {
+        for (unsigned int lane = 0; lane < 4; ++lane)
+        {
+            sums[lane] += term(cells[i + lane]);
+        }
+    }
+    for (; i < end; ++i)
+    {
+        sums[0] += term(cells[i]);
+    }
+    return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+}
+
+/**
+ * represents a matrix's smallest or largest cell, and where it is.
+ * @tparam T: the cells' type.
+ */
+template <typename T>
+struct Extremum
+{
+    /** the cell's value*/
+    T value;
+    /** the cell's row num*/
+    unsigned int row;
+    /** the cell's col num*/
+    unsigned int col;
+};
+
+/**
+ * @param cells points to the n cells
+ * @param n num of cells (positive)
+ * @param cols num of cols of the matrix the cells are (in row-major order)
+ * @param better callable as better(a, b), true if cell a should replace cell b
+ * @return the best cell: the first of the equally good ones (a cell better() says false about
+ * either way, like a NaN, never replaces the best cell so far)
+ */
+template <typename T, typename Better>
+Extremum<T> findExtremum(const T *cells, const size_t n, const unsigned int cols, Better better)
+{
+    // the result of a run is its best cell's index.
+    auto reduceRun = [&](const size_t begin, const size_t end)
+    {
+        size_t index = begin;
+        for (size_t i = begin + 1; i < end; ++i)
+        {
+            if (better(cells[i], cells[index]))
+            {
+                index = i;
+            }
+        }
+        return index;
+    };
+    // combined in order, so a later run's cell wins only if it's strictly better.
+    auto combine = [&](const size_t left, const size_t right)
+    {
+        return better(cells[right], cells[left]) ? right : left;
+    };
+    const size_t best = reduceCells<size_t>(n, Reduction::Fast, reduceRun, combine);
+    return Extremum<T>{cells[best], (unsigned int) (best / cols), (unsigned int) (best % cols)};
+}
+
+
+#endif //EX3_REDUCTIONS_HPP
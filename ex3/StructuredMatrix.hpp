@@ -0,0 +1,1031 @@
+//
+// Created by baraloni, ex3 cpp 2018-19 winter semester.
+// contains symmetric, triangular and banded matrix classes, in packed storage.
+//
+
+#ifndef EX3_STRUCTUREDMATRIX_HPP
+#define EX3_STRUCTUREDMATRIX_HPP
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+#include "Matrix.hpp"
+
+// the structured matrices store only the cells their structure doesn't know: a symmetric matrix
+// its lower triangle, a triangular matrix its triangle (n(n+1)/2 cells each, row by row), and a
+// banded matrix the cells of its band (rows X (lower + upper + 1) cells). their kernels go over
+// the stored cells only, and toDense() gives the full Matrix<T>.
+
+
+//*********************************************Helpers*********************************************
+
+/**
+ * @param n num of rows (and cols)
+ * @return the num of cells of a packed n X n triangle
+ */
+inline size_t packedSize(const unsigned int n)
+{
+    return (size_t) n * (n + 1) / 2;
+}
+
+/**
+ * @param r row num
+ * @param c col num (c <= r)
+ * @return the index of cell[r,c] in a packed lower triangle
+ */
+inline size_t packedLowerIndex(const unsigned int r, const unsigned int c)
+{
+    return (size_t) r * (r + 1) / 2 + c;
+}
+
+/**
+ * @param n num of rows (and cols)
+ * @param r row num
+ * @param c col num (c >= r)
+ * @return the index of cell[r,c] in a packed n X n upper triangle
+ */
+inline size_t packedUpperIndex(const unsigned int n, const unsigned int r, const unsigned int c)
+{
+    return (size_t) r * (2 * (size_t) n - r + 1) / 2 + (c - r);
+}
+
+/**
+ * @param cell a cell
+ * @return the cell, as its transposed matrix has it (the same cell)
+ */
+template <typename T>
+inline T transposedCell(T const& cell)
+{
+    return cell;
+}
+
+/**
+ * @param cell a Complex cell
+ * @return the cell, as its transposed matrix has it (conjugated, as Matrix<Complex>::trans does)
+ */
+inline Complex transposedCell(Complex const& cell)
+{
+    return cell.conj();
+}
+
+/**
+ * @param rows num of rows
+ * @param cols num of cols
+ * @param sums the accumulated cells, in row-major order
+ * @return a new matrix of the sums, narrowed into T
+ */
+template <typename T, typename Acc>
+Matrix<T> narrowedMatrix(const unsigned int rows, const unsigned int cols,
+                         std::vector<Acc> const& sums)
+{
+    Matrix<T> product(rows, cols);
+    T *cells = product.view().data();
+    for (size_t i = 0; i < sums.size(); ++i)
+    {
+        cells[i] = narrowCell<T>(sums[i]);
+    }
+    return product;
+}
+
+
+//*********************************************SymmetricMatrix*************************************
+
+/**
+ * represents a n X n symmetric matrix: cell[r,c] and cell[c,r] are the same stored cell (of the
+ * packed lower triangle).
+ * @tparam T: must implement the operators: +, -, -=, +=, *, ==, =, <<.
+ *            and copy-constructor, and zero-constructor.
+ */
+template <typename T>
+class SymmetricMatrix
+{
+private:
+    //fields:
+    /**
+     * holds the lower triangle's cells, row by row
+     */
+    std::vector<T, TrackedAllocator<T>> _cells;
+    /**
+     * represents the matrix rows (and cols) num
+     */
+    unsigned int _n;
+
+    //Helpers:
+    /**
+     * @param r row num
+     * @param c col num
+     * @return the index of the stored cell that is cell[r,c] (throws MatrixOutOfBounds)
+     */
+    size_t index(const unsigned int r, const unsigned int c) const
+    {
+        if (r >= _n || c >= _n)
+        {
+            throw MatrixOutOfBounds{};
+        }
+        return r >= c ? packedLowerIndex(r, c) : packedLowerIndex(c, r);
+    }
+
+public:
+    //Constructors:
+    /**
+     * constructs a new matrix of dimension n X n of (T)0
+     * @param n matrix num of rows (and cols)
+     */
+    explicit SymmetricMatrix(const unsigned int n):_cells(packedSize(n), T(0)), _n(n){}
+
+    /**
+     * constructs a new matrix of a square matrix's lower triangle (its upper triangle is taken
+     * to mirror it, and isn't read)
+     * @param dense square matrix
+     */
+    explicit SymmetricMatrix(Matrix<T> const& dense):SymmetricMatrix(dense.rows())
+    {
+        if (!dense.isSquareMatrix())
+        {
+            throw StructureDimensions{};
+        }
+        for (unsigned int r = 0; r < _n; ++r)
+        {
+            for (unsigned int c = 0; c <= r; ++c)
+            {
+                _cells[packedLowerIndex(r, c)] = dense(r, c);
+            }
+        }
+    }
+
+    //Operators:
+    /**
+     * @param r row num
+     * @param c col num
+     * @return the value of the matrix's cell[r,c]
+     */
+    T const& operator()(const unsigned int r, const unsigned int c) const
+    {
+        return _cells[index(r, c)];
+    }
+
+    /**
+     * @param other matrix
+     * @return new matrix that represents the sum of adding this matrix and the other matrix
+     */
+    SymmetricMatrix operator+(SymmetricMatrix const& other) const
+    {
+        ALLOC_SCOPE("SymmetricMatrix::operator+");
+        if (_n != other._n)
+        {
+            throw addSubDimensions{};
+        }
+        SymmetricMatrix sum(*this);
+        for (size_t i = 0; i < _cells.size(); ++i)
+        {
+            sum._cells[i] += other._cells[i];
+        }
+        return sum;
+    }
+
+    /**
+     * @param other matrix
+     * @return new matrix that represents the difference of subtracting other matrix from this
+     * matrix
+     */
+    SymmetricMatrix operator-(SymmetricMatrix const& other) const
+    {
+        ALLOC_SCOPE("SymmetricMatrix::operator-");
+        if (_n != other._n)
+        {
+            throw addSubDimensions{};
+        }
+        SymmetricMatrix difference(*this);
+        for (size_t i = 0; i < _cells.size(); ++i)
+        {
+            difference._cells[i] -= other._cells[i];
+        }
+        return difference;
+    }
+
+    /**
+     * @param other matrix
+     * @return new matrix that represents the product of multiplying this matrix and the other
+     * matrix (every stored cell is read once, and used for both cells it is)
+     */
+    Matrix<T> operator*(Matrix<T> const& other) const
+    {
+        ALLOC_SCOPE("SymmetricMatrix::operator*");
+        if (_n != other.rows())
+        {
+            throw MulDimensions{};
+        }
+        typedef typename AccumulatorOf<T>::type Acc;
+        const unsigned int cols = other.cols();
+        const MatrixView<const T> b = other.view();
+        std::vector<Acc> sums((size_t) _n * cols, Acc(0));
+        for (unsigned int i = 0; i < _n; ++i)
+        {
+            const T *rowI = b.data() + (size_t) i * b.stride();
+            Acc *sumsI = sums.data() + (size_t) i * cols;
+            for (unsigned int k = 0; k <= i; ++k)
+            {
+                const Acc cell = static_cast<Acc>(_cells[packedLowerIndex(i, k)]);
+                const T *rowK = b.data() + (size_t) k * b.stride();
+                for (unsigned int j = 0; j < cols; ++j)
+                {
+                    sumsI[j] += cell * static_cast<Acc>(rowK[j]);
+                }
+                if (k == i)
+                {
+                    continue;
+                }
+                // the cell is also cell[k,i]:
+                Acc *sumsK = sums.data() + (size_t) k * cols;
+                for (unsigned int j = 0; j < cols; ++j)
+                {
+                    sumsK[j] += cell * static_cast<Acc>(rowI[j]);
+                }
+            }
+        }
+        return narrowedMatrix<T>(_n, cols, sums);
+    }
+
+    /**
+     * @param other matrix
+     * @return true it the other matrix and this are equal, false otherwise
+     */
+    bool operator==(SymmetricMatrix const& other) const
+    {
+        return _n == other._n && std::equal(_cells.begin(), _cells.end(), other._cells.begin());
+    }
+
+    /**
+     * @param other matrix
+     * @return false it the other matrix and this are equal, true otherwise
+     */
+    bool operator!=(SymmetricMatrix const& other) const {return !(*this == other);}
+
+    //General functionality:
+    /**
+     * @return the num of cols of this matrix
+     */
+    inline unsigned int cols() const {return _n;}
+
+    /**
+     * @return the num of rows of this matrix
+     */
+    inline unsigned int rows() const {return _n;}
+
+    /**
+     * @param r row num
+     * @param c col num
+     * @return the stored cell that is cell[r,c] (and cell[c,r])
+     */
+    T& cell(const unsigned int r, const unsigned int c) {return _cells[index(r, c)];}
+
+    /**
+     * @return a new matrix representing the transpose form of this matrix (a copy, with its
+     * cells transposed as Matrix<T>::trans does)
+     */
+    SymmetricMatrix trans() const
+    {
+        ALLOC_SCOPE("SymmetricMatrix::trans");
+        SymmetricMatrix transposed(*this);
+        for (T &cell : transposed._cells)
+        {
+            cell = transposedCell(cell);
+        }
+        return transposed;
+    }
+
+    /**
+     * @return a new dense matrix with this matrix's cells
+     */
+    Matrix<T> toDense() const
+    {
+        ALLOC_SCOPE("SymmetricMatrix::toDense");
+        Matrix<T> dense(_n, _n);
+        T *cells = dense.view().data();
+        for (unsigned int r = 0; r < _n; ++r)
+        {
+            for (unsigned int c = 0; c <= r; ++c)
+            {
+                cells[(size_t) r * _n + c] = cells[(size_t) c * _n + r] =
+                        _cells[packedLowerIndex(r, c)];
+            }
+        }
+        return dense;
+    }
+};
+
+
+//*********************************************TriangularMatrix************************************
+
+/**
+ * names the triangle a triangular matrix stores: the cells on and below the diagonal (Lower), or
+ * on and above it (Upper).
+ */
+enum class Triangle
+{
+    Lower,
+    Upper
+};
+
+/**
+ * represents a n X n triangular matrix: the cells out of its triangle are (T)0, and aren't stored.
+ * @tparam T: must implement the operators: +, -, -=, +=, *, ==, =, <<.
+ *            and copy-constructor, and zero-constructor (and / for solve, which rejects
+ *            integer types).
+ * @tparam Shape: the stored triangle.
+ */
+template <typename T, Triangle Shape>
+class TriangularMatrix
+{
+private:
+    //fields:
+    /**
+     * holds the triangle's cells, row by row
+     */
+    std::vector<T, TrackedAllocator<T>> _cells;
+    /**
+     * represents the matrix rows (and cols) num
+     */
+    unsigned int _n;
+
+    //Helpers:
+    /**
+     * @param r row num
+     * @return the first col of row r in the triangle
+     */
+    inline unsigned int firstCol(const unsigned int r) const
+    {
+        return Shape == Triangle::Lower ? 0 : r;
+    }
+
+    /**
+     * @param r row num
+     * @return the last col of row r in the triangle
+     */
+    inline unsigned int lastCol(const unsigned int r) const
+    {
+        return Shape == Triangle::Lower ? r : _n - 1;
+    }
+
+    /**
+     * @param r row num
+     * @param c col num (in the triangle)
+     * @return the index of cell[r,c]
+     */
+    inline size_t packedIndex(const unsigned int r, const unsigned int c) const
+    {
+        return Shape == Triangle::Lower ? packedLowerIndex(r, c) : packedUpperIndex(_n, r, c);
+    }
+
+    /**
+     * @param r row num
+     * @param c col num
+     * @return true if cell[r,c] is in the triangle (throws MatrixOutOfBounds if it isn't a cell)
+     */
+    bool stored(const unsigned int r, const unsigned int c) const
+    {
+        if (r >= _n || c >= _n)
+        {
+            throw MatrixOutOfBounds{};
+        }
+        return Shape == Triangle::Lower ? c <= r : c >= r;
+    }
+
+public:
+    //Constructors:
+    /**
+     * constructs a new matrix of dimension n X n of (T)0
+     * @param n matrix num of rows (and cols)
+     */
+    explicit TriangularMatrix(const unsigned int n):_cells(packedSize(n), T(0)), _n(n){}
+
+    /**
+     * constructs a new matrix of a square matrix's triangle (the other cells aren't read)
+     * @param dense square matrix
+     */
+    explicit TriangularMatrix(Matrix<T> const& dense):TriangularMatrix(dense.rows())
+    {
+        if (!dense.isSquareMatrix())
+        {
+            throw StructureDimensions{};
+        }
+        for (unsigned int r = 0; r < _n; ++r)
+        {
+            for (unsigned int c = firstCol(r); c <= lastCol(r); ++c)
+            {
+                _cells[packedIndex(r, c)] = dense(r, c);
+            }
+        }
+    }
+
+    //Operators:
+    /**
+     * @param r row num
+     * @param c col num
+     * @return the value of the matrix's cell[r,c]
+     */
+    T operator()(const unsigned int r, const unsigned int c) const
+    {
+        return stored(r, c) ? _cells[packedIndex(r, c)] : T(0);
+    }
+
+    /**
+     * @param other matrix
+     * @return new matrix that represents the sum of adding this matrix and the other matrix
+     */
+    TriangularMatrix operator+(TriangularMatrix const& other) const
+    {
+        ALLOC_SCOPE("TriangularMatrix::operator+");
+        if (_n != other._n)
+        {
+            throw addSubDimensions{};
+        }
+        TriangularMatrix sum(*this);
+        for (size_t i = 0; i < _cells.size(); ++i)
+        {
+            sum._cells[i] += other._cells[i];
+        }
+        return sum;
+    }
+
+    /**
+     * @param other matrix
+     * @return new matrix that represents the difference of subtracting other matrix from this
+     * matrix
+     */
+    TriangularMatrix operator-(TriangularMatrix const& other) const
+    {
+        ALLOC_SCOPE("TriangularMatrix::operator-");
+        if (_n != other._n)
+        {
+            throw addSubDimensions{};
+        }
+        TriangularMatrix difference(*this);
+        for (size_t i = 0; i < _cells.size(); ++i)
+        {
+            difference._cells[i] -= other._cells[i];
+        }
+        return difference;
+    }
+
+    /**
+     * @param other matrix
+     * @return new matrix that represents the product of multiplying this matrix and the other
+     * matrix (row i sums the other's rows of the triangle's row i only)
+     */
+    Matrix<T> operator*(Matrix<T> const& other) const
+    {
+        ALLOC_SCOPE("TriangularMatrix::operator*");
+        if (_n != other.rows())
+        {
+            throw MulDimensions{};
+        }
+        typedef typename AccumulatorOf<T>::type Acc;
+        const unsigned int cols = other.cols();
+        const MatrixView<const T> b = other.view();
+        std::vector<Acc> sums((size_t) _n * cols, Acc(0));
+        for (unsigned int i = 0; i < _n; ++i)
+        {
+            Acc *sumsI = sums.data() + (size_t) i * cols;
+            for (unsigned int k = firstCol(i); k <= lastCol(i); ++k)
+            {
+                const Acc cell = static_cast<Acc>(_cells[packedIndex(i, k)]);
+                const T *rowK = b.data() + (size_t) k * b.stride();
+                for (unsigned int j = 0; j < cols; ++j)
+                {
+                    sumsI[j] += cell * static_cast<Acc>(rowK[j]);
+                }
+            }
+        }
+        return narrowedMatrix<T>(_n, cols, sums);
+    }
+
+    /**
+     * @param other matrix
+     * @return new matrix that represents the product of multiplying this matrix and the other
+     * matrix (triangular as well: cell[i,j] sums the terms k between i and j only)
+     */
+    TriangularMatrix operator*(TriangularMatrix const& other) const
+    {
+        ALLOC_SCOPE("TriangularMatrix::operator*");
+        if (_n != other._n)
+        {
+            throw MulDimensions{};
+        }
+        typedef typename AccumulatorOf<T>::type Acc;
+        TriangularMatrix product(_n);
+        for (unsigned int i = 0; i < _n; ++i)
+        {
+            for (unsigned int j = firstCol(i); j <= lastCol(i); ++j)
+            {
+                Acc sum(0);
+                for (unsigned int k = std::min(i, j); k <= std::max(i, j); ++k)
+                {
+                    sum += static_cast<Acc>(_cells[packedIndex(i, k)]) *
+                           static_cast<Acc>(other._cells[packedIndex(k, j)]);
+                }
+                product._cells[packedIndex(i, j)] = narrowCell<T>(sum);
+            }
+        }
+        return product;
+    }
+
+    /**
+     * @param other matrix
+     * @return true it the other matrix and this are equal, false otherwise
+     */
+    bool operator==(TriangularMatrix const& other) const
+    {
+        return _n == other._n && std::equal(_cells.begin(), _cells.end(), other._cells.begin());
+    }
+
+    /**
+     * @param other matrix
+     * @return false it the other matrix and this are equal, true otherwise
+     */
+    bool operator!=(TriangularMatrix const& other) const {return !(*this == other);}
+
+    //General functionality:
+    /**
+     * @return the num of cols of this matrix
+     */
+    inline unsigned int cols() const {return _n;}
+
+    /**
+     * @return the num of rows of this matrix
+     */
+    inline unsigned int rows() const {return _n;}
+
+    /**
+     * @param r row num
+     * @param c col num
+     * @return the stored cell[r,c] (throws MatrixOutOfBounds out of the triangle)
+     */
+    T& cell(const unsigned int r, const unsigned int c)
+    {
+        if (!stored(r, c))
+        {
+            throw MatrixOutOfBounds{};
+        }
+        return _cells[packedIndex(r, c)];
+    }
+
+    /**
+     * @return a new matrix representing the transpose form of this matrix (of the other
+     * triangle, its cells transposed as Matrix<T>::trans does)
+     */
+    TriangularMatrix<T, Shape == Triangle::Lower ? Triangle::Upper : Triangle::Lower> trans() const
+    {
+        ALLOC_SCOPE("TriangularMatrix::trans");
+        TriangularMatrix<T, Shape == Triangle::Lower ? Triangle::Upper : Triangle::Lower> transposed(_n);
+        for (unsigned int r = 0; r < _n; ++r)
+        {
+            for (unsigned int c = firstCol(r); c <= lastCol(r); ++c)
+            {
+                transposed.cell(c, r) = transposedCell(_cells[packedIndex(r, c)]);
+            }
+        }
+        return transposed;
+    }
+
+    /**
+     * solves this * x = b, by forward (Lower) or back (Upper) substitution.
+     * throws SingularMatrix if a diagonal cell is (T)0. T may not be an integer type, as x's cells
+     * are quotients (hold the matrices in a floating-point type to solve them).
+     * @param b matrix of n rows (every col is a right-hand side)
+     * @return new matrix x
+     */
+    Matrix<T> solve(Matrix<T> const& b) const
+    {
+        static_assert(!std::is_integral<T>::value,
+                      "solve divides by the diagonal: an integer T would truncate the solution");
+        ALLOC_SCOPE("TriangularMatrix::solve");
+        if (_n != b.rows())
+        {
+            throw MulDimensions{};
+        }
+        typedef typename AccumulatorOf<T>::type Acc;
+        const unsigned int cols = b.cols();
+        const MatrixView<const T> rhs = b.view();
+        std::vector<Acc> x((size_t) _n * cols);
+        for (unsigned int step = 0; step < _n; ++step)
+        {
+            // a row needs the rows of the triangle's other cols, solved before it:
+            const unsigned int i = Shape == Triangle::Lower ? step : _n - 1 - step;
+            Acc *xI = x.data() + (size_t) i * cols;
+            for (unsigned int j = 0; j < cols; ++j)
+            {
+                xI[j] = static_cast<Acc>(rhs.data()[(size_t) i * rhs.stride() + j]);
+            }
+            for (unsigned int k = firstCol(i); k <= lastCol(i); ++k)
+            {
+                if (k == i)
+                {
+                    continue;
+                }
+                const Acc cell = static_cast<Acc>(_cells[packedIndex(i, k)]);
+                const Acc *xK = x.data() + (size_t) k * cols;
+                for (unsigned int j = 0; j < cols; ++j)
+                {
+                    xI[j] -= cell * xK[j];
+                }
+            }
+            const Acc diagonal = static_cast<Acc>(_cells[packedIndex(i, i)]);
+            if (diagonal == Acc(0))
+            {
+                throw SingularMatrix{};
+            }
+            for (unsigned int j = 0; j < cols; ++j)
+            {
+                xI[j] = xI[j] / diagonal;
+            }
+        }
+        return narrowedMatrix<T>(_n, cols, x);
+    }
+
+    /**
+     * @return a new dense matrix with this matrix's cells
+     */
+    Matrix<T> toDense() const
+    {
+        ALLOC_SCOPE("TriangularMatrix::toDense");
+        Matrix<T> dense(_n, _n);
+        T *cells = dense.view().data();
+        for (unsigned int r = 0; r < _n; ++r)
+        {
+            for (unsigned int c = firstCol(r); c <= lastCol(r); ++c)
+            {
+                cells[(size_t) r * _n + c] = _cells[packedIndex(r, c)];
+            }
+        }
+        return dense;
+    }
+};
+
+/**
+ * names a lower triangular matrix
+ */
+template <typename T>
+using LowerTriangular = TriangularMatrix<T, Triangle::Lower>;
+
+/**
+ * names an upper triangular matrix
+ */
+template <typename T>
+using UpperTriangular = TriangularMatrix<T, Triangle::Upper>;
+
+
+//*********************************************BandedMatrix****************************************
+
+/**
+ * represents a rows X cols banded matrix: cell[r,c] is (T)0, and isn't stored, unless
+ * r - lower <= c <= r + upper. the band is stored row by row, lower + upper + 1 cells a row
+ * (cell[r,c] at r * (lower + upper + 1) + c - r + lower; the slots out of the matrix are unused).
+ * @tparam T: must implement the operators: +, -, -=, +=, *, ==, =, <<.
+ *            and copy-constructor, and zero-constructor.
+ */
+template <typename T>
+class BandedMatrix
+{
+private:
+    //fields:
+    /**
+     * holds the band's cells, row by row
+     */
+    std::vector<T, TrackedAllocator<T>> _cells;
+    /**
+     * represents the matrix rows num
+     */
+    unsigned int _rows;
+    /**
+     * represents the matrix cols num
+     */
+    unsigned int _cols;
+    /**
+     * represents the num of diagonals below the main diagonal in the band
+     */
+    unsigned int _lower;
+    /**
+     * represents the num of diagonals above the main diagonal in the band
+     */
+    unsigned int _upper;
+
+    //Helpers:
+    /**
+     * @return the num of cells stored for a row
+     */
+    inline unsigned int width() const {return _lower + _upper + 1;}
+
+    /**
+     * @param r row num
+     * @return the first col of row r in the band
+     */
+    inline unsigned int firstCol(const unsigned int r) const {return r > _lower ? r - _lower : 0;}
+
+    /**
+     * @param r row num
+     * @return the last col of row r in the band
+     */
+    inline unsigned int lastCol(const unsigned int r) const
+    {
+        return (unsigned int) std::min((size_t) _cols - 1, (size_t) r + _upper);
+    }
+
+    /**
+     * @param c col num
+     * @return the first row of col c in the band
+     */
+    inline unsigned int firstRow(const unsigned int c) const {return c > _upper ? c - _upper : 0;}
+
+    /**
+     * @param c col num
+     * @return the last row of col c in the band
+     */
+    inline unsigned int lastRow(const unsigned int c) const
+    {
+        return (unsigned int) std::min((size_t) _rows - 1, (size_t) c + _lower);
+    }
+
+    /**
+     * @param r row num
+     * @param c col num (in the band)
+     * @return the index of cell[r,c]
+     */
+    inline size_t bandIndex(const unsigned int r, const unsigned int c) const
+    {
+        return (size_t) r * width() + c + _lower - r;
+    }
+
+    /**
+     * @param r row num
+     * @param c col num
+     * @return true if cell[r,c] is in the band (throws MatrixOutOfBounds if it isn't a cell)
+     */
+    bool stored(const unsigned int r, const unsigned int c) const
+    {
+        if (r >= _rows || c >= _cols)
+        {
+            throw MatrixOutOfBounds{};
+        }
+        return (size_t) c + _lower >= r && (size_t) c <= (size_t) r + _upper;
+    }
+
+public:
+    //Constructors:
+    /**
+     * constructs a new matrix of dimension rows X cols of (T)0 (a bandwidth larger than the
+     * matrix is cut to the matrix)
+     * @param rows matrix num of rows
+     * @param cols matrix num of cols
+     * @param lower num of diagonals below the main diagonal in the band
+     * @param upper num of diagonals above the main diagonal in the band
+     */
+    BandedMatrix(const unsigned int rows, const unsigned int cols, const unsigned int lower,
+                 const unsigned int upper)
+    :_cells(), _rows(rows), _cols(cols), _lower(rows > 0 ? std::min(lower, rows - 1) : 0),
+     _upper(cols > 0 ? std::min(upper, cols - 1) : 0){
+        if ((rows > 0 && cols == 0) || (cols > 0 && rows == 0))
+        {
+            throw InitDimension{};
+        }
+        _cells.assign((size_t) _rows * width(), T(0));
+    }
+
+    /**
+     * constructs a new matrix of a matrix's band (the other cells aren't read)
+     * @param dense matrix
+     * @param lower num of diagonals below the main diagonal in the band
+     * @param upper num of diagonals above the main diagonal in the band
+     */
+    BandedMatrix(Matrix<T> const& dense, const unsigned int lower, const unsigned int upper)
+    :BandedMatrix(dense.rows(), dense.cols(), lower, upper){
+        for (unsigned int r = 0; r < _rows; ++r)
+        {
+            for (unsigned int c = firstCol(r); c <= lastCol(r); ++c)
+            {
+                _cells[bandIndex(r, c)] = dense(r, c);
+            }
+        }
+    }
+
+    //Operators:
+    /**
+     * @param r row num
+     * @param c col num
+     * @return the value of the matrix's cell[r,c]
+     */
+    T operator()(const unsigned int r, const unsigned int c) const
+    {
+        return stored(r, c) ? _cells[bandIndex(r, c)] : T(0);
+    }
+
+    /**
+     * @param other matrix
+     * @return new matrix that represents the sum of adding this matrix and the other matrix
+     * (banded by the wider of both bands)
+     */
+    BandedMatrix operator+(BandedMatrix const& other) const
+    {
+        ALLOC_SCOPE("BandedMatrix::operator+");
+        if (_rows != other._rows || _cols != other._cols)
+        {
+            throw addSubDimensions{};
+        }
+        BandedMatrix sum(_rows, _cols, std::max(_lower, other._lower),
+                         std::max(_upper, other._upper));
+        sum.accumulate(*this);
+        sum.accumulate(other);
+        return sum;
+    }
+
+    /**
+     * @param other matrix
+     * @return new matrix that represents the product of multiplying this matrix and the other
+     * matrix (row i sums the other's rows of the band's row i only)
+     */
+    Matrix<T> operator*(Matrix<T> const& other) const
+    {
+        ALLOC_SCOPE("BandedMatrix::operator*");
+        if (_cols != other.rows())
+        {
+            throw MulDimensions{};
+        }
+        typedef typename AccumulatorOf<T>::type Acc;
+        const unsigned int cols = other.cols();
+        const MatrixView<const T> b = other.view();
+        std::vector<Acc> sums((size_t) _rows * cols, Acc(0));
+        for (unsigned int i = 0; i < _rows; ++i)
+        {
+            Acc *sumsI = sums.data() + (size_t) i * cols;
+            for (unsigned int k = firstCol(i); k <= lastCol(i); ++k)
+            {
+                const Acc cell = static_cast<Acc>(_cells[bandIndex(i, k)]);
+                const T *rowK = b.data() + (size_t) k * b.stride();
+                for (unsigned int j = 0; j < cols; ++j)
+                {
+                    sumsI[j] += cell * static_cast<Acc>(rowK[j]);
+                }
+            }
+        }
+        return narrowedMatrix<T>(_rows, cols, sums);
+    }
+
+    /**
+     * @param other matrix
+     * @return new matrix that represents the product of multiplying this matrix and the other
+     * matrix (banded as well, by the sums of both bandwidths: cell[i,j] sums the terms k in both
+     * bands only)
+     */
+    BandedMatrix operator*(BandedMatrix const& other) const
+    {
+        ALLOC_SCOPE("BandedMatrix::operator*");
+        if (_cols != other._rows)
+        {
+            throw MulDimensions{};
+        }
+        typedef typename AccumulatorOf<T>::type Acc;
+        BandedMatrix product(_rows, other._cols, _lower + other._lower, _upper + other._upper);
+        for (unsigned int i = 0; i < product._rows; ++i)
+        {
+            for (unsigned int j = product.firstCol(i); j <= product.lastCol(i); ++j)
+            {
+                const unsigned int first = std::max(firstCol(i), other.firstRow(j));
+                const unsigned int last = std::min(lastCol(i), other.lastRow(j));
+                Acc sum(0);
+                for (unsigned int k = first; k <= last; ++k)
+                {
+                    sum += static_cast<Acc>(_cells[bandIndex(i, k)]) *
+                           static_cast<Acc>(other._cells[other.bandIndex(k, j)]);
+                }
+                product._cells[product.bandIndex(i, j)] = narrowCell<T>(sum);
+            }
+        }
+        return product;
+    }
+
+    /**
+     * @param other matrix
+     * @return true it the other matrix and this are equal (cell by cell, whatever their bands
+     * are), false otherwise
+     */
+    bool operator==(BandedMatrix const& other) const
+    {
+        if (_rows != other._rows || _cols != other._cols)
+        {
+            return false;
+        }
+        for (unsigned int r = 0; r < _rows; ++r)
+        {
+            for (unsigned int c = std::min(firstCol(r), other.firstCol(r));
+                 c <= std::max(lastCol(r), other.lastCol(r)); ++c)
+            {
+                if ((*this)(r, c) != other(r, c))
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @param other matrix
+     * @return false it the other matrix and this are equal, true otherwise
+     */
+    bool operator!=(BandedMatrix const& other) const {return !(*this == other);}
+
+    //General functionality:
+    /**
+     * @return the num of cols of this matrix
+     */
+    inline unsigned int cols() const {return _cols;}
+
+    /**
+     * @return the num of rows of this matrix
+     */
+    inline unsigned int rows() const {return _rows;}
+
+    /**
+     * @return the num of diagonals below the main diagonal in the band
+     */
+    inline unsigned int lower() const {return _lower;}
+
+    /**
+     * @return the num of diagonals above the main diagonal in the band
+     */
+    inline unsigned int upper() const {return _upper;}
+
+    /**
+     * @param r row num
+     * @param c col num
+     * @return the stored cell[r,c] (throws MatrixOutOfBounds out of the band)
+     */
+    T& cell(const unsigned int r, const unsigned int c)
+    {
+        if (!stored(r, c))
+        {
+            throw MatrixOutOfBounds{};
+        }
+        return _cells[bandIndex(r, c)];
+    }
+
+    /**
+     * adds a matrix of the same dimensions, whose band is within this band, to this matrix
+     * @param other matrix
+     * @return this matrix after adding the other matrix
+     */
+    BandedMatrix& accumulate(BandedMatrix const& other)
+    {
+        if (_rows != other._rows || _cols != other._cols || other._lower > _lower ||
+            other._upper > _upper)
+        {
+            throw addSubDimensions{};
+        }
+        for (unsigned int r = 0; r < _rows; ++r)
+        {
+            for (unsigned int c = other.firstCol(r); c <= other.lastCol(r); ++c)
+            {
+                _cells[bandIndex(r, c)] += other._cells[other.bandIndex(r, c)];
+            }
+        }
+        return *this;
+    }
+
+    /**
+     * @return a new matrix representing the transpose form of this matrix (cols X rows, the
+     * bandwidths swapped, its cells transposed as Matrix<T>::trans does)
+     */
+    BandedMatrix trans() const
+    {
+        ALLOC_SCOPE("BandedMatrix::trans");
+        BandedMatrix transposed(_cols, _rows, _upper, _lower);
+        for (unsigned int r = 0; r < _rows; ++r)
+        {
+            for (unsigned int c = firstCol(r); c <= lastCol(r); ++c)
+            {
+                transposed._cells[transposed.bandIndex(c, r)] = transposedCell(_cells[bandIndex(r, c)]);
+            }
+        }
+        return transposed;
+    }
+
+    /**
+     * @return a new dense matrix with this matrix's cells
+     */
+    Matrix<T> toDense() const
+    {
+        ALLOC_SCOPE("BandedMatrix::toDense");
+        Matrix<T> dense(_rows, _cols);
+        T *cells = dense.view().data();
+        for (unsigned int r = 0; r < _rows; ++r)
+        {
+            for (unsigned int c = firstCol(r); c <= lastCol(r); ++c)
+            {
+                cells[(size_t) r * _cols + c] = _cells[bandIndex(r, c)];
+            }
+        }
+        return dense;
+    }
+};
+
+
+#endif //EX3_STRUCTUREDMATRIX_HPP
@@ -3,6 +3,8 @@
 #include <iostream>
 #include <stack>
 #include <chrono>
+// with ALLOC_TRACKING, counts the program's other heap allocations too.
+#define ALLOC_TRACK_GLOBAL_NEW
 #include "Matrix.hpp"
 #include <eigen3/Eigen/Dense>
 
@@ -55,6 +57,10 @@ int main(int argc, char *argv[])
                     elapsed_seconds = std::chrono::system_clock::now() - tictoc_stack.top();
                     std::cout << "matlib add " << elapsed_seconds.count() << std::endl; // tock
                     tictoc_stack.pop();
+                    if (AllocTracker::enabled())
+                    {
+                        AllocTracker::print(std::cerr);
+                    }
                     return 0;
                 }
             }